@@ -72,6 +72,21 @@ void MultiLabelFilterbyAcero(
   auto filter_vertices = maybe_filter_vertices_collection.value();
 }
 
+void LabelPredicateFilter(
+    const std::shared_ptr<graphar::GraphInfo>& graph_info) {
+  std::string type = "organisation";
+  // (university AND NOT company) OR public
+  auto university = LabelPredicate::Label("university");
+  auto not_company = LabelPredicate::Not(LabelPredicate::Label("company"));
+  auto predicate =
+      LabelPredicate::Or(LabelPredicate::And(university, not_company),
+                         LabelPredicate::Label("public"));
+  auto maybe_filter_vertices_collection =
+      VerticesCollection::verticesWithMultipleLabels(predicate, graph_info,
+                                                     type);
+  auto filter_vertices = maybe_filter_vertices_collection.value();
+}
+
 std::shared_ptr<graphar::VerticesCollection> LabelFilterFromSet(
     const std::shared_ptr<graphar::GraphInfo>& graph_info,
     const std::shared_ptr<VerticesCollection>& vertices_collection) {
@@ -114,6 +129,13 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, MultiLabelFilterbyAcero)
   }
 }
 
+BENCHMARK_DEFINE_F(BenchmarkFixture, LabelPredicateFilter)
+(::benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    LabelPredicateFilter(second_graph_info_);
+  }
+}
+
 BENCHMARK_DEFINE_F(BenchmarkFixture, LabelFilterFromSet)
 (::benchmark::State& state) {  // NOLINT
   for (auto _ : state) {
@@ -131,6 +153,7 @@ BENCHMARK_REGISTER_F(BenchmarkFixture, SingleLabelFilterbyAcero)
     ->Iterations(10);
 BENCHMARK_REGISTER_F(BenchmarkFixture, MultiLabelFilter)->Iterations(10);
 BENCHMARK_REGISTER_F(BenchmarkFixture, MultiLabelFilterbyAcero)->Iterations(10);
+BENCHMARK_REGISTER_F(BenchmarkFixture, LabelPredicateFilter)->Iterations(10);
 BENCHMARK_REGISTER_F(BenchmarkFixture, LabelFilterFromSet)->Iterations(10);
 
 }  // namespace graphar
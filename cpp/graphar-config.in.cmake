@@ -22,10 +22,13 @@
 #  GRAPHAR_INCLUDE_DIR         - include directory for graphar
 #  GRAPHAR_INCLUDE_DIRS        - include directories for graphar
 #  GRAPHAR_LIBRARIES           - libraries to link against
+#  GRAPHAR_ANALYTICS_LIBRARIES - libraries to link against for the graph
+#                                algorithms of graphar_analytics
 
 set(GRAPHAR_HOME "${CMAKE_CURRENT_LIST_DIR}/../../..")
 include("${CMAKE_CURRENT_LIST_DIR}/graphar-targets.cmake")
 
 set(GRAPHAR_LIBRARIES graphar)
+set(GRAPHAR_ANALYTICS_LIBRARIES graphar_analytics graphar)
 set(GRAPHAR_INCLUDE_DIR "${GRAPHAR_HOME}/include")
 set(GRAPHAR_INCLUDE_DIRS "${GRAPHAR_INCLUDE_DIR}")
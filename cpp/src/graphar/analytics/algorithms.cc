@@ -0,0 +1,702 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/compute/api.h"
+
+#include "graphar/analytics/algorithms.h"
+#include "graphar/analytics/parallel.h"
+#include "graphar/arrow/chunk_writer.h"
+#include "graphar/graph_info.h"
+#include "graphar/reader_util.h"
+#include "graphar/status.h"
+#include "graphar/types.h"
+
+namespace graphar::analytics {
+
+namespace {
+
+// the thresholds of switching between pushing and pulling in a
+// breadth-first search, by Beamer et al.
+constexpr IdType kBfsAlpha = 15;
+constexpr IdType kBfsBeta = 18;
+// the number of buckets of tentative distances kept at once in a
+// delta-stepping, the farther vertices wait in one more bucket
+constexpr size_t kSsspBinNum = 1024;
+
+Status CheckAdjListType(const CSRGraph& graph, AdjListType expected,
+                        const char* name) {
+  if (graph.GetAdjListType() != expected) {
+    return Status::Invalid("The ", name, " edges are ",
+                           AdjListTypeToString(graph.GetAdjListType()),
+                           ", expected ", AdjListTypeToString(expected), ".");
+  }
+  return Status::OK();
+}
+
+// check the neighbors are vertices of the graph, that is, the source and the
+// destination of the edges are of the same vertex type
+Status CheckNeighbors(const CSRGraph& graph, Workers* workers) {
+  const IdType vertex_num = graph.GetVertexNum();
+  const IdType* neighbors = graph.neighbors();
+  std::atomic<bool> valid(true);
+  GAR_RETURN_NOT_OK(workers->ParallelFor(
+      graph.GetEdgeNum(),
+      [&](IdType begin, IdType end, int) {
+        for (IdType i = begin; i < end; ++i) {
+          if (neighbors[i] < 0 || neighbors[i] >= vertex_num) {
+            valid.store(false, std::memory_order_relaxed);
+            return;
+          }
+        }
+      },
+      Workers::kDefaultBlockSize * 64));
+  if (!valid.load()) {
+    return Status::Invalid("The edges have neighbors out of the ", vertex_num,
+                           " vertices, the source and the destination of the "
+                           "edges have to be of the same vertex type.");
+  }
+  return Status::OK();
+}
+
+Status CheckInEdges(const CSRGraph& out_edges, const CSRGraph& in_edges,
+                    Workers* workers) {
+  GAR_RETURN_NOT_OK(
+      CheckAdjListType(in_edges, AdjListType::ordered_by_dest, "incoming"));
+  if (in_edges.GetVertexNum() != out_edges.GetVertexNum() ||
+      in_edges.GetEdgeNum() != out_edges.GetEdgeNum()) {
+    return Status::Invalid("The incoming edges of ", in_edges.GetVertexNum(),
+                           " vertices and ", in_edges.GetEdgeNum(),
+                           " edges do not match the outgoing edges of ",
+                           out_edges.GetVertexNum(), " vertices and ",
+                           out_edges.GetEdgeNum(), " edges.");
+  }
+  return CheckNeighbors(in_edges, workers);
+}
+
+Status CheckSource(const CSRGraph& graph, IdType source) {
+  if (source < 0 || source >= graph.GetVertexNum()) {
+    return Status::IndexError("The source ", source, " is out of the ",
+                              graph.GetVertexNum(), " vertices.");
+  }
+  return Status::OK();
+}
+
+// get the weights of the edges as doubles, nullptr for the unit weights
+Result<std::shared_ptr<arrow::DoubleArray>> GetWeights(
+    const CSRGraph& graph, const std::string& weight_property) {
+  if (weight_property.empty()) {
+    return std::shared_ptr<arrow::DoubleArray>();
+  }
+  GAR_ASSIGN_OR_RAISE(auto array, graph.GetProperty(weight_property));
+  if (array->null_count() != 0) {
+    return Status::Invalid("The weight property ", weight_property,
+                           " has null values.");
+  }
+  std::shared_ptr<arrow::Array> weights = array;
+  if (array->type_id() != arrow::Type::DOUBLE) {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        weights, arrow::compute::Cast(*array, arrow::float64(),
+                                      arrow::compute::CastOptions::Safe()));
+  }
+  auto result = std::static_pointer_cast<arrow::DoubleArray>(weights);
+  const double* values = result->raw_values();
+  for (int64_t i = 0; i < result->length(); ++i) {
+    // also rejects NaN
+    if (!(values[i] >= 0)) {
+      return Status::Invalid("The weight property ", weight_property,
+                             " has a negative value ", values[i], ".");
+    }
+  }
+  return result;
+}
+
+// lower the value to x, returns whether it is lowered
+bool AtomicMin(std::atomic<double>& value, double x) {
+  double current = value.load(std::memory_order_relaxed);
+  while (x < current) {
+    if (value.compare_exchange_weak(current, x, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AtomicAdd(std::atomic<double>& value, double x) {
+  double current = value.load(std::memory_order_relaxed);
+  while (!value.compare_exchange_weak(current, current + x,
+                                      std::memory_order_relaxed)) {
+  }
+}
+
+// concatenate the vertices collected by the workers
+void Gather(std::vector<std::vector<IdType>>* locals,
+            std::vector<IdType>* out) {
+  out->clear();
+  for (auto& local : *locals) {
+    out->insert(out->end(), local.begin(), local.end());
+    local.clear();
+  }
+}
+
+class BreadthFirstSearcher {
+ public:
+  BreadthFirstSearcher(const CSRGraph& out_edges, const CSRGraph* in_edges,
+                       Workers* workers)
+      : out_edges_(out_edges),
+        in_edges_(in_edges),
+        workers_(workers),
+        vertex_num_(out_edges.GetVertexNum()),
+        distances_(vertex_num_, -1),
+        visited_(vertex_num_),
+        locals_(workers->size()),
+        scouts_(workers->size()) {}
+
+  Result<std::vector<IdType>> Run(IdType source) {
+    std::vector<IdType> queue{source};
+    visited_.Set(source);
+    distances_[source] = 0;
+    IdType level = 0;
+    IdType scout_count = out_edges_.GetDegree(source);
+    IdType edges_to_check = out_edges_.GetEdgeNum();
+    while (!queue.empty()) {
+      if (in_edges_ != nullptr && scout_count > edges_to_check / kBfsAlpha) {
+        // the frontier has many edges, pull until it becomes small again
+        AtomicBitmap frontier(vertex_num_), next(vertex_num_);
+        GAR_RETURN_NOT_OK(QueueToBitmap(queue, &frontier));
+        IdType awake_count = static_cast<IdType>(queue.size());
+        IdType old_awake_count = 0;
+        do {
+          old_awake_count = awake_count;
+          next.Clear();
+          GAR_ASSIGN_OR_RAISE(awake_count, PullStep(frontier, &next, level));
+          frontier.Swap(next);
+          ++level;
+        } while (awake_count >= old_awake_count ||
+                 awake_count > vertex_num_ / kBfsBeta);
+        GAR_RETURN_NOT_OK(BitmapToQueue(frontier, &queue));
+        scout_count = 1;
+      } else {
+        edges_to_check -= scout_count;
+        GAR_ASSIGN_OR_RAISE(scout_count, PushStep(&queue, level));
+        ++level;
+      }
+    }
+    return std::move(distances_);
+  }
+
+ private:
+  // visit the outgoing edges of the queue, returns the number of the
+  // outgoing edges of the next queue
+  Result<IdType> PushStep(std::vector<IdType>* queue, IdType level) {
+    const IdType* offsets = out_edges_.offsets();
+    const IdType* neighbors = out_edges_.neighbors();
+    std::fill(scouts_.begin(), scouts_.end(), 0);
+    GAR_RETURN_NOT_OK(workers_->ParallelFor(
+        static_cast<IdType>(queue->size()),
+        [&](IdType begin, IdType end, int worker) {
+          auto& local = locals_[worker];
+          IdType scout_count = 0;
+          for (IdType i = begin; i < end; ++i) {
+            IdType u = (*queue)[i];
+            for (IdType j = offsets[u]; j < offsets[u + 1]; ++j) {
+              IdType v = neighbors[j];
+              if (!visited_.Get(v) && visited_.Set(v)) {
+                distances_[v] = level + 1;
+                local.push_back(v);
+                scout_count += offsets[v + 1] - offsets[v];
+              }
+            }
+          }
+          scouts_[worker] += scout_count;
+        },
+        64));
+    Gather(&locals_, queue);
+    IdType scout_count = 0;
+    for (auto count : scouts_) {
+      scout_count += count;
+    }
+    return scout_count;
+  }
+
+  // visit the incoming edges of the unvisited vertices, returns the number
+  // of the vertices of the next frontier
+  Result<IdType> PullStep(const AtomicBitmap& frontier, AtomicBitmap* next,
+                          IdType level) {
+    const IdType* offsets = in_edges_->offsets();
+    const IdType* neighbors = in_edges_->neighbors();
+    std::fill(scouts_.begin(), scouts_.end(), 0);
+    GAR_RETURN_NOT_OK(workers_->ParallelFor(
+        vertex_num_, [&](IdType begin, IdType end, int worker) {
+          IdType awake_count = 0;
+          for (IdType v = begin; v < end; ++v) {
+            if (visited_.Get(v)) {
+              continue;
+            }
+            for (IdType j = offsets[v]; j < offsets[v + 1]; ++j) {
+              if (frontier.Get(neighbors[j])) {
+                visited_.Set(v);
+                next->Set(v);
+                distances_[v] = level + 1;
+                ++awake_count;
+                break;
+              }
+            }
+          }
+          scouts_[worker] += awake_count;
+        }));
+    IdType awake_count = 0;
+    for (auto count : scouts_) {
+      awake_count += count;
+    }
+    return awake_count;
+  }
+
+  Status QueueToBitmap(const std::vector<IdType>& queue,
+                       AtomicBitmap* bitmap) {
+    return workers_->ParallelFor(
+        static_cast<IdType>(queue.size()), [&](IdType begin, IdType end, int) {
+          for (IdType i = begin; i < end; ++i) {
+            bitmap->Set(queue[i]);
+          }
+        });
+  }
+
+  Status BitmapToQueue(const AtomicBitmap& bitmap,
+                       std::vector<IdType>* queue) {
+    GAR_RETURN_NOT_OK(workers_->ParallelFor(
+        vertex_num_, [&](IdType begin, IdType end, int worker) {
+          auto& local = locals_[worker];
+          for (IdType v = begin; v < end; ++v) {
+            if (bitmap.Get(v)) {
+              local.push_back(v);
+            }
+          }
+        }));
+    Gather(&locals_, queue);
+    return Status::OK();
+  }
+
+  const CSRGraph& out_edges_;
+  const CSRGraph* in_edges_;
+  Workers* workers_;
+  IdType vertex_num_;
+  std::vector<IdType> distances_;
+  AtomicBitmap visited_;
+  std::vector<std::vector<IdType>> locals_;
+  std::vector<IdType> scouts_;
+};
+
+IdType FindRoot(std::vector<std::atomic<IdType>>& parents, IdType v) {
+  IdType parent = parents[v].load(std::memory_order_acquire);
+  while (parent != v) {
+    // path halving, an ancestor stays an ancestor since only roots are hooked
+    IdType grandparent = parents[parent].load(std::memory_order_acquire);
+    if (grandparent != parent) {
+      parents[v].store(grandparent, std::memory_order_release);
+    }
+    v = parent;
+    parent = grandparent;
+  }
+  return v;
+}
+
+void Union(std::vector<std::atomic<IdType>>& parents, IdType u, IdType v) {
+  while (true) {
+    u = FindRoot(parents, u);
+    v = FindRoot(parents, v);
+    if (u == v) {
+      return;
+    }
+    if (u < v) {
+      std::swap(u, v);
+    }
+    // hook the larger root onto the smaller one, retry if u is no more a root
+    IdType expected = u;
+    if (parents[u].compare_exchange_strong(expected, v,
+                                           std::memory_order_acq_rel)) {
+      return;
+    }
+  }
+}
+
+template <typename BuilderType, typename T>
+Result<std::shared_ptr<VertexInfo>> WriteColumn(
+    const std::shared_ptr<VertexInfo>& vertex_info, const std::string& prefix,
+    const std::string& property_name, const std::vector<T>& values,
+    const std::shared_ptr<DataType>& type, FileType file_type) {
+  GAR_ASSIGN_OR_RAISE(auto vertex_num, util::GetVertexNum(prefix, vertex_info));
+  if (static_cast<IdType>(values.size()) != vertex_num) {
+    return Status::Invalid("The ", values.size(), " values of ", property_name,
+                           " do not match the ", vertex_num, " vertices of ",
+                           vertex_info->GetType(), ".");
+  }
+  auto property_group = CreatePropertyGroup(
+      {Property(property_name, type, false, false)}, file_type);
+  GAR_ASSIGN_OR_RAISE(auto new_info,
+                      vertex_info->AddPropertyGroup(property_group));
+  GAR_ASSIGN_OR_RAISE(auto writer,
+                      VertexPropertyWriter::Make(new_info, prefix));
+  BuilderType builder;
+  auto status =
+      builder.AppendValues(values.data(), static_cast<int64_t>(values.size()));
+  RETURN_NOT_ARROW_OK(status);
+  std::shared_ptr<arrow::Array> array;
+  status = builder.Finish(&array);
+  RETURN_NOT_ARROW_OK(status);
+  auto schema = arrow::schema(
+      {arrow::field(property_name, DataType::DataTypeToArrowDataType(type))});
+  auto table = arrow::Table::Make(schema, {array});
+  GAR_RETURN_NOT_OK(writer->WriteTable(table, property_group, 0));
+  return new_info;
+}
+
+}  // namespace
+
+Result<std::vector<IdType>> BreadthFirstSearch(const CSRGraph& out_edges,
+                                               const CSRGraph* in_edges,
+                                               IdType source,
+                                               int num_threads) {
+  GAR_RETURN_NOT_OK(CheckAdjListType(out_edges, AdjListType::ordered_by_source,
+                                     "outgoing"));
+  GAR_RETURN_NOT_OK(CheckSource(out_edges, source));
+  GAR_ASSIGN_OR_RAISE(auto workers, Workers::Make(num_threads));
+  GAR_RETURN_NOT_OK(CheckNeighbors(out_edges, workers.get()));
+  if (in_edges != nullptr) {
+    GAR_RETURN_NOT_OK(CheckInEdges(out_edges, *in_edges, workers.get()));
+  }
+  BreadthFirstSearcher searcher(out_edges, in_edges, workers.get());
+  return searcher.Run(source);
+}
+
+Result<std::vector<double>> SingleSourceShortestPaths(
+    const CSRGraph& out_edges, const std::string& weight_property,
+    IdType source, double delta, int num_threads) {
+  GAR_RETURN_NOT_OK(CheckAdjListType(out_edges, AdjListType::ordered_by_source,
+                                     "outgoing"));
+  GAR_RETURN_NOT_OK(CheckSource(out_edges, source));
+  if (std::isnan(delta)) {
+    return Status::Invalid("The delta is NaN.");
+  }
+  GAR_ASSIGN_OR_RAISE(auto weight_array,
+                      GetWeights(out_edges, weight_property));
+  GAR_ASSIGN_OR_RAISE(auto workers, Workers::Make(num_threads));
+  GAR_RETURN_NOT_OK(CheckNeighbors(out_edges, workers.get()));
+
+  const IdType vertex_num = out_edges.GetVertexNum();
+  const IdType edge_num = out_edges.GetEdgeNum();
+  const IdType* offsets = out_edges.offsets();
+  const IdType* neighbors = out_edges.neighbors();
+  const double* weights =
+      weight_array == nullptr ? nullptr : weight_array->raw_values();
+  const double infinity = std::numeric_limits<double>::infinity();
+  if (!(delta > 0)) {
+    // the average weight, 1 for the unit weights or if every edge weighs 0
+    delta = 1.0;
+    if (weights != nullptr && edge_num > 0) {
+      std::vector<double> partials(workers->size());
+      GAR_RETURN_NOT_OK(workers->ParallelFor(
+          edge_num,
+          [&](IdType begin, IdType end, int worker) {
+            double partial = 0;
+            for (IdType j = begin; j < end; ++j) {
+              partial += weights[j];
+            }
+            partials[worker] += partial;
+          },
+          Workers::kDefaultBlockSize * 64));
+      double sum = 0;
+      for (auto partial : partials) {
+        sum += partial;
+      }
+      double average = sum / static_cast<double>(edge_num);
+      if (average > 0 && std::isfinite(average)) {
+        delta = average;
+      }
+    }
+  }
+  std::vector<std::atomic<double>> distances(vertex_num);
+  GAR_RETURN_NOT_OK(workers->ParallelFor(
+      vertex_num, [&](IdType begin, IdType end, int) {
+        for (IdType v = begin; v < end; ++v) {
+          distances[v].store(infinity, std::memory_order_relaxed);
+        }
+      }));
+  distances[source].store(0);
+
+  // the buckets of each worker, the i-th one holds the vertices of the
+  // tentative distances in [window_begin + i * delta,
+  // window_begin + (i + 1) * delta) and the last one the farther vertices,
+  // which are rebucketed from the closest of them once the others are empty
+  std::vector<std::vector<std::vector<IdType>>> bins(
+      workers->size(), std::vector<std::vector<IdType>>(kSsspBinNum + 1));
+  double window_begin = 0;
+  // the offset of the bucket of a distance, which does not decrease with the
+  // distance, so that relaxing an edge never lowers a vertex to an earlier
+  // bucket than the current one
+  auto bin_offset = [&](double distance) {
+    return std::floor((distance - window_begin) / delta);
+  };
+  auto bin_of = [&](double distance) {
+    double offset = bin_offset(distance);
+    return offset < static_cast<double>(kSsspBinNum)
+               ? static_cast<size_t>(offset)
+               : kSsspBinNum;
+  };
+  std::vector<IdType> frontier{source};
+  std::vector<IdType> far;
+  size_t bin = 0;
+  while (true) {
+    GAR_RETURN_NOT_OK(workers->ParallelFor(
+        static_cast<IdType>(frontier.size()),
+        [&](IdType begin, IdType end, int worker) {
+          auto& local_bins = bins[worker];
+          for (IdType i = begin; i < end; ++i) {
+            IdType u = frontier[i];
+            double distance = distances[u].load(std::memory_order_relaxed);
+            // skip the stale entries of vertices settled in an earlier bin
+            if (bin_offset(distance) < static_cast<double>(bin)) {
+              continue;
+            }
+            for (IdType j = offsets[u]; j < offsets[u + 1]; ++j) {
+              IdType v = neighbors[j];
+              double new_distance =
+                  distance + (weights == nullptr ? 1.0 : weights[j]);
+              if (AtomicMin(distances[v], new_distance)) {
+                local_bins[bin_of(new_distance)].push_back(v);
+              }
+            }
+          }
+        },
+        64));
+    // the next bin is the first non-empty one, which may be the current one
+    size_t next_bin = kSsspBinNum;
+    for (const auto& local_bins : bins) {
+      for (size_t i = bin; i < next_bin; ++i) {
+        if (!local_bins[i].empty()) {
+          next_bin = i;
+          break;
+        }
+      }
+    }
+    if (next_bin == kSsspBinNum) {
+      // move the window to the closest of the farther vertices, skipping the
+      // ones lowered into the window since
+      far.clear();
+      for (auto& local_bins : bins) {
+        for (IdType v : local_bins[kSsspBinNum]) {
+          if (bin_of(distances[v].load(std::memory_order_relaxed)) ==
+              kSsspBinNum) {
+            far.push_back(v);
+          }
+        }
+        local_bins[kSsspBinNum].clear();
+      }
+      if (far.empty()) {
+        break;
+      }
+      double closest = infinity;
+      for (IdType v : far) {
+        closest = std::min(closest, distances[v].load());
+      }
+      window_begin = closest;
+      for (IdType v : far) {
+        bins[0][bin_of(distances[v].load())].push_back(v);
+      }
+      next_bin = 0;
+    }
+    bin = next_bin;
+    frontier.clear();
+    for (auto& local_bins : bins) {
+      frontier.insert(frontier.end(), local_bins[bin].begin(),
+                      local_bins[bin].end());
+      local_bins[bin].clear();
+    }
+  }
+
+  std::vector<double> result(vertex_num);
+  for (IdType v = 0; v < vertex_num; ++v) {
+    result[v] = distances[v].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+Result<std::vector<double>> PageRank(const CSRGraph& out_edges,
+                                     const CSRGraph* in_edges, double damping,
+                                     int max_iterations, double tolerance,
+                                     int num_threads) {
+  GAR_RETURN_NOT_OK(CheckAdjListType(out_edges, AdjListType::ordered_by_source,
+                                     "outgoing"));
+  if (!(damping >= 0 && damping <= 1)) {
+    return Status::Invalid("The damping factor ", damping,
+                           " is out of [0, 1].");
+  }
+  if (max_iterations < 0) {
+    return Status::Invalid("The maximum number of iterations ", max_iterations,
+                           " is negative.");
+  }
+  GAR_ASSIGN_OR_RAISE(auto workers, Workers::Make(num_threads));
+  GAR_RETURN_NOT_OK(CheckNeighbors(out_edges, workers.get()));
+  if (in_edges != nullptr) {
+    GAR_RETURN_NOT_OK(CheckInEdges(out_edges, *in_edges, workers.get()));
+  }
+
+  const IdType vertex_num = out_edges.GetVertexNum();
+  if (vertex_num == 0) {
+    return std::vector<double>();
+  }
+  const double base = (1 - damping) / static_cast<double>(vertex_num);
+  const IdType* out_offsets = out_edges.offsets();
+  const IdType* out_neighbors = out_edges.neighbors();
+  std::vector<double> ranks(vertex_num, 1.0 / static_cast<double>(vertex_num));
+  // the rank each vertex sends along each of its outgoing edges
+  std::vector<double> contributions(vertex_num);
+  std::vector<std::atomic<double>> sums(in_edges == nullptr ? vertex_num : 0);
+  std::vector<double> partials(workers->size());
+
+  for (int iteration = 0; iteration < max_iterations; ++iteration) {
+    std::fill(partials.begin(), partials.end(), 0);
+    GAR_RETURN_NOT_OK(workers->ParallelFor(
+        vertex_num, [&](IdType begin, IdType end, int worker) {
+          double dangling = 0;
+          for (IdType v = begin; v < end; ++v) {
+            IdType degree = out_offsets[v + 1] - out_offsets[v];
+            if (degree == 0) {
+              dangling += ranks[v];
+              contributions[v] = 0;
+            } else {
+              contributions[v] = ranks[v] / static_cast<double>(degree);
+            }
+            if (in_edges == nullptr) {
+              sums[v].store(0, std::memory_order_relaxed);
+            }
+          }
+          partials[worker] += dangling;
+        }));
+    double dangling = 0;
+    for (auto partial : partials) {
+      dangling += partial;
+    }
+    const double teleport =
+        base + damping * dangling / static_cast<double>(vertex_num);
+
+    if (in_edges == nullptr) {
+      GAR_RETURN_NOT_OK(workers->ParallelFor(
+          vertex_num,
+          [&](IdType begin, IdType end, int) {
+            for (IdType u = begin; u < end; ++u) {
+              for (IdType j = out_offsets[u]; j < out_offsets[u + 1]; ++j) {
+                AtomicAdd(sums[out_neighbors[j]], contributions[u]);
+              }
+            }
+          },
+          64));
+    }
+
+    std::fill(partials.begin(), partials.end(), 0);
+    GAR_RETURN_NOT_OK(workers->ParallelFor(
+        vertex_num, [&](IdType begin, IdType end, int worker) {
+          double change = 0;
+          for (IdType v = begin; v < end; ++v) {
+            double sum = 0;
+            if (in_edges == nullptr) {
+              sum = sums[v].load(std::memory_order_relaxed);
+            } else {
+              const IdType* in_offsets = in_edges->offsets();
+              const IdType* in_neighbors = in_edges->neighbors();
+              for (IdType j = in_offsets[v]; j < in_offsets[v + 1]; ++j) {
+                sum += contributions[in_neighbors[j]];
+              }
+            }
+            double rank = teleport + damping * sum;
+            change += std::abs(rank - ranks[v]);
+            ranks[v] = rank;
+          }
+          partials[worker] += change;
+        }));
+    double change = 0;
+    for (auto partial : partials) {
+      change += partial;
+    }
+    if (change < tolerance) {
+      break;
+    }
+  }
+  return ranks;
+}
+
+Result<std::vector<IdType>> WeaklyConnectedComponents(const CSRGraph& edges,
+                                                      int num_threads) {
+  GAR_ASSIGN_OR_RAISE(auto workers, Workers::Make(num_threads));
+  GAR_RETURN_NOT_OK(CheckNeighbors(edges, workers.get()));
+
+  const IdType vertex_num = edges.GetVertexNum();
+  const IdType* offsets = edges.offsets();
+  const IdType* neighbors = edges.neighbors();
+  std::vector<std::atomic<IdType>> parents(vertex_num);
+  GAR_RETURN_NOT_OK(workers->ParallelFor(
+      vertex_num, [&](IdType begin, IdType end, int) {
+        for (IdType v = begin; v < end; ++v) {
+          parents[v].store(v, std::memory_order_relaxed);
+        }
+      }));
+  GAR_RETURN_NOT_OK(workers->ParallelFor(
+      vertex_num,
+      [&](IdType begin, IdType end, int) {
+        for (IdType u = begin; u < end; ++u) {
+          for (IdType j = offsets[u]; j < offsets[u + 1]; ++j) {
+            Union(parents, u, neighbors[j]);
+          }
+        }
+      },
+      64));
+  // the forest is final, compress each vertex to its root, the smallest id
+  std::vector<IdType> components(vertex_num);
+  GAR_RETURN_NOT_OK(workers->ParallelFor(
+      vertex_num, [&](IdType begin, IdType end, int) {
+        for (IdType v = begin; v < end; ++v) {
+          components[v] = FindRoot(parents, v);
+        }
+      }));
+  return components;
+}
+
+Result<std::shared_ptr<VertexInfo>> WriteVertexProperty(
+    const std::shared_ptr<VertexInfo>& vertex_info, const std::string& prefix,
+    const std::string& property_name, const std::vector<IdType>& values,
+    FileType file_type) {
+  return WriteColumn<arrow::Int64Builder>(vertex_info, prefix, property_name,
+                                          values, int64(), file_type);
+}
+
+Result<std::shared_ptr<VertexInfo>> WriteVertexProperty(
+    const std::shared_ptr<VertexInfo>& vertex_info, const std::string& prefix,
+    const std::string& property_name, const std::vector<double>& values,
+    FileType file_type) {
+  return WriteColumn<arrow::DoubleBuilder>(vertex_info, prefix, property_name,
+                                           values, float64(), file_type);
+}
+
+}  // namespace graphar::analytics
@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graphar/csr_graph.h"
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+
+/**
+ * The parallel graph algorithms of the graphar_analytics library.
+ *
+ * The algorithms run over the adjacency lists of an edge type whose source
+ * and destination are of the same vertex type, loaded by CSRGraph, with
+ * outgoing edges from ordered_by_source and incoming edges from
+ * ordered_by_dest. The loops run on the workers of analytics::Workers.
+ */
+namespace graphar::analytics {
+
+/**
+ * @brief Get the number of hops from a source vertex to each vertex by a
+ * breadth-first search.
+ *
+ * The search is direction-optimizing. A level pushes along the outgoing
+ * edges of the frontier while it is small. Once the frontier has many
+ * edges, the levels pull along the incoming edges of the unvisited vertices
+ * if in_edges is given, with the frontier kept as an atomic bitmap.
+ *
+ * @param out_edges The outgoing edges.
+ * @param in_edges The incoming edges, or nullptr to only push.
+ * @param source The internal id of the source vertex.
+ * @param num_threads The number of threads, the capacity of the CPU thread
+ * pool of Arrow if it is not positive.
+ * @return The number of hops of each vertex, -1 if it is unreachable.
+ */
+Result<std::vector<IdType>> BreadthFirstSearch(const CSRGraph& out_edges,
+                                               const CSRGraph* in_edges,
+                                               IdType source,
+                                               int num_threads = 0);
+
+/**
+ * @brief Get the length of the shortest paths from a source vertex to each
+ * vertex by delta-stepping.
+ *
+ * The vertices are settled bucket by bucket of tentative distances of width
+ * delta, the edges of the vertices of a bucket are relaxed in parallel. A
+ * window of a bounded number of buckets is kept at once, the vertices
+ * beyond it wait in one bucket until the window moves to the closest of
+ * them.
+ *
+ * @param out_edges The outgoing edges.
+ * @param weight_property The edge property of the non-negative weights, the
+ * property has to be loaded by the CSRGraph. Every edge weighs 1 if it is
+ * empty.
+ * @param source The internal id of the source vertex.
+ * @param delta The width of a bucket, the average weight if it is not
+ * positive.
+ * @param num_threads The number of threads.
+ * @return The length of the shortest path of each vertex, infinity if it is
+ * unreachable.
+ */
+Result<std::vector<double>> SingleSourceShortestPaths(
+    const CSRGraph& out_edges, const std::string& weight_property,
+    IdType source, double delta = 0, int num_threads = 0);
+
+/**
+ * @brief Get the PageRank of each vertex.
+ *
+ * An iteration pulls the ranks along the incoming edges if in_edges is
+ * given, or pushes them along the outgoing edges with atomic adds. The rank
+ * of the vertices without outgoing edges is spread over all the vertices.
+ *
+ * @param out_edges The outgoing edges.
+ * @param in_edges The incoming edges, or nullptr to push.
+ * @param damping The damping factor.
+ * @param max_iterations The maximum number of iterations.
+ * @param tolerance Stop once the L1 norm of the change of the ranks of an
+ * iteration is smaller.
+ * @param num_threads The number of threads.
+ * @return The rank of each vertex, the ranks sum to 1.
+ */
+Result<std::vector<double>> PageRank(const CSRGraph& out_edges,
+                                     const CSRGraph* in_edges,
+                                     double damping = 0.85,
+                                     int max_iterations = 20,
+                                     double tolerance = 1e-6,
+                                     int num_threads = 0);
+
+/**
+ * @brief Get the weakly connected components of the vertices.
+ *
+ * The edges are unioned in parallel into a disjoint set forest, whose roots
+ * are hooked by compare-and-swap from a larger id to a smaller one.
+ *
+ * @param edges The outgoing or the incoming edges.
+ * @param num_threads The number of threads.
+ * @return The component of each vertex, the smallest id of its component.
+ */
+Result<std::vector<IdType>> WeaklyConnectedComponents(const CSRGraph& edges,
+                                                      int num_threads = 0);
+
+/**
+ * @brief Write a result of the vertices as a new property group of one
+ * property through VertexPropertyWriter.
+ *
+ * @param vertex_info The vertex info of the vertex type.
+ * @param prefix The absolute prefix of the graph.
+ * @param property_name The name of the property, which has to be new.
+ * @param values The value of each vertex, one for each of the vertices
+ * counted under the prefix.
+ * @param file_type The file type of the property group.
+ * @return The vertex info with the new property group, save it, e.g., by
+ * VertexInfo::Save, to make the property visible to the readers, or Invalid
+ * if the values do not match the vertices.
+ */
+Result<std::shared_ptr<VertexInfo>> WriteVertexProperty(
+    const std::shared_ptr<VertexInfo>& vertex_info, const std::string& prefix,
+    const std::string& property_name, const std::vector<IdType>& values,
+    FileType file_type = FileType::PARQUET);
+
+/**
+ * @brief Write a result of the vertices as a new property group of one
+ * property of type double, see the int64 one.
+ */
+Result<std::shared_ptr<VertexInfo>> WriteVertexProperty(
+    const std::shared_ptr<VertexInfo>& vertex_info, const std::string& prefix,
+    const std::string& property_name, const std::vector<double>& values,
+    FileType file_type = FileType::PARQUET);
+
+}  // namespace graphar::analytics
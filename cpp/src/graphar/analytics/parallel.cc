@@ -0,0 +1,81 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "arrow/util/future.h"
+#include "arrow/util/thread_pool.h"
+
+#include "graphar/analytics/parallel.h"
+#include "graphar/status.h"
+
+namespace graphar::analytics {
+
+Result<std::shared_ptr<Workers>> Workers::Make(int num_threads) {
+  if (num_threads <= 0) {
+    num_threads = arrow::GetCpuThreadPoolCapacity();
+  }
+  num_threads = std::max(num_threads, 1);
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto pool, arrow::internal::ThreadPool::Make(num_threads));
+  return std::shared_ptr<Workers>(new Workers(std::move(pool), num_threads));
+}
+
+Status Workers::ParallelFor(
+    IdType n,
+    const std::function<void(IdType begin, IdType end, int worker)>& fn,
+    IdType block_size) {
+  if (n <= 0) {
+    return Status::OK();
+  }
+  block_size = std::max<IdType>(block_size, 1);
+  IdType num_blocks = (n + block_size - 1) / block_size;
+  int num_workers =
+      static_cast<int>(std::min<IdType>(num_threads_, num_blocks));
+  if (num_workers == 1) {
+    // a loop of one block is not worth a round trip to the pool
+    fn(0, n, 0);
+    return Status::OK();
+  }
+  std::atomic<IdType> next_block(0);
+  std::vector<arrow::Future<>> futures;
+  Status status = Status::OK();
+  for (int worker = 0; worker < num_workers; ++worker) {
+    auto maybe_future = pool_->Submit([&, worker]() {
+      for (IdType block = next_block++; block < num_blocks;
+           block = next_block++) {
+        IdType begin = block * block_size;
+        fn(begin, std::min(begin + block_size, n), worker);
+      }
+    });
+    if (!maybe_future.ok()) {
+      status = Status::ArrowError(maybe_future.status().ToString());
+      break;
+    }
+    futures.push_back(std::move(maybe_future).ValueUnsafe());
+  }
+  // the workers refer to the locals, wait for all of them before returning
+  for (auto& future : futures) {
+    future.Wait();
+  }
+  return status;
+}
+
+}  // namespace graphar::analytics
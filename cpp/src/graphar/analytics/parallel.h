@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+
+// forward declaration
+namespace arrow::internal {
+class ThreadPool;
+}  // namespace arrow::internal
+
+namespace graphar::analytics {
+
+/**
+ * @brief The workers that run the loops of an algorithm, on a thread pool of
+ * their own.
+ *
+ * A loop is split into blocks that the workers take one at a time, so that a
+ * worker done early takes over the remaining blocks of the others.
+ */
+class Workers {
+ public:
+  /// The number of iterations of a block by default.
+  static constexpr IdType kDefaultBlockSize = 1024;
+
+  /**
+   * @brief Create the workers.
+   *
+   * @param num_threads The number of workers, the capacity of the CPU thread
+   * pool of Arrow if it is not positive.
+   */
+  static Result<std::shared_ptr<Workers>> Make(int num_threads = 0);
+
+  /** @brief Get the number of workers. */
+  int size() const { return num_threads_; }
+
+  /**
+   * @brief Run a loop over [0, n) in parallel.
+   *
+   * @param n The number of iterations.
+   * @param fn The function called for each block [begin, end) with the
+   * index of the worker in [0, size()), the blocks of a worker are run one
+   * after another.
+   * @param block_size The number of iterations of a block.
+   * @return The error of submitting the workers, the loop is done otherwise.
+   */
+  Status ParallelFor(
+      IdType n,
+      const std::function<void(IdType begin, IdType end, int worker)>& fn,
+      IdType block_size = kDefaultBlockSize);
+
+ private:
+  Workers(std::shared_ptr<arrow::internal::ThreadPool> pool, int num_threads)
+      : pool_(std::move(pool)), num_threads_(num_threads) {}
+
+  std::shared_ptr<arrow::internal::ThreadPool> pool_;
+  int num_threads_;
+};
+
+/**
+ * @brief A bitmap of vertices whose bits are set concurrently, e.g., the
+ * frontier of a traversal.
+ */
+class AtomicBitmap {
+ public:
+  /** @brief Initialize a bitmap of size bits, all of them cleared. */
+  explicit AtomicBitmap(IdType size)
+      : size_(size), words_((size + 63) / 64) {
+    Clear();
+  }
+
+  /** @brief Get the number of bits. */
+  IdType size() const { return size_; }
+
+  /** @brief Whether a bit is set. */
+  bool Get(IdType i) const {
+    return (words_[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1;
+  }
+
+  /**
+   * @brief Set a bit.
+   *
+   * @return Whether the bit is set by this call, false if it was set.
+   */
+  bool Set(IdType i) {
+    uint64_t mask = uint64_t(1) << (i & 63);
+    return !(words_[i >> 6].fetch_or(mask, std::memory_order_relaxed) & mask);
+  }
+
+  /** @brief Clear all the bits, not concurrently with the other methods. */
+  void Clear() {
+    for (auto& word : words_) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /** @brief Swap the bits with another bitmap of the same size. */
+  void Swap(AtomicBitmap& other) { words_.swap(other.words_); }
+
+ private:
+  IdType size_;
+  std::vector<std::atomic<uint64_t>> words_;
+};
+
+}  // namespace graphar::analytics
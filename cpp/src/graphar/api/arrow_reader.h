@@ -21,4 +21,9 @@
 
 #include "graphar/api/info.h"
 #include "graphar/arrow/chunk_reader.h"
+#include "graphar/chunk_cache.h"
+#include "graphar/chunk_prefetcher.h"
+#include "graphar/csr_graph.h"
 #include "graphar/expression.h"
+#include "graphar/graph_count_index.h"
+#include "graphar/offset_index.h"
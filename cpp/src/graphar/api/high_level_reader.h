@@ -21,3 +21,5 @@
 
 #include "graphar/api/info.h"
 #include "graphar/high-level/graph_reader.h"
+#include "graphar/label.h"
+#include "graphar/label_summary.h"
@@ -20,6 +20,7 @@
 #pragma once
 
 // Infos
+#include "graphar/context.h"
 #include "graphar/filesystem.h"
 #include "graphar/general_params.h"
 #include "graphar/graph_info.h"
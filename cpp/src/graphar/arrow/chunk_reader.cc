@@ -18,18 +18,27 @@
  */
 
 #include <algorithm>
+#include <deque>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "arrow/api.h"
 #include "arrow/compute/api.h"
+#include "arrow/util/future.h"
+#include "arrow/util/thread_pool.h"
 
 #include "graphar/arrow/chunk_reader.h"
+#include "graphar/chunk_cache.h"
+#include "graphar/chunk_prefetcher.h"
+#include "graphar/context.h"
 #include "graphar/filesystem.h"
 #include "graphar/fwd.h"
 #include "graphar/general_params.h"
+#include "graphar/graph_count_index.h"
 #include "graphar/graph_info.h"
+#include "graphar/offset_index.h"
 #include "graphar/reader_util.h"
 #include "graphar/result.h"
 #include "graphar/status.h"
@@ -67,48 +76,47 @@ Result<std::shared_ptr<arrow::Schema>> LabelToSchema(
   }
   return arrow::schema(fields);
 }
-Status GeneralCast(const std::shared_ptr<arrow::Array>& in,
-                   const std::shared_ptr<arrow::DataType>& to_type,
-                   std::shared_ptr<arrow::Array>* out) {
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(*out,
-                                       arrow::compute::Cast(*in, to_type));
-  return Status::OK();
+
+std::vector<std::string> GetSelectedColumns(
+    const util::FilterOptions& options) {
+  if (options.columns) {
+    return options.columns.value().get();
+  }
+  return {};
+}
+
+// the cache key of a chunk scanned with the options, the chunks that keep the
+// 32-bit string offsets are cached apart
+std::string MakeScanKey(const std::string& path,
+                        const util::FilterOptions& options) {
+  auto key = ChunkTableCache::MakeKey(path, GetSelectedColumns(options),
+                                      options.filter);
+  // an empty key is not cached
+  return options.large_string_offsets || key.empty() ? key : key + "#utf8";
 }
 
-Status CastStringToLargeString(const std::shared_ptr<arrow::Array>& in,
-                               const std::shared_ptr<arrow::DataType>& to_type,
-                               std::shared_ptr<arrow::Array>* out) {
-  auto array_data = in->data()->Copy();
-  auto offset = array_data->buffers[1];
-  using from_offset_type = typename arrow::StringArray::offset_type;
-  using to_string_offset_type = typename arrow::LargeStringArray::offset_type;
-  auto raw_value_offsets_ =
-      offset == NULLPTR
-          ? NULLPTR
-          : reinterpret_cast<const from_offset_type*>(offset->data());
-  std::vector<to_string_offset_type> to_offset(offset->size() /
-                                               sizeof(from_offset_type));
-  for (size_t i = 0; i < to_offset.size(); ++i) {
-    to_offset[i] = raw_value_offsets_[i];
-  }
-  std::shared_ptr<arrow::Buffer> buffer;
-  arrow::TypedBufferBuilder<to_string_offset_type> buffer_builder;
-  RETURN_NOT_ARROW_OK(
-      buffer_builder.Append(to_offset.data(), to_offset.size()));
-  RETURN_NOT_ARROW_OK(buffer_builder.Finish(&buffer));
-  array_data->type = to_type;
-  array_data->buffers[1] = buffer;
-  *out = arrow::MakeArray(array_data);
-  RETURN_NOT_ARROW_OK((*out)->ValidateFull());
+Status GeneralCast(const std::shared_ptr<arrow::Array>& in,
+                   const std::shared_ptr<arrow::DataType>& to_type,
+                   std::shared_ptr<arrow::Array>* out,
+                   arrow::MemoryPool* pool = arrow::default_memory_pool()) {
+  arrow::compute::ExecContext exec_context(pool);
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      *out, arrow::compute::Cast(*in, to_type,
+                                 arrow::compute::CastOptions::Safe(),
+                                 &exec_context));
   return Status::OK();
 }
 
-// helper function to cast arrow::Table with a schema
-Status CastTableWithSchema(const std::shared_ptr<arrow::Table>& table,
-                           const std::shared_ptr<arrow::Schema>& schema,
-                           std::shared_ptr<arrow::Table>* out_table) {
+// helper function to cast arrow::Table with a schema, the utf8 and binary
+// columns keep their 32-bit offsets unless `large_string_offsets` is true
+Status CastTableWithSchema(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::shared_ptr<arrow::Schema>& schema,
+    std::shared_ptr<arrow::Table>* out_table, bool large_string_offsets = true,
+    arrow::MemoryPool* pool = arrow::default_memory_pool()) {
   if (table->schema()->Equals(*schema)) {
     *out_table = table;
+    return Status::OK();
   }
   std::vector<std::shared_ptr<arrow::Field>> fields;
   std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
@@ -125,17 +133,25 @@ Status CastTableWithSchema(const std::shared_ptr<arrow::Table>& table,
     }
     auto from_t = table_field->type();
     auto to_t = schema_field->type();
+    if ((from_t->Equals(arrow::utf8()) && to_t->Equals(arrow::large_utf8())) ||
+        (from_t->Equals(arrow::binary()) &&
+         to_t->Equals(arrow::large_binary()))) {
+      if (large_string_offsets) {
+        GAR_ASSIGN_OR_RAISE(column, util::WidenStringOffsets(column, pool));
+        fields.push_back(arrow::field(field_name, to_t));
+      } else {
+        fields.push_back(table_field);
+      }
+      columns.push_back(column);
+      continue;
+    }
     std::vector<std::shared_ptr<arrow::Array>> chunks;
     // process cast for each chunk
     for (int64_t j = 0; j < column->num_chunks(); ++j) {
       auto chunk = column->chunk(j);
       std::shared_ptr<arrow::Array> out;
       if (arrow::compute::CanCast(*from_t, *to_t)) {
-        GAR_RETURN_NOT_OK(GeneralCast(chunk, to_t, &out));
-        chunks.push_back(out);
-      } else if (from_t->Equals(arrow::utf8()) &&
-                 to_t->Equals(arrow::large_utf8())) {
-        GAR_RETURN_NOT_OK(CastStringToLargeString(chunk, to_t, &out));
+        GAR_RETURN_NOT_OK(GeneralCast(chunk, to_t, &out, pool));
         chunks.push_back(out);
       }
     }
@@ -146,6 +162,124 @@ Status CastTableWithSchema(const std::shared_ptr<arrow::Table>& table,
   *out_table = arrow::Table::Make(new_schema, columns);
   return Status::OK();
 }
+// the loader of a chunk read through the scanner with the options, it owns a
+// copy of the options since it may run on the prefetch thread
+ChunkTableCache::Loader MakeScanLoader(const std::shared_ptr<FileSystem>& fs,
+                                       const std::string& path,
+                                       FileType file_type,
+                                       const util::FilterOptions& options,
+                                       const std::shared_ptr<arrow::Schema>&
+                                           schema) {
+  bool has_columns = options.columns.has_value();
+  return [fs, path, file_type, filter = options.filter, has_columns,
+          columns = GetSelectedColumns(options),
+          large_string_offsets = options.large_string_offsets,
+          context = options.context,
+          schema]() -> Result<std::shared_ptr<arrow::Table>> {
+    auto names = columns;
+    util::FilterOptions read_options;
+    read_options.filter = filter;
+    if (has_columns) {
+      read_options.columns = std::ref(names);
+    }
+    read_options.large_string_offsets = large_string_offsets;
+    read_options.context = context;
+    GAR_ASSIGN_OR_RAISE(auto table,
+                        fs->ReadFileToTable(path, file_type, read_options));
+    // TODO(acezen): filter pushdown doesn't support cast schema now
+    if (schema != nullptr && filter == nullptr) {
+      GAR_RETURN_NOT_OK(CastTableWithSchema(
+          table, schema, &table, large_string_offsets,
+          ExecutionContext::OrDefault(context).GetMemoryPool()));
+    }
+    return table;
+  };
+}
+
+// the loader of a chunk read by the column indices, the table is cast to the
+// schema unless it is nullptr
+ChunkTableCache::Loader MakeColumnLoader(
+    const std::shared_ptr<FileSystem>& fs, const std::string& path,
+    FileType file_type, const std::vector<int>& column_indices,
+    const std::shared_ptr<arrow::Schema>& schema, bool large_string_offsets,
+    const std::shared_ptr<ReadContext>& context) {
+  return [fs, path, file_type, column_indices, schema, large_string_offsets,
+          context]() -> Result<std::shared_ptr<arrow::Table>> {
+    GAR_ASSIGN_OR_RAISE(auto table, fs->ReadFileToTable(path, file_type,
+                                                        column_indices,
+                                                        context));
+    if (schema != nullptr) {
+      GAR_RETURN_NOT_OK(CastTableWithSchema(
+          table, schema, &table, large_string_offsets,
+          ExecutionContext::OrDefault(context).GetMemoryPool()));
+    }
+    return table;
+  };
+}
+
+// read a chunk through the ChunkTableCache, collecting the prefetched table
+// if the chunk is read ahead. The chunks read with a memory pool of their own
+// bypass the cache, so that they are released with the reader.
+Result<std::shared_ptr<arrow::Table>> LoadChunk(
+    const std::shared_ptr<ChunkPrefetcher>& prefetcher, const std::string& key,
+    const std::string& path, const ChunkTableCache::Loader& loader,
+    const std::shared_ptr<ReadContext>& context = nullptr) {
+  if (key.empty()) {
+    return loader();
+  }
+  if (context != nullptr && !context->IsDefaultMemoryPool()) {
+    return prefetcher == nullptr ? loader() : prefetcher->Take(key, loader);
+  }
+  if (prefetcher == nullptr) {
+    return ChunkTableCache::Global().GetOrLoad(key, path, loader);
+  }
+  return ChunkTableCache::Global().GetOrLoad(
+      key, path, [&]() { return prefetcher->Take(key, loader); });
+}
+
+// a prefetcher for a copy of a reader, which reads ahead on its own
+std::shared_ptr<ChunkPrefetcher> CopyPrefetcher(
+    const std::shared_ptr<ChunkPrefetcher>& prefetcher) {
+  if (prefetcher == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<ChunkPrefetcher>(prefetcher->GetDepth(),
+                                           prefetcher->GetExecutor());
+}
+
+// the loader of an adj list chunk
+ChunkTableCache::Loader MakeAdjListLoader(
+    const std::shared_ptr<FileSystem>& fs, const std::string& path,
+    FileType file_type, const std::shared_ptr<ReadContext>& context) {
+  return [fs, path, file_type, context]() {
+    util::FilterOptions options;
+    options.context = context;
+    return fs->ReadFileToTable(path, file_type, options);
+  };
+}
+
+// get the (vertex chunk index, edge chunk index) of the `count` non-empty
+// edge chunks from the given one, in the order of next_chunk()
+std::vector<std::pair<IdType, IdType>> GetNextEdgeChunks(
+    const GraphCountIndex& count_index, IdType vertex_chunk_index,
+    IdType chunk_index, IdType count) {
+  std::vector<std::pair<IdType, IdType>> chunks;
+  while (static_cast<IdType>(chunks.size()) < count &&
+         vertex_chunk_index < count_index.GetVertexChunkNum()) {
+    auto maybe_chunk_num = count_index.GetEdgeChunkNum(vertex_chunk_index);
+    if (maybe_chunk_num.has_error()) {
+      break;
+    }
+    if (chunk_index < maybe_chunk_num.value()) {
+      chunks.emplace_back(vertex_chunk_index, chunk_index++);
+    } else {
+      ++vertex_chunk_index;
+      chunk_index = 0;
+    }
+  }
+  return chunks;
+}
+
 }  // namespace
 
 VertexPropertyArrowChunkReader::VertexPropertyArrowChunkReader(
@@ -172,10 +306,10 @@ VertexPropertyArrowChunkReader::VertexPropertyArrowChunkReader(
   GAR_ASSIGN_OR_RAISE_ERROR(auto pg_path_prefix,
                             vertex_info->GetPathPrefix(property_group));
   std::string base_dir = prefix_ + pg_path_prefix;
-  GAR_ASSIGN_OR_RAISE_ERROR(chunk_num_,
-                            util::GetVertexChunkNum(prefix_, vertex_info));
+  GAR_ASSIGN_OR_RAISE_ERROR(
+      chunk_num_, util::GetVertexChunkNum(fs_, prefix_, vertex_info));
   GAR_ASSIGN_OR_RAISE_ERROR(vertex_num_,
-                            util::GetVertexNum(prefix_, vertex_info_));
+                            util::GetVertexNum(fs_, prefix_, vertex_info_));
   GAR_ASSIGN_OR_RAISE_ERROR(schema_,
                             PropertyGroupToSchema(property_group_, true));
 }
@@ -196,10 +330,10 @@ VertexPropertyArrowChunkReader::VertexPropertyArrowChunkReader(
 
   std::string base_dir = prefix_ + vertex_info_->GetPrefix() + "labels/chunk" +
                          std::to_string(chunk_index_);
-  GAR_ASSIGN_OR_RAISE_ERROR(chunk_num_,
-                            util::GetVertexChunkNum(prefix_, vertex_info));
+  GAR_ASSIGN_OR_RAISE_ERROR(
+      chunk_num_, util::GetVertexChunkNum(fs_, prefix_, vertex_info));
   GAR_ASSIGN_OR_RAISE_ERROR(vertex_num_,
-                            util::GetVertexNum(prefix_, vertex_info_));
+                            util::GetVertexNum(fs_, prefix_, vertex_info_));
   GAR_ASSIGN_OR_RAISE_ERROR(schema_, LabelToSchema(labels));
 }
 
@@ -208,8 +342,7 @@ Status VertexPropertyArrowChunkReader::seek(IdType id) {
   IdType pre_chunk_index = chunk_index_;
   chunk_index_ = id / vertex_info_->GetChunkSize();
   if (chunk_index_ != pre_chunk_index) {
-    // TODO(@acezen): use a cache to avoid reloading the same chunk, could use
-    //  a LRU cache.
+    // the chunk is reloaded through the ChunkTableCache if it is enabled
     chunk_table_.reset();
   }
   if (chunk_index_ >= chunk_num_) {
@@ -220,43 +353,133 @@ Status VertexPropertyArrowChunkReader::seek(IdType id) {
   return Status::OK();
 }
 
-Result<std::shared_ptr<arrow::Table>>
-VertexPropertyArrowChunkReader::GetChunkV2() {
-  if (chunk_table_ == nullptr) {
-    GAR_ASSIGN_OR_RAISE(
-        auto chunk_file_path,
-        vertex_info_->GetFilePath(property_group_, chunk_index_));
-    std::vector<int> column_indices = {};
-    std::vector<std::string> property_names;
-    if (!filter_options_.columns && !property_names_.empty()) {
-      property_names = property_names_;
-    } else {
-      if (!property_names_.empty()) {
+Status VertexPropertyArrowChunkReader::makeChunkLoader(
+    IdType chunk_index, bool use_scanner, std::string* key, std::string* path,
+    ChunkTableCache::Loader* loader) {
+  GAR_ASSIGN_OR_RAISE(auto chunk_file_path,
+                      vertex_info_->GetFilePath(property_group_, chunk_index));
+  *path = prefix_ + chunk_file_path;
+  auto file_type = property_group_->GetFileType();
+  if (use_scanner) {
+    util::FilterOptions read_options = filter_options_;
+    if (!property_names_.empty()) {
+      util::FilterOptions temp_filter_options = filter_options_;
+      if (!filter_options_.columns) {
+        temp_filter_options.columns = std::ref(property_names_);
+      } else {
         for (const auto& col : filter_options_.columns.value().get()) {
           if (std::find(property_names_.begin(), property_names_.end(), col) ==
               property_names_.end()) {
             return Status::Invalid("Column ", col,
                                    " is not in select properties.");
           }
-          property_names.push_back(col);
         }
+        temp_filter_options.columns = filter_options_.columns;
       }
+      read_options = temp_filter_options;
     }
-    for (const auto& col : property_names) {
-      auto field_index = schema_->GetFieldIndex(col);
-      if (field_index == -1) {
-        return Status::Invalid("Column ", col, " is not in select properties.");
+    *key = MakeScanKey(*path, read_options);
+    *loader = MakeScanLoader(fs_, *path, file_type, read_options, schema_);
+    return Status::OK();
+  }
+
+  std::vector<int> column_indices = {};
+  std::vector<std::string> property_names;
+  if (!filter_options_.columns && !property_names_.empty()) {
+    property_names = property_names_;
+  } else {
+    if (!property_names_.empty()) {
+      for (const auto& col : filter_options_.columns.value().get()) {
+        if (std::find(property_names_.begin(), property_names_.end(), col) ==
+            property_names_.end()) {
+          return Status::Invalid("Column ", col,
+                                 " is not in select properties.");
+        }
+        property_names.push_back(col);
       }
-      column_indices.push_back(field_index);
     }
-    std::string path = prefix_ + chunk_file_path;
-    GAR_ASSIGN_OR_RAISE(
-        chunk_table_, fs_->ReadFileToTable(path, property_group_->GetFileType(),
-                                           column_indices));
-    if (schema_ != nullptr && filter_options_.filter == nullptr) {
-      GAR_RETURN_NOT_OK(
-          CastTableWithSchema(chunk_table_, schema_, &chunk_table_));
+  }
+  for (const auto& col : property_names) {
+    auto field_index = schema_->GetFieldIndex(col);
+    if (field_index == -1) {
+      return Status::Invalid("Column ", col, " is not in select properties.");
     }
+    column_indices.push_back(field_index);
+  }
+  // column indices are keyed apart from the column names used by V1
+  std::vector<std::string> key_columns;
+  for (int index : column_indices) {
+    key_columns.push_back("#" + std::to_string(index));
+  }
+  // the chunk is cast to the schema only without a filter, so the filter is
+  // keyed as well
+  *key = ChunkTableCache::MakeKey(*path, key_columns, filter_options_.filter);
+  if (!filter_options_.large_string_offsets && !key->empty()) {
+    *key += "#utf8";
+  }
+  *loader = MakeColumnLoader(
+      fs_, *path, file_type, column_indices,
+      filter_options_.filter == nullptr ? schema_ : nullptr,
+      filter_options_.large_string_offsets, filter_options_.context);
+  return Status::OK();
+}
+
+VertexPropertyArrowChunkReader::VertexPropertyArrowChunkReader(
+    const VertexPropertyArrowChunkReader& other)
+    : vertex_info_(other.vertex_info_),
+      property_group_(other.property_group_),
+      property_names_(other.property_names_),
+      prefix_(other.prefix_),
+      labels_(other.labels_),
+      chunk_index_(other.chunk_index_),
+      seek_id_(other.seek_id_),
+      chunk_num_(other.chunk_num_),
+      vertex_num_(other.vertex_num_),
+      schema_(other.schema_),
+      chunk_table_(other.chunk_table_),
+      filter_options_(other.filter_options_),
+      fs_(other.fs_),
+      prefetcher_(CopyPrefetcher(other.prefetcher_)) {}
+
+void VertexPropertyArrowChunkReader::prefetch() {
+  if (prefetcher_ == nullptr || property_group_ == nullptr) {
+    return;
+  }
+  // follow the version chosen by GetChunkVersion::AUTO
+  bool use_scanner = filter_options_.filter != nullptr;
+  IdType end = std::min(chunk_num_, chunk_index_ + prefetcher_->GetDepth() + 1);
+  for (IdType i = chunk_index_; i < end; ++i) {
+    std::string key, path;
+    ChunkTableCache::Loader loader;
+    if (!makeChunkLoader(i, use_scanner, &key, &path, &loader).ok()) {
+      // the error is reported when the chunk is read
+      return;
+    }
+    prefetcher_->Prefetch(key, std::move(loader));
+  }
+}
+
+void VertexPropertyArrowChunkReader::SetPrefetchDepth(int depth) {
+  if (depth <= 0) {
+    prefetcher_.reset();
+    return;
+  }
+  const auto& context = ExecutionContext::OrDefault(filter_options_.context);
+  prefetcher_ =
+      std::make_shared<ChunkPrefetcher>(depth, context.GetLoadExecutor());
+  prefetch();
+}
+
+Result<std::shared_ptr<arrow::Table>>
+VertexPropertyArrowChunkReader::GetChunkV2() {
+  if (chunk_table_ == nullptr) {
+    std::string key, path;
+    ChunkTableCache::Loader loader;
+    GAR_RETURN_NOT_OK(
+        makeChunkLoader(chunk_index_, false, &key, &path, &loader));
+    GAR_ASSIGN_OR_RAISE(
+        chunk_table_,
+        LoadChunk(prefetcher_, key, path, loader, filter_options_.context));
   }
   IdType row_offset = seek_id_ - chunk_index_ * vertex_info_->GetChunkSize();
   return chunk_table_->Slice(row_offset);
@@ -266,41 +489,13 @@ Result<std::shared_ptr<arrow::Table>>
 VertexPropertyArrowChunkReader::GetChunkV1() {
   GAR_RETURN_NOT_OK(util::CheckFilterOptions(filter_options_, property_group_));
   if (chunk_table_ == nullptr) {
+    std::string key, path;
+    ChunkTableCache::Loader loader;
+    GAR_RETURN_NOT_OK(
+        makeChunkLoader(chunk_index_, true, &key, &path, &loader));
     GAR_ASSIGN_OR_RAISE(
-        auto chunk_file_path,
-        vertex_info_->GetFilePath(property_group_, chunk_index_));
-    std::string path = prefix_ + chunk_file_path;
-    if (property_names_.empty()) {
-      GAR_ASSIGN_OR_RAISE(
-          chunk_table_,
-          fs_->ReadFileToTable(path, property_group_->GetFileType(),
-                               filter_options_));
-    } else {
-      util::FilterOptions temp_filter_options;
-      temp_filter_options.filter = filter_options_.filter;
-      std::vector<std::string> intersection_columns;
-      if (!filter_options_.columns) {
-        temp_filter_options.columns = std::ref(property_names_);
-      } else {
-        for (const auto& col : filter_options_.columns.value().get()) {
-          if (std::find(property_names_.begin(), property_names_.end(), col) ==
-              property_names_.end()) {
-            return Status::Invalid("Column ", col,
-                                   " is not in select properties.");
-          }
-        }
-        temp_filter_options.columns = filter_options_.columns;
-      }
-      GAR_ASSIGN_OR_RAISE(
-          chunk_table_,
-          fs_->ReadFileToTable(path, property_group_->GetFileType(),
-                               temp_filter_options));
-    }
-    // TODO(acezen): filter pushdown doesn't support cast schema now
-    if (schema_ != nullptr && filter_options_.filter == nullptr) {
-      GAR_RETURN_NOT_OK(
-          CastTableWithSchema(chunk_table_, schema_, &chunk_table_));
-    }
+        chunk_table_,
+        LoadChunk(prefetcher_, key, path, loader, filter_options_.context));
   }
   IdType row_offset = seek_id_ - chunk_index_ * vertex_info_->GetChunkSize();
   return chunk_table_->Slice(row_offset);
@@ -330,8 +525,15 @@ VertexPropertyArrowChunkReader::GetLabelChunk() {
   if (chunk_table_ == nullptr) {
     std::string path = prefix_ + vertex_info_->GetPrefix() + "labels/chunk" +
                        std::to_string(chunk_index_);
-    GAR_ASSIGN_OR_RAISE(chunk_table_,
-                        fs_->ReadFileToTable(path, filetype, filter_options_));
+    auto key = MakeScanKey(path, filter_options_);
+    GAR_ASSIGN_OR_RAISE(
+        chunk_table_,
+        LoadChunk(
+            nullptr, key, path,
+            [&]() {
+              return fs_->ReadFileToTable(path, filetype, filter_options_);
+            },
+            filter_options_.context));
     // TODO(acezen): filter pushdown doesn't support cast schema now
     // if (schema_ != nullptr && filter_options_.filter == nullptr) {
     //   GAR_RETURN_NOT_OK(
@@ -350,6 +552,7 @@ Status VertexPropertyArrowChunkReader::next_chunk() {
   }
   seek_id_ = chunk_index_ * vertex_info_->GetChunkSize();
   chunk_table_.reset();
+  prefetch();
 
   return Status::OK();
 }
@@ -526,8 +729,9 @@ AdjListArrowChunkReader::AdjListArrowChunkReader(
                             edge_info->GetAdjListPathPrefix(adj_list_type));
   base_dir_ = prefix_ + adj_list_path_prefix;
   GAR_ASSIGN_OR_RAISE_ERROR(
-      vertex_chunk_num_,
-      util::GetVertexChunkNum(prefix_, edge_info_, adj_list_type_));
+      count_index_,
+      GraphCountIndex::Get(fs_, prefix_, edge_info_, adj_list_type_));
+  vertex_chunk_num_ = count_index_->GetVertexChunkNum();
 }
 
 AdjListArrowChunkReader::AdjListArrowChunkReader(
@@ -542,7 +746,10 @@ AdjListArrowChunkReader::AdjListArrowChunkReader(
       vertex_chunk_num_(other.vertex_chunk_num_),
       chunk_num_(other.chunk_num_),
       base_dir_(other.base_dir_),
-      fs_(other.fs_) {}
+      fs_(other.fs_),
+      count_index_(other.count_index_),
+      prefetcher_(CopyPrefetcher(other.prefetcher_)),
+      context_(other.context_) {}
 
 Status AdjListArrowChunkReader::seek_src(IdType id) {
   if (adj_list_type_ != AdjListType::unordered_by_source &&
@@ -569,9 +776,9 @@ Status AdjListArrowChunkReader::seek_src(IdType id) {
   if (adj_list_type_ == AdjListType::unordered_by_source) {
     return seek(0);  // start from first chunk
   } else {
-    GAR_ASSIGN_OR_RAISE(auto range,
-                        util::GetAdjListOffsetOfVertex(edge_info_, prefix_,
-                                                       adj_list_type_, id));
+    GAR_ASSIGN_OR_RAISE(
+        auto range, util::GetAdjListOffsetOfVertex(edge_info_, fs_, prefix_,
+                                                   adj_list_type_, id));
     return seek(range.first);
   }
   return Status::OK();
@@ -602,9 +809,9 @@ Status AdjListArrowChunkReader::seek_dst(IdType id) {
   if (adj_list_type_ == AdjListType::unordered_by_dest) {
     return seek(0);  // start from the first chunk
   } else {
-    GAR_ASSIGN_OR_RAISE(auto range,
-                        util::GetAdjListOffsetOfVertex(edge_info_, prefix_,
-                                                       adj_list_type_, id));
+    GAR_ASSIGN_OR_RAISE(
+        auto range, util::GetAdjListOffsetOfVertex(edge_info_, fs_, prefix_,
+                                                   adj_list_type_, id));
     return seek(range.first);
   }
 }
@@ -633,8 +840,7 @@ Result<std::shared_ptr<arrow::Table>> AdjListArrowChunkReader::GetChunk() {
   if (chunk_table_ == nullptr) {
     // check if the edge num of the current vertex chunk is 0
     GAR_ASSIGN_OR_RAISE(auto edge_num,
-                        util::GetEdgeNum(prefix_, edge_info_, adj_list_type_,
-                                         vertex_chunk_index_));
+                        count_index_->GetEdgeNum(vertex_chunk_index_));
     if (edge_num == 0) {
       return nullptr;
     }
@@ -643,7 +849,11 @@ Result<std::shared_ptr<arrow::Table>> AdjListArrowChunkReader::GetChunk() {
                             vertex_chunk_index_, chunk_index_, adj_list_type_));
     std::string path = prefix_ + chunk_file_path;
     auto file_type = edge_info_->GetAdjacentList(adj_list_type_)->GetFileType();
-    GAR_ASSIGN_OR_RAISE(chunk_table_, fs_->ReadFileToTable(path, file_type));
+    auto key = ChunkTableCache::MakeKey(path, {});
+    GAR_ASSIGN_OR_RAISE(
+        chunk_table_,
+        LoadChunk(prefetcher_, key, path,
+                  MakeAdjListLoader(fs_, path, file_type, context_), context_));
   }
   IdType row_offset = seek_offset_ - chunk_index_ * edge_info_->GetChunkSize();
   return chunk_table_->Slice(row_offset);
@@ -667,9 +877,50 @@ Status AdjListArrowChunkReader::next_chunk() {
   }
   seek_offset_ = chunk_index_ * edge_info_->GetChunkSize();
   chunk_table_.reset();
+  prefetch();
   return Status::OK();
 }
 
+void AdjListArrowChunkReader::prefetch() {
+  if (prefetcher_ == nullptr) {
+    return;
+  }
+  auto file_type = edge_info_->GetAdjacentList(adj_list_type_)->GetFileType();
+  for (const auto& chunk :
+       GetNextEdgeChunks(*count_index_, vertex_chunk_index_, chunk_index_,
+                         prefetcher_->GetDepth() + 1)) {
+    auto maybe_chunk_file_path = edge_info_->GetAdjListFilePath(
+        chunk.first, chunk.second, adj_list_type_);
+    if (maybe_chunk_file_path.has_error()) {
+      return;
+    }
+    std::string path = prefix_ + maybe_chunk_file_path.value();
+    prefetcher_->Prefetch(ChunkTableCache::MakeKey(path, {}),
+                          MakeAdjListLoader(fs_, path, file_type, context_));
+  }
+}
+
+void AdjListArrowChunkReader::SetPrefetchDepth(int depth) {
+  if (depth <= 0) {
+    prefetcher_.reset();
+    return;
+  }
+  prefetcher_ = std::make_shared<ChunkPrefetcher>(
+      depth, ExecutionContext::OrDefault(context_).GetLoadExecutor());
+  prefetch();
+}
+
+void AdjListArrowChunkReader::SetReadContext(
+    const std::shared_ptr<ReadContext>& context) {
+  context_ = context;
+  chunk_table_.reset();
+  if (prefetcher_ != nullptr) {
+    // drop the loads read ahead with the former context, and read ahead on
+    // the load executor of the new one
+    SetPrefetchDepth(prefetcher_->GetDepth());
+  }
+}
+
 Status AdjListArrowChunkReader::seek_chunk_index(IdType vertex_chunk_index,
                                                  IdType chunk_index) {
   if (chunk_num_ < 0 || vertex_chunk_index_ != vertex_chunk_index) {
@@ -692,7 +943,11 @@ Result<IdType> AdjListArrowChunkReader::GetRowNumOfChunk() {
                             vertex_chunk_index_, chunk_index_, adj_list_type_));
     std::string path = prefix_ + chunk_file_path;
     auto file_type = edge_info_->GetAdjacentList(adj_list_type_)->GetFileType();
-    GAR_ASSIGN_OR_RAISE(chunk_table_, fs_->ReadFileToTable(path, file_type));
+    auto key = ChunkTableCache::MakeKey(path, {});
+    GAR_ASSIGN_OR_RAISE(
+        chunk_table_,
+        LoadChunk(prefetcher_, key, path,
+                  MakeAdjListLoader(fs_, path, file_type, context_), context_));
   }
   return chunk_table_->num_rows();
 }
@@ -723,8 +978,7 @@ Result<std::shared_ptr<AdjListArrowChunkReader>> AdjListArrowChunkReader::Make(
 
 Status AdjListArrowChunkReader::initOrUpdateEdgeChunkNum() {
   GAR_ASSIGN_OR_RAISE(chunk_num_,
-                      util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                            vertex_chunk_index_));
+                      count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   return Status::OK();
 }
 
@@ -736,7 +990,7 @@ AdjListOffsetArrowChunkReader::AdjListOffsetArrowChunkReader(
       prefix_(prefix),
       chunk_index_(0),
       seek_id_(0),
-      chunk_table_(nullptr) {
+      offsets_(nullptr) {
   std::string base_dir;
   GAR_ASSIGN_OR_RAISE_ERROR(fs_, FileSystemFromUriOrPath(prefix, &prefix_));
   GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
@@ -745,11 +999,10 @@ AdjListOffsetArrowChunkReader::AdjListOffsetArrowChunkReader(
   if (adj_list_type == AdjListType::ordered_by_source ||
       adj_list_type == AdjListType::ordered_by_dest) {
     GAR_ASSIGN_OR_RAISE_ERROR(
-        vertex_chunk_num_,
-        util::GetVertexChunkNum(prefix_, edge_info_, adj_list_type_));
-    vertex_chunk_size_ = adj_list_type == AdjListType::ordered_by_source
-                             ? edge_info_->GetSrcChunkSize()
-                             : edge_info_->GetDstChunkSize();
+        offset_index_,
+        OffsetIndex::Get(fs_, prefix_, edge_info_, adj_list_type_));
+    vertex_chunk_num_ = offset_index_->GetVertexChunkNum();
+    vertex_chunk_size_ = offset_index_->GetVertexChunkSize();
   } else {
     std::string err_msg = "Invalid adj list type " +
                           std::string(AdjListTypeToString(adj_list_type)) +
@@ -763,7 +1016,7 @@ Status AdjListOffsetArrowChunkReader::seek(IdType id) {
   IdType pre_chunk_index = chunk_index_;
   chunk_index_ = id / vertex_chunk_size_;
   if (chunk_index_ != pre_chunk_index) {
-    chunk_table_.reset();
+    offsets_.reset();
   }
   if (chunk_index_ >= vertex_chunk_num_) {
     return Status::IndexError("Internal vertex id ", id, "is out of range [0,",
@@ -777,16 +1030,16 @@ Status AdjListOffsetArrowChunkReader::seek(IdType id) {
 
 Result<std::shared_ptr<arrow::Array>>
 AdjListOffsetArrowChunkReader::GetChunk() {
-  if (chunk_table_ == nullptr) {
-    GAR_ASSIGN_OR_RAISE(
-        auto chunk_file_path,
-        edge_info_->GetAdjListOffsetFilePath(chunk_index_, adj_list_type_));
-    std::string path = prefix_ + chunk_file_path;
-    auto file_type = edge_info_->GetAdjacentList(adj_list_type_)->GetFileType();
-    GAR_ASSIGN_OR_RAISE(chunk_table_, fs_->ReadFileToTable(path, file_type));
+  if (offsets_ == nullptr) {
+    GAR_ASSIGN_OR_RAISE(offsets_, offset_index_->GetOffsetChunk(chunk_index_));
   }
   IdType row_offset = seek_id_ - chunk_index_ * vertex_chunk_size_;
-  return chunk_table_->Slice(row_offset)->column(0)->chunk(0);
+  return offsets_->Slice(row_offset);
+}
+
+Result<AdjListOffsetArrowChunkReader::range_t>
+AdjListOffsetArrowChunkReader::GetRange() {
+  return offset_index_->GetRange(seek_id_);
 }
 
 Status AdjListOffsetArrowChunkReader::next_chunk() {
@@ -798,7 +1051,7 @@ Status AdjListOffsetArrowChunkReader::next_chunk() {
                               AdjListTypeToString(adj_list_type_), ".");
   }
   seek_id_ = chunk_index_ * vertex_chunk_size_;
-  chunk_table_.reset();
+  offsets_.reset();
 
   return Status::OK();
 }
@@ -851,8 +1104,9 @@ AdjListPropertyArrowChunkReader::AdjListPropertyArrowChunkReader(
       edge_info->GetPropertyGroupPathPrefix(property_group, adj_list_type));
   base_dir_ = prefix_ + pg_path_prefix;
   GAR_ASSIGN_OR_RAISE_ERROR(
-      vertex_chunk_num_,
-      util::GetVertexChunkNum(prefix_, edge_info_, adj_list_type_));
+      count_index_,
+      GraphCountIndex::Get(fs_, prefix_, edge_info_, adj_list_type_));
+  vertex_chunk_num_ = count_index_->GetVertexChunkNum();
   GAR_ASSIGN_OR_RAISE_ERROR(schema_,
                             PropertyGroupToSchema(property_group, false));
 }
@@ -872,7 +1126,9 @@ AdjListPropertyArrowChunkReader::AdjListPropertyArrowChunkReader(
       vertex_chunk_num_(other.vertex_chunk_num_),
       chunk_num_(other.chunk_num_),
       base_dir_(other.base_dir_),
-      fs_(other.fs_) {}
+      fs_(other.fs_),
+      count_index_(other.count_index_),
+      prefetcher_(CopyPrefetcher(other.prefetcher_)) {}
 
 Status AdjListPropertyArrowChunkReader::seek_src(IdType id) {
   if (adj_list_type_ != AdjListType::unordered_by_source &&
@@ -898,9 +1154,9 @@ Status AdjListPropertyArrowChunkReader::seek_src(IdType id) {
   if (adj_list_type_ == AdjListType::unordered_by_source) {
     return seek(0);  // start from first chunk
   } else {
-    GAR_ASSIGN_OR_RAISE(auto range,
-                        util::GetAdjListOffsetOfVertex(edge_info_, prefix_,
-                                                       adj_list_type_, id));
+    GAR_ASSIGN_OR_RAISE(
+        auto range, util::GetAdjListOffsetOfVertex(edge_info_, fs_, prefix_,
+                                                   adj_list_type_, id));
     return seek(range.first);
   }
   return Status::OK();
@@ -930,9 +1186,9 @@ Status AdjListPropertyArrowChunkReader::seek_dst(IdType id) {
   if (adj_list_type_ == AdjListType::unordered_by_dest) {
     return seek(0);  // start from the first chunk
   } else {
-    GAR_ASSIGN_OR_RAISE(auto range,
-                        util::GetAdjListOffsetOfVertex(edge_info_, prefix_,
-                                                       adj_list_type_, id));
+    GAR_ASSIGN_OR_RAISE(
+        auto range, util::GetAdjListOffsetOfVertex(edge_info_, fs_, prefix_,
+                                                   adj_list_type_, id));
     return seek(range.first);
   }
 }
@@ -963,8 +1219,7 @@ AdjListPropertyArrowChunkReader::GetChunk() {
   if (chunk_table_ == nullptr) {
     // check if the edge num of the current vertex chunk is 0
     GAR_ASSIGN_OR_RAISE(auto edge_num,
-                        util::GetEdgeNum(prefix_, edge_info_, adj_list_type_,
-                                         vertex_chunk_index_));
+                        count_index_->GetEdgeNum(vertex_chunk_index_));
     if (edge_num == 0) {
       return nullptr;
     }
@@ -973,14 +1228,13 @@ AdjListPropertyArrowChunkReader::GetChunk() {
         edge_info_->GetPropertyFilePath(property_group_, adj_list_type_,
                                         vertex_chunk_index_, chunk_index_));
     std::string path = prefix_ + chunk_file_path;
+    auto key = MakeScanKey(path, filter_options_);
     GAR_ASSIGN_OR_RAISE(
-        chunk_table_, fs_->ReadFileToTable(path, property_group_->GetFileType(),
-                                           filter_options_));
-    // TODO(acezen): filter pushdown doesn't support cast schema now
-    if (schema_ != nullptr && filter_options_.filter == nullptr) {
-      GAR_RETURN_NOT_OK(
-          CastTableWithSchema(chunk_table_, schema_, &chunk_table_));
-    }
+        chunk_table_,
+        LoadChunk(prefetcher_, key, path,
+                  MakeScanLoader(fs_, path, property_group_->GetFileType(),
+                                 filter_options_, schema_),
+                  filter_options_.context));
   }
   IdType row_offset = seek_offset_ - chunk_index_ * edge_info_->GetChunkSize();
   return chunk_table_->Slice(row_offset);
@@ -1007,9 +1261,41 @@ Status AdjListPropertyArrowChunkReader::next_chunk() {
   }
   seek_offset_ = chunk_index_ * edge_info_->GetChunkSize();
   chunk_table_.reset();
+  prefetch();
   return Status::OK();
 }
 
+void AdjListPropertyArrowChunkReader::prefetch() {
+  if (prefetcher_ == nullptr) {
+    return;
+  }
+  for (const auto& chunk :
+       GetNextEdgeChunks(*count_index_, vertex_chunk_index_, chunk_index_,
+                         prefetcher_->GetDepth() + 1)) {
+    auto maybe_chunk_file_path = edge_info_->GetPropertyFilePath(
+        property_group_, adj_list_type_, chunk.first, chunk.second);
+    if (maybe_chunk_file_path.has_error()) {
+      return;
+    }
+    std::string path = prefix_ + maybe_chunk_file_path.value();
+    prefetcher_->Prefetch(
+        MakeScanKey(path, filter_options_),
+        MakeScanLoader(fs_, path, property_group_->GetFileType(),
+                       filter_options_, schema_));
+  }
+}
+
+void AdjListPropertyArrowChunkReader::SetPrefetchDepth(int depth) {
+  if (depth <= 0) {
+    prefetcher_.reset();
+    return;
+  }
+  const auto& context = ExecutionContext::OrDefault(filter_options_.context);
+  prefetcher_ =
+      std::make_shared<ChunkPrefetcher>(depth, context.GetLoadExecutor());
+  prefetch();
+}
+
 Status AdjListPropertyArrowChunkReader::seek_chunk_index(
     IdType vertex_chunk_index, IdType chunk_index) {
   if (chunk_num_ < 0 || vertex_chunk_index_ != vertex_chunk_index) {
@@ -1086,9 +1372,689 @@ AdjListPropertyArrowChunkReader::Make(
 
 Status AdjListPropertyArrowChunkReader::initOrUpdateEdgeChunkNum() {
   GAR_ASSIGN_OR_RAISE(chunk_num_,
-                      util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                            vertex_chunk_index_));
+                      count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   return Status::OK();
 }
 
+NeighborArrowReader::NeighborArrowReader(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const PropertyGroupVector& property_groups)
+    : edge_info_(edge_info),
+      adj_list_type_(adj_list_type),
+      prefix_(prefix),
+      property_groups_(property_groups) {
+  if (adj_list_type != AdjListType::ordered_by_source &&
+      adj_list_type != AdjListType::ordered_by_dest) {
+    std::string err_msg = "Invalid adj list type " +
+                          std::string(AdjListTypeToString(adj_list_type)) +
+                          " to construct NeighborArrowReader.";
+    throw std::runtime_error(err_msg);
+  }
+  GAR_ASSIGN_OR_RAISE_ERROR(fs_, FileSystemFromUriOrPath(prefix, &prefix_));
+  GAR_ASSIGN_OR_RAISE_ERROR(
+      offset_index_,
+      OffsetIndex::Get(fs_, prefix_, edge_info_, adj_list_type_));
+  for (const auto& property_group : property_groups_) {
+    GAR_ASSIGN_OR_RAISE_ERROR(auto schema,
+                              PropertyGroupToSchema(property_group, false));
+    schemas_.push_back(schema);
+  }
+}
+
+Result<NeighborBatch> NeighborArrowReader::GetNeighbors(
+    const Array<IdType>& vids) {
+  IdType chunk_size = edge_info_->GetChunkSize();
+  IdType vertex_chunk_size = offset_index_->GetVertexChunkSize();
+  // the edge ranges of the vertices, and the edge chunks they hit mapped to
+  // the first row of the chunk in the gathered columns
+  std::vector<std::pair<IdType, IdType>> ranges(vids.size());
+  std::map<std::pair<IdType, IdType>, int64_t> chunk_bases;
+  arrow::Int64Builder offsets_builder;
+  RETURN_NOT_ARROW_OK(offsets_builder.Reserve(vids.size() + 1));
+  int64_t total_num = 0;
+  offsets_builder.UnsafeAppend(total_num);
+  for (size_t i = 0; i < vids.size(); ++i) {
+    GAR_ASSIGN_OR_RAISE(ranges[i], offset_index_->GetRange(vids[i]));
+    IdType vertex_chunk_index = vids[i] / vertex_chunk_size;
+    for (IdType chunk_index = ranges[i].first / chunk_size;
+         ranges[i].first < ranges[i].second &&
+         chunk_index * chunk_size < ranges[i].second;
+         ++chunk_index) {
+      chunk_bases.emplace(std::make_pair(vertex_chunk_index, chunk_index), 0);
+    }
+    total_num += ranges[i].second - ranges[i].first;
+    offsets_builder.UnsafeAppend(total_num);
+  }
+
+  // read each hit chunk once
+  const char* neighbor_col = adj_list_type_ == AdjListType::ordered_by_source
+                                 ? GeneralParams::kDstIndexCol
+                                 : GeneralParams::kSrcIndexCol;
+  arrow::ArrayVector neighbor_chunks;
+  std::vector<arrow::ArrayVector> property_chunks;
+  std::vector<std::shared_ptr<arrow::Field>> property_fields;
+  for (const auto& schema : schemas_) {
+    for (const auto& field : schema->fields()) {
+      property_fields.push_back(field);
+    }
+  }
+  property_chunks.resize(property_fields.size());
+  int64_t base = 0;
+  for (auto& chunk_base : chunk_bases) {
+    chunk_base.second = base;
+    IdType vertex_chunk_index = chunk_base.first.first;
+    IdType chunk_index = chunk_base.first.second;
+    GAR_ASSIGN_OR_RAISE(auto adj_list_table,
+                        readAdjListChunk(vertex_chunk_index, chunk_index));
+    auto neighbor_column = adj_list_table->GetColumnByName(neighbor_col);
+    if (neighbor_column == nullptr) {
+      return Status::Invalid("The adj list chunk has no column ", neighbor_col);
+    }
+    for (const auto& chunk : neighbor_column->chunks()) {
+      neighbor_chunks.push_back(chunk);
+    }
+    size_t field_index = 0;
+    for (size_t i = 0; i < property_groups_.size(); ++i) {
+      GAR_ASSIGN_OR_RAISE(
+          auto property_table,
+          readPropertyChunk(i, vertex_chunk_index, chunk_index));
+      for (const auto& field : schemas_[i]->fields()) {
+        auto column = property_table->GetColumnByName(field->name());
+        if (column == nullptr) {
+          return Status::Invalid("The property chunk has no column ",
+                                 field->name());
+        }
+        for (const auto& chunk : column->chunks()) {
+          property_chunks[field_index].push_back(chunk);
+        }
+        ++field_index;
+      }
+    }
+    base += adj_list_table->num_rows();
+  }
+
+  // gather the edges of all the vertices with one take
+  arrow::Int64Builder indices_builder;
+  RETURN_NOT_ARROW_OK(indices_builder.Reserve(total_num));
+  for (size_t i = 0; i < vids.size(); ++i) {
+    IdType vertex_chunk_index = vids[i] / vertex_chunk_size;
+    IdType begin = ranges[i].first, end = ranges[i].second;
+    for (IdType chunk_index = begin / chunk_size;
+         begin < end && chunk_index * chunk_size < end; ++chunk_index) {
+      IdType chunk_begin = chunk_index * chunk_size;
+      int64_t chunk_base =
+          chunk_bases.at(std::make_pair(vertex_chunk_index, chunk_index));
+      IdType lo = std::max(begin, chunk_begin);
+      IdType hi = std::min(end, chunk_begin + chunk_size);
+      for (IdType offset = lo; offset < hi; ++offset) {
+        indices_builder.UnsafeAppend(chunk_base + offset - chunk_begin);
+      }
+    }
+  }
+  std::shared_ptr<arrow::Array> indices;
+  RETURN_NOT_ARROW_OK(indices_builder.Finish(&indices));
+
+  NeighborBatch batch;
+  std::shared_ptr<arrow::Array> offsets;
+  RETURN_NOT_ARROW_OK(offsets_builder.Finish(&offsets));
+  batch.offsets = std::static_pointer_cast<arrow::Int64Array>(offsets);
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> property_columns;
+  for (size_t i = 0; i < property_fields.size(); ++i) {
+    property_columns.push_back(std::make_shared<arrow::ChunkedArray>(
+        property_chunks[i], property_fields[i]->type()));
+  }
+  auto property_table = arrow::Table::Make(arrow::schema(property_fields),
+                                           property_columns, base);
+  if (total_num == 0) {
+    // no edge is hit, the neighbors and properties are empty
+    std::shared_ptr<arrow::Array> neighbors;
+    RETURN_NOT_ARROW_OK(arrow::Int64Builder().Finish(&neighbors));
+    batch.neighbors = std::static_pointer_cast<arrow::Int64Array>(neighbors);
+    if (!property_groups_.empty()) {
+      batch.properties = property_table;
+    }
+    return batch;
+  }
+  auto neighbor_column =
+      std::make_shared<arrow::ChunkedArray>(neighbor_chunks, arrow::int64());
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto neighbors, arrow::compute::Take(neighbor_column, indices));
+  auto neighbor_array = neighbors.chunked_array();
+  if (neighbor_array->num_chunks() == 1) {
+    batch.neighbors =
+        std::static_pointer_cast<arrow::Int64Array>(neighbor_array->chunk(0));
+  } else {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto array, arrow::Concatenate(neighbor_array->chunks(),
+                                       arrow::default_memory_pool()));
+    batch.neighbors = std::static_pointer_cast<arrow::Int64Array>(array);
+  }
+  if (!property_groups_.empty()) {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto properties, arrow::compute::Take(property_table, indices));
+    batch.properties = properties.table();
+  }
+  return batch;
+}
+
+Result<std::shared_ptr<arrow::Table>> NeighborArrowReader::readAdjListChunk(
+    IdType vertex_chunk_index, IdType chunk_index) const {
+  GAR_ASSIGN_OR_RAISE(auto chunk_file_path,
+                      edge_info_->GetAdjListFilePath(
+                          vertex_chunk_index, chunk_index, adj_list_type_));
+  std::string path = prefix_ + chunk_file_path;
+  auto file_type = edge_info_->GetAdjacentList(adj_list_type_)->GetFileType();
+  auto key = ChunkTableCache::MakeKey(path, {});
+  return ChunkTableCache::Global().GetOrLoad(key, path, [&]() {
+    return fs_->ReadFileToTable(path, file_type);
+  });
+}
+
+Result<std::shared_ptr<arrow::Table>> NeighborArrowReader::readPropertyChunk(
+    size_t property_group_index, IdType vertex_chunk_index,
+    IdType chunk_index) const {
+  const auto& property_group = property_groups_[property_group_index];
+  const auto& schema = schemas_[property_group_index];
+  GAR_ASSIGN_OR_RAISE(
+      auto chunk_file_path,
+      edge_info_->GetPropertyFilePath(property_group, adj_list_type_,
+                                      vertex_chunk_index, chunk_index));
+  std::string path = prefix_ + chunk_file_path;
+  auto key = ChunkTableCache::MakeKey(path, {});
+  return ChunkTableCache::Global().GetOrLoad(
+      key, path, [&]() -> Result<std::shared_ptr<arrow::Table>> {
+        GAR_ASSIGN_OR_RAISE(
+            auto table,
+            fs_->ReadFileToTable(path, property_group->GetFileType()));
+        GAR_RETURN_NOT_OK(CastTableWithSchema(table, schema, &table));
+        return table;
+      });
+}
+
+Result<std::shared_ptr<NeighborArrowReader>> NeighborArrowReader::Make(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const PropertyGroupVector& property_groups) {
+  if (adj_list_type != AdjListType::ordered_by_source &&
+      adj_list_type != AdjListType::ordered_by_dest) {
+    return Status::Invalid(
+        "The adj list type has to be ordered_by_source or ordered_by_dest, but "
+        "got ",
+        std::string(AdjListTypeToString(adj_list_type)));
+  }
+  if (!edge_info->HasAdjacentListType(adj_list_type)) {
+    return Status::KeyError(
+        "The adjacent list type ", AdjListTypeToString(adj_list_type),
+        " doesn't exist in edge ", edge_info->GetEdgeType(), ".");
+  }
+  for (const auto& property_group : property_groups) {
+    if (!edge_info->HasPropertyGroup(property_group)) {
+      return Status::KeyError("Property group", " does not exist in the ",
+                              edge_info->GetEdgeType(), " edge info.");
+    }
+  }
+  return std::make_shared<NeighborArrowReader>(edge_info, adj_list_type,
+                                               prefix, property_groups);
+}
+
+Result<std::shared_ptr<NeighborArrowReader>> NeighborArrowReader::Make(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& src_type,
+    const std::string& edge_type, const std::string& dst_type,
+    AdjListType adj_list_type, const PropertyGroupVector& property_groups) {
+  auto edge_info = graph_info->GetEdgeInfo(src_type, edge_type, dst_type);
+  if (!edge_info) {
+    return Status::KeyError("The edge ", src_type, " ", edge_type, " ",
+                            dst_type, " doesn't exist.");
+  }
+  return Make(edge_info, adj_list_type, graph_info->GetPrefix(),
+              property_groups);
+}
+
+EdgeChunkCursor::EdgeChunkCursor(const std::shared_ptr<EdgeInfo>& edge_info,
+                                 AdjListType adj_list_type,
+                                 const std::string& prefix,
+                                 const PropertyGroupVector& property_groups)
+    : adj_list_reader_(edge_info, adj_list_type, prefix),
+      chunk_size_(edge_info->GetChunkSize()),
+      vertex_chunk_index_(0),
+      chunk_index_(0),
+      num_rows_(0),
+      sources_(nullptr),
+      destinations_(nullptr) {
+  for (const auto& property_group : property_groups) {
+    property_readers_.emplace_back(edge_info, property_group, adj_list_type,
+                                   prefix);
+  }
+  GAR_ASSIGN_OR_RAISE_ERROR(
+      count_index_, GraphCountIndex::Get(prefix, edge_info, adj_list_type));
+}
+
+Status EdgeChunkCursor::seek_chunk_index(IdType vertex_chunk_index,
+                                         IdType chunk_index) {
+  if (vertex_chunk_index < 0 ||
+      vertex_chunk_index >= count_index_->GetVertexChunkNum()) {
+    return Status::IndexError("vertex chunk index ", vertex_chunk_index,
+                              " is out-of-bounds for vertex chunk num ",
+                              count_index_->GetVertexChunkNum());
+  }
+  GAR_ASSIGN_OR_RAISE(auto chunk_num,
+                      count_index_->GetEdgeChunkNum(vertex_chunk_index));
+  // the first chunk of an empty vertex chunk is an empty chunk
+  if (chunk_index < 0 || (chunk_index > 0 && chunk_index >= chunk_num)) {
+    return Status::IndexError("edge chunk index ", chunk_index,
+                              " is out-of-bounds for edge chunk num ",
+                              chunk_num, " of vertex chunk ",
+                              vertex_chunk_index);
+  }
+  vertex_chunk_index_ = vertex_chunk_index;
+  chunk_index_ = chunk_index;
+  return load();
+}
+
+Status EdgeChunkCursor::next_chunk() {
+  IdType vertex_chunk_index = vertex_chunk_index_;
+  IdType chunk_index = chunk_index_ + 1;
+  while (true) {
+    if (vertex_chunk_index >= count_index_->GetVertexChunkNum()) {
+      return Status::IndexError("vertex chunk index ", vertex_chunk_index,
+                                " is out-of-bounds for vertex chunk num ",
+                                count_index_->GetVertexChunkNum());
+    }
+    GAR_ASSIGN_OR_RAISE(auto chunk_num,
+                        count_index_->GetEdgeChunkNum(vertex_chunk_index));
+    if (chunk_index < chunk_num) {
+      break;
+    }
+    ++vertex_chunk_index;
+    chunk_index = 0;
+  }
+  vertex_chunk_index_ = vertex_chunk_index;
+  chunk_index_ = chunk_index;
+  return load();
+}
+
+Result<std::shared_ptr<arrow::Table>> EdgeChunkCursor::GetProperties() {
+  if (property_readers_.empty() || properties_ != nullptr) {
+    return properties_;
+  }
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (auto& reader : property_readers_) {
+    std::shared_ptr<arrow::Table> table;
+    if (num_rows_ > 0) {
+      GAR_RETURN_NOT_OK(
+          reader.seek_chunk_index(vertex_chunk_index_, chunk_index_));
+      GAR_RETURN_NOT_OK(reader.seek(chunk_index_ * chunk_size_));
+      GAR_ASSIGN_OR_RAISE(table, reader.GetChunk());
+    }
+    if (table == nullptr) {
+      continue;
+    }
+    for (int i = 0; i < table->num_columns(); ++i) {
+      fields.push_back(table->field(i));
+      columns.push_back(table->column(i));
+    }
+  }
+  auto table = arrow::Table::Make(arrow::schema(fields), columns, num_rows_);
+  // combine the chunks so that a row is addressed in one array
+  const auto& read_context = ExecutionContext::OrDefault(
+      property_readers_.front().GetReadContext());
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      properties_, table->CombineChunks(read_context.GetMemoryPool()));
+  return properties_;
+}
+
+Status EdgeChunkCursor::load() {
+  num_rows_ = 0;
+  src_array_.reset();
+  dst_array_.reset();
+  sources_ = nullptr;
+  destinations_ = nullptr;
+  properties_.reset();
+  GAR_ASSIGN_OR_RAISE(auto edge_num,
+                      count_index_->GetEdgeNum(vertex_chunk_index_));
+  if (edge_num == 0) {
+    return Status::OK();
+  }
+  GAR_RETURN_NOT_OK(
+      adj_list_reader_.seek_chunk_index(vertex_chunk_index_, chunk_index_));
+  GAR_RETURN_NOT_OK(adj_list_reader_.seek(chunk_index_ * chunk_size_));
+  GAR_ASSIGN_OR_RAISE(auto table, adj_list_reader_.GetChunk());
+  auto flatten = [&table](const std::string& name)
+      -> Result<std::shared_ptr<arrow::Int64Array>> {
+    auto column = table->GetColumnByName(name);
+    if (column == nullptr || column->type()->id() != arrow::Type::INT64) {
+      return Status::Invalid("The adj list chunk has no int64 column ", name);
+    }
+    if (column->num_chunks() == 1) {
+      return std::static_pointer_cast<arrow::Int64Array>(column->chunk(0));
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto array,
+        arrow::Concatenate(column->chunks(), arrow::default_memory_pool()));
+    return std::static_pointer_cast<arrow::Int64Array>(array);
+  };
+  GAR_ASSIGN_OR_RAISE(src_array_, flatten(GeneralParams::kSrcIndexCol));
+  GAR_ASSIGN_OR_RAISE(dst_array_, flatten(GeneralParams::kDstIndexCol));
+  num_rows_ = table->num_rows();
+  sources_ = src_array_->raw_values();
+  destinations_ = dst_array_->raw_values();
+  return Status::OK();
+}
+
+Result<std::shared_ptr<EdgeChunkCursor>> EdgeChunkCursor::Make(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const PropertyGroupVector& property_groups) {
+  if (!edge_info->HasAdjacentListType(adj_list_type)) {
+    return Status::KeyError(
+        "The adjacent list type ", AdjListTypeToString(adj_list_type),
+        " doesn't exist in edge ", edge_info->GetEdgeType(), ".");
+  }
+  for (const auto& property_group : property_groups) {
+    if (!edge_info->HasPropertyGroup(property_group)) {
+      return Status::KeyError("Property group", " does not exist in the ",
+                              edge_info->GetEdgeType(), " edge info.");
+    }
+  }
+  return std::make_shared<EdgeChunkCursor>(edge_info, adj_list_type, prefix,
+                                           property_groups);
+}
+
+Result<std::shared_ptr<EdgeChunkCursor>> EdgeChunkCursor::Make(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& src_type,
+    const std::string& edge_type, const std::string& dst_type,
+    AdjListType adj_list_type, const PropertyGroupVector& property_groups) {
+  auto edge_info = graph_info->GetEdgeInfo(src_type, edge_type, dst_type);
+  if (!edge_info) {
+    return Status::KeyError("The edge ", src_type, " ", edge_type, " ",
+                            dst_type, " doesn't exist.");
+  }
+  return Make(edge_info, adj_list_type, graph_info->GetPrefix(),
+              property_groups);
+}
+
+namespace {
+using ChunkFuture = arrow::Future<std::shared_ptr<arrow::Table>>;
+
+arrow::internal::Executor* GetExecutorOrDefault(
+    arrow::internal::Executor* executor,
+    const std::shared_ptr<ReadContext>& context) {
+  // the loads wait for their file reads on the executor of the context, so
+  // they run on the load executor
+  return executor != nullptr
+             ? executor
+             : ExecutionContext::OrDefault(context).GetLoadExecutor();
+}
+
+// start loading a chunk on the executor
+Result<ChunkFuture> SubmitChunkLoad(arrow::internal::Executor* executor,
+                                    const ChunkTableCache::Loader& loader) {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto future,
+      executor->Submit(
+          [loader]() -> arrow::Result<std::shared_ptr<arrow::Table>> {
+            auto maybe_table = loader();
+            if (maybe_table.has_error()) {
+              return arrow::Status::IOError(maybe_table.status().message());
+            }
+            return maybe_table.value();
+          }));
+  return future;
+}
+
+// the loaders of the chunks of a vertex property group, in the chunk order
+Status GetVertexPropertyGroupLoaders(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& type,
+    const std::shared_ptr<PropertyGroup>& property_group,
+    const util::FilterOptions& options,
+    std::vector<ChunkTableCache::Loader>* loaders,
+    std::shared_ptr<arrow::Schema>* schema) {
+  auto vertex_info = graph_info->GetVertexInfo(type);
+  if (!vertex_info) {
+    return Status::KeyError("The vertex type ", type,
+                            " doesn't exist in graph ", graph_info->GetName(),
+                            ".");
+  }
+  if (!vertex_info->HasPropertyGroup(property_group)) {
+    return Status::KeyError("The property group does not exist in the ", type,
+                            " vertex info.");
+  }
+  GAR_RETURN_NOT_OK(util::CheckFilterOptions(options, property_group));
+  std::string prefix;
+  GAR_ASSIGN_OR_RAISE(
+      auto fs, FileSystemFromUriOrPath(graph_info->GetPrefix(), &prefix));
+  GAR_ASSIGN_OR_RAISE(auto chunk_num,
+                      util::GetVertexChunkNum(fs, prefix, vertex_info));
+  GAR_ASSIGN_OR_RAISE(*schema, PropertyGroupToSchema(property_group, true));
+  loaders->clear();
+  for (IdType i = 0; i < chunk_num; ++i) {
+    GAR_ASSIGN_OR_RAISE(auto chunk_file_path,
+                        vertex_info->GetFilePath(property_group, i));
+    loaders->push_back(MakeScanLoader(fs, prefix + chunk_file_path,
+                                      property_group->GetFileType(), options,
+                                      *schema));
+  }
+  return Status::OK();
+}
+
+// the loaders of the chunks of an adj list, in the order of next_chunk()
+Status GetAdjListLoaders(const std::shared_ptr<EdgeInfo>& edge_info,
+                         AdjListType adj_list_type, const std::string& prefix,
+                         const util::FilterOptions& options,
+                         std::vector<ChunkTableCache::Loader>* loaders,
+                         std::shared_ptr<arrow::Schema>* schema) {
+  if (!edge_info->HasAdjacentListType(adj_list_type)) {
+    return Status::KeyError(
+        "The adjacent list type ", AdjListTypeToString(adj_list_type),
+        " doesn't exist in edge ", edge_info->GetEdgeType(), ".");
+  }
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(
+      auto count_index,
+      GraphCountIndex::Get(fs, out_prefix, edge_info, adj_list_type));
+  auto file_type = edge_info->GetAdjacentList(adj_list_type)->GetFileType();
+  *schema = arrow::schema(
+      {arrow::field(GeneralParams::kSrcIndexCol, arrow::int64()),
+       arrow::field(GeneralParams::kDstIndexCol, arrow::int64())});
+  loaders->clear();
+  for (IdType i = 0; i < count_index->GetVertexChunkNum(); ++i) {
+    GAR_ASSIGN_OR_RAISE(auto chunk_num, count_index->GetEdgeChunkNum(i));
+    for (IdType j = 0; j < chunk_num; ++j) {
+      GAR_ASSIGN_OR_RAISE(auto chunk_file_path,
+                          edge_info->GetAdjListFilePath(i, j, adj_list_type));
+      loaders->push_back(MakeScanLoader(fs, out_prefix + chunk_file_path,
+                                        file_type, options, nullptr));
+    }
+  }
+  return Status::OK();
+}
+
+// read all the chunks in parallel and concatenate them in order, the empty
+// schema is used if there is no chunk
+Result<std::shared_ptr<arrow::Table>> ReadChunksToTable(
+    const std::vector<ChunkTableCache::Loader>& loaders,
+    const std::shared_ptr<arrow::Schema>& empty_schema,
+    arrow::internal::Executor* executor, arrow::MemoryPool* pool) {
+  if (loaders.empty()) {
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    for (const auto& field : empty_schema->fields()) {
+      columns.push_back(std::make_shared<arrow::ChunkedArray>(
+          arrow::ArrayVector{}, field->type()));
+    }
+    return arrow::Table::Make(empty_schema, columns, 0);
+  }
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  tables.reserve(loaders.size());
+  if (executor->OwnsThisThread()) {
+    // a load of the executor would wait for the loads queued behind it
+    for (const auto& loader : loaders) {
+      GAR_ASSIGN_OR_RAISE(auto table, loader());
+      tables.push_back(std::move(table));
+    }
+  } else {
+    std::vector<ChunkFuture> futures;
+    futures.reserve(loaders.size());
+    for (const auto& loader : loaders) {
+      GAR_ASSIGN_OR_RAISE(auto future, SubmitChunkLoad(executor, loader));
+      futures.push_back(std::move(future));
+    }
+    for (auto& future : futures) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto table, future.result());
+      tables.push_back(std::move(table));
+    }
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto table,
+      arrow::ConcatenateTables(
+          tables, arrow::ConcatenateTablesOptions::Defaults(), pool));
+  return table;
+}
+
+// a record batch reader over the chunks, which keeps the next chunks loading
+// on the executor while the batches of the current one are consumed
+class ChunkStreamReader : public arrow::RecordBatchReader {
+ public:
+  ChunkStreamReader(std::vector<ChunkTableCache::Loader> loaders,
+                    arrow::internal::Executor* executor)
+      : loaders_(std::move(loaders)),
+        executor_(executor),
+        window_(std::max(1, executor->GetCapacity())),
+        next_(0) {}
+
+  // start loading the first chunks and wait for the first one to get the
+  // schema, the empty schema is used if there is no chunk
+  Status Init(const std::shared_ptr<arrow::Schema>& empty_schema) {
+    GAR_RETURN_NOT_OK(fill());
+    if (in_flight_.empty()) {
+      schema_ = empty_schema;
+      return Status::OK();
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table_, in_flight_.front().result());
+    in_flight_.pop_front();
+    GAR_RETURN_NOT_OK(fill());
+    schema_ = table_->schema();
+    batch_reader_ = std::make_shared<arrow::TableBatchReader>(*table_);
+    return Status::OK();
+  }
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    while (true) {
+      if (batch_reader_ != nullptr) {
+        ARROW_RETURN_NOT_OK(batch_reader_->ReadNext(batch));
+        if (*batch != nullptr) {
+          return arrow::Status::OK();
+        }
+        batch_reader_.reset();
+        table_.reset();
+      }
+      if (in_flight_.empty()) {
+        *batch = nullptr;
+        return arrow::Status::OK();
+      }
+      ARROW_ASSIGN_OR_RAISE(table_, in_flight_.front().result());
+      in_flight_.pop_front();
+      auto status = fill();
+      if (!status.ok()) {
+        return arrow::Status::IOError(status.message());
+      }
+      batch_reader_ = std::make_shared<arrow::TableBatchReader>(*table_);
+    }
+  }
+
+ private:
+  // keep `window_` chunks loading
+  Status fill() {
+    if (executor_->OwnsThisThread()) {
+      // a load of the executor would wait for the loads queued behind it, so
+      // the next chunk is loaded inline instead
+      if (in_flight_.empty() && next_ < loaders_.size()) {
+        GAR_ASSIGN_OR_RAISE(auto table, loaders_[next_++]());
+        in_flight_.push_back(ChunkFuture::MakeFinished(std::move(table)));
+      }
+      return Status::OK();
+    }
+    while (static_cast<int>(in_flight_.size()) < window_ &&
+           next_ < loaders_.size()) {
+      GAR_ASSIGN_OR_RAISE(auto future,
+                          SubmitChunkLoad(executor_, loaders_[next_++]));
+      in_flight_.push_back(std::move(future));
+    }
+    return Status::OK();
+  }
+
+  std::vector<ChunkTableCache::Loader> loaders_;
+  arrow::internal::Executor* executor_;
+  int window_;
+  size_t next_;
+  std::deque<ChunkFuture> in_flight_;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::shared_ptr<arrow::Table> table_;
+  std::shared_ptr<arrow::TableBatchReader> batch_reader_;
+};
+
+Result<std::shared_ptr<arrow::RecordBatchReader>> MakeChunkStreamReader(
+    std::vector<ChunkTableCache::Loader> loaders,
+    const std::shared_ptr<arrow::Schema>& empty_schema,
+    arrow::internal::Executor* executor) {
+  auto reader = std::make_shared<ChunkStreamReader>(std::move(loaders),
+                                                    executor);
+  GAR_RETURN_NOT_OK(reader->Init(empty_schema));
+  return reader;
+}
+}  // namespace
+
+Result<std::shared_ptr<arrow::Table>> ReadVertexPropertyGroup(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& type,
+    const std::shared_ptr<PropertyGroup>& property_group,
+    const util::FilterOptions& options, arrow::internal::Executor* executor) {
+  std::vector<ChunkTableCache::Loader> loaders;
+  std::shared_ptr<arrow::Schema> schema;
+  GAR_RETURN_NOT_OK(GetVertexPropertyGroupLoaders(
+      graph_info, type, property_group, options, &loaders, &schema));
+  return ReadChunksToTable(
+      loaders, schema, GetExecutorOrDefault(executor, options.context),
+      ExecutionContext::OrDefault(options.context).GetMemoryPool());
+}
+
+Result<std::shared_ptr<arrow::RecordBatchReader>> ReadVertexPropertyGroupStream(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& type,
+    const std::shared_ptr<PropertyGroup>& property_group,
+    const util::FilterOptions& options, arrow::internal::Executor* executor) {
+  std::vector<ChunkTableCache::Loader> loaders;
+  std::shared_ptr<arrow::Schema> schema;
+  GAR_RETURN_NOT_OK(GetVertexPropertyGroupLoaders(
+      graph_info, type, property_group, options, &loaders, &schema));
+  return MakeChunkStreamReader(
+      std::move(loaders), schema,
+      GetExecutorOrDefault(executor, options.context));
+}
+
+Result<std::shared_ptr<arrow::Table>> ReadAdjList(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const util::FilterOptions& options,
+    arrow::internal::Executor* executor) {
+  std::vector<ChunkTableCache::Loader> loaders;
+  std::shared_ptr<arrow::Schema> schema;
+  GAR_RETURN_NOT_OK(GetAdjListLoaders(edge_info, adj_list_type, prefix,
+                                      options, &loaders, &schema));
+  return ReadChunksToTable(
+      loaders, schema, GetExecutorOrDefault(executor, options.context),
+      ExecutionContext::OrDefault(options.context).GetMemoryPool());
+}
+
+Result<std::shared_ptr<arrow::RecordBatchReader>> ReadAdjListStream(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const util::FilterOptions& options,
+    arrow::internal::Executor* executor) {
+  std::vector<ChunkTableCache::Loader> loaders;
+  std::shared_ptr<arrow::Schema> schema;
+  GAR_RETURN_NOT_OK(GetAdjListLoaders(edge_info, adj_list_type, prefix,
+                                      options, &loaders, &schema));
+  return MakeChunkStreamReader(
+      std::move(loaders), schema,
+      GetExecutorOrDefault(executor, options.context));
+}
+
 }  // namespace graphar
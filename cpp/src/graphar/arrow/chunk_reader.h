@@ -24,15 +24,22 @@
 #include <utility>
 #include <vector>
 
+#include "graphar/chunk_cache.h"
 #include "graphar/fwd.h"
 #include "graphar/reader_util.h"
 #include "graphar/status.h"
+#include "graphar/util.h"
 
 // forward declaration
 namespace arrow {
 class Array;
+class Int64Array;
+class RecordBatchReader;
 class Schema;
 class Table;
+namespace internal {
+class Executor;
+}  // namespace internal
 }  // namespace arrow
 
 namespace graphar {
@@ -69,6 +76,11 @@ class VertexPropertyArrowChunkReader {
 
   VertexPropertyArrowChunkReader() : vertex_info_(nullptr), prefix_("") {}
 
+  /**
+   * @brief Copy constructor, the copy reads ahead on its own.
+   */
+  VertexPropertyArrowChunkReader(const VertexPropertyArrowChunkReader& other);
+
   /**
    * @brief Initialize the VertexPropertyArrowChunkReader.
    *
@@ -107,6 +119,16 @@ class VertexPropertyArrowChunkReader {
    */
   Status next_chunk();
 
+  /**
+   * @brief Read ahead the next chunks on the load executor of the read
+   * context, so that loading them overlaps the processing of the current
+   * chunk in a sequential scan with next_chunk(). The read-ahead is disabled
+   * by default.
+   *
+   * @param depth The number of chunks to read ahead, 0 to disable.
+   */
+  void SetPrefetchDepth(int depth);
+
   /**
    * @brief Get the chunk number of current vertex property group.
    */
@@ -128,6 +150,13 @@ class VertexPropertyArrowChunkReader {
    */
   void Select(util::ColumnNames column_names = std::nullopt);
 
+  /**
+   * @brief Get the read context of the options, nullptr for the default one.
+   */
+  const std::shared_ptr<ReadContext>& GetReadContext() const noexcept {
+    return filter_options_.context;
+  }
+
   /**
    * @brief Create a VertexPropertyArrowChunkReader instance from vertex info.
    *
@@ -254,6 +283,16 @@ class VertexPropertyArrowChunkReader {
    * @brief Read the chunk through the reader.
    */
   Result<std::shared_ptr<arrow::Table>> GetChunkV2();
+  /**
+   * @brief Get the cache key, the path and the loader of a chunk, which is
+   * read through the scanner if use_scanner is true, by the column indices
+   * otherwise.
+   */
+  Status makeChunkLoader(IdType chunk_index, bool use_scanner,
+                         std::string* key, std::string* path,
+                         ChunkTableCache::Loader* loader);
+  /** @brief Start reading ahead the chunks from the current one. */
+  void prefetch();
 
  private:
   std::shared_ptr<VertexInfo> vertex_info_;
@@ -269,6 +308,7 @@ class VertexPropertyArrowChunkReader {
   std::shared_ptr<arrow::Table> chunk_table_;
   util::FilterOptions filter_options_;
   std::shared_ptr<FileSystem> fs_;
+  std::shared_ptr<ChunkPrefetcher> prefetcher_;
 };
 
 /**
@@ -335,6 +375,24 @@ class AdjListArrowChunkReader {
    */
   Status next_chunk();
 
+  /**
+   * @brief Read ahead the next chunks on the load executor of the read
+   * context, so that loading them overlaps the processing of the current
+   * chunk in a sequential scan with next_chunk(). The read-ahead is disabled
+   * by default.
+   *
+   * @param depth The number of chunks to read ahead, 0 to disable.
+   */
+  void SetPrefetchDepth(int depth);
+
+  /**
+   * @brief Set the memory pool and executor to read the chunks with, the
+   * default ones are used if it is not set.
+   *
+   * @param context The read context, nullptr for the default one.
+   */
+  void SetReadContext(const std::shared_ptr<ReadContext>& context);
+
   /**
    * @brief Sets chunk position to the specific vertex chunk and edge chunk.
    *
@@ -372,6 +430,9 @@ class AdjListArrowChunkReader {
  private:
   Status initOrUpdateEdgeChunkNum();
 
+  // start reading ahead the chunks from the current one
+  void prefetch();
+
  private:
   std::shared_ptr<EdgeInfo> edge_info_;
   AdjListType adj_list_type_;
@@ -382,6 +443,9 @@ class AdjListArrowChunkReader {
   IdType vertex_chunk_num_, chunk_num_;
   std::string base_dir_;
   std::shared_ptr<FileSystem> fs_;
+  std::shared_ptr<const GraphCountIndex> count_index_;
+  std::shared_ptr<ChunkPrefetcher> prefetcher_;
+  std::shared_ptr<ReadContext> context_;
 };
 
 /**
@@ -418,6 +482,12 @@ class AdjListOffsetArrowChunkReader {
    */
   Result<std::shared_ptr<arrow::Array>> GetChunk();
 
+  /**
+   * @brief Get the edge offset range [begin, end) of the vertex seeked to,
+   * served from the pinned offset arrays.
+   */
+  Result<range_t> GetRange();
+
   /**
    * @brief Sets chunk position indicator to next chunk.
    *     if current chunk is the last chunk, will return Status::IndexError
@@ -461,11 +531,12 @@ class AdjListOffsetArrowChunkReader {
   std::string prefix_;
   IdType chunk_index_;
   IdType seek_id_;
-  std::shared_ptr<arrow::Table> chunk_table_;
+  std::shared_ptr<arrow::Int64Array> offsets_;
   IdType vertex_chunk_num_;
   IdType vertex_chunk_size_;
   std::string base_dir_;
   std::shared_ptr<FileSystem> fs_;
+  std::shared_ptr<OffsetIndex> offset_index_;
 };
 
 /**
@@ -532,6 +603,16 @@ class AdjListPropertyArrowChunkReader {
    */
   Status next_chunk();
 
+  /**
+   * @brief Read ahead the next chunks on the load executor of the read
+   * context, so that loading them overlaps the processing of the current
+   * chunk in a sequential scan with next_chunk(). The read-ahead is disabled
+   * by default.
+   *
+   * @param depth The number of chunks to read ahead, 0 to disable.
+   */
+  void SetPrefetchDepth(int depth);
+
   /**
    * @brief Sets chunk position to the specific vertex chunk and edge chunk.
    *
@@ -557,6 +638,13 @@ class AdjListPropertyArrowChunkReader {
    */
   void Select(util::ColumnNames column_names = std::nullopt);
 
+  /**
+   * @brief Get the read context of the options, nullptr for the default one.
+   */
+  const std::shared_ptr<ReadContext>& GetReadContext() const noexcept {
+    return filter_options_.context;
+  }
+
   /**
    * @brief Create an AdjListPropertyArrowChunkReader instance from edge info.
    *
@@ -613,6 +701,9 @@ class AdjListPropertyArrowChunkReader {
  private:
   Status initOrUpdateEdgeChunkNum();
 
+  // start reading ahead the chunks from the current one
+  void prefetch();
+
  private:
   std::shared_ptr<EdgeInfo> edge_info_;
   std::shared_ptr<PropertyGroup> property_group_;
@@ -626,5 +717,298 @@ class AdjListPropertyArrowChunkReader {
   IdType vertex_chunk_num_, chunk_num_;
   std::string base_dir_;
   std::shared_ptr<FileSystem> fs_;
+  std::shared_ptr<const GraphCountIndex> count_index_;
+  std::shared_ptr<ChunkPrefetcher> prefetcher_;
+};
+
+/**
+ * @brief The neighbors of a batch of vertices in CSR layout.
+ *
+ * The neighbors of the i-th requested vertex are the entries
+ * [offsets[i], offsets[i + 1]) of neighbors, and the rows of the same range
+ * of properties if any property group is requested.
+ */
+struct NeighborBatch {
+  /// The offsets of each requested vertex, the length is the number of
+  /// requested vertices plus one.
+  std::shared_ptr<arrow::Int64Array> offsets;
+  /// The internal ids of the neighbors.
+  std::shared_ptr<arrow::Int64Array> neighbors;
+  /// The properties of the edges, aligned with neighbors, or nullptr if no
+  /// property group is requested.
+  std::shared_ptr<arrow::Table> properties;
+};
+
+/**
+ * @brief The arrow reader to retrieve the neighbors of a batch of vertices
+ * from an ordered adjacency list.
+ *
+ * The requested vertices are grouped by the vertex chunk and edge chunk they
+ * hit, each chunk is read once and the neighbors are gathered with one take
+ * over the read chunks, instead of seeking and slicing once per vertex.
+ */
+class NeighborArrowReader {
+ public:
+  /**
+   * @brief Initialize the NeighborArrowReader.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type, ordered_by_source to get the
+   * outgoing neighbors or ordered_by_dest to get the incoming neighbors.
+   * @param prefix The absolute prefix.
+   * @param property_groups The property groups of the edges to gather along
+   * with the neighbors, default is empty.
+   */
+  NeighborArrowReader(const std::shared_ptr<EdgeInfo>& edge_info,
+                      AdjListType adj_list_type, const std::string& prefix,
+                      const PropertyGroupVector& property_groups = {});
+
+  /**
+   * @brief Get the neighbors of a batch of vertices.
+   *
+   * @param vids The internal ids of the vertices, duplicates are allowed and
+   * the order is kept in the result.
+   * @return The neighbors in CSR layout, or IndexError if any id is out of
+   * range.
+   */
+  Result<NeighborBatch> GetNeighbors(const Array<IdType>& vids);
+
+  /**
+   * @brief Create a NeighborArrowReader instance from edge info.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type, ordered_by_source or
+   * ordered_by_dest.
+   * @param prefix The absolute prefix of the graph.
+   * @param property_groups The property groups of the edges to gather along
+   * with the neighbors, default is empty.
+   */
+  static Result<std::shared_ptr<NeighborArrowReader>> Make(
+      const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+      const std::string& prefix,
+      const PropertyGroupVector& property_groups = {});
+
+  /**
+   * @brief Create a NeighborArrowReader instance from graph info.
+   *
+   * @param graph_info The graph info that describes the graph.
+   * @param src_type The source vertex type.
+   * @param edge_type The edge type.
+   * @param dst_type The destination vertex type.
+   * @param adj_list_type The adj list type, ordered_by_source or
+   * ordered_by_dest.
+   * @param property_groups The property groups of the edges to gather along
+   * with the neighbors, default is empty.
+   */
+  static Result<std::shared_ptr<NeighborArrowReader>> Make(
+      const std::shared_ptr<GraphInfo>& graph_info, const std::string& src_type,
+      const std::string& edge_type, const std::string& dst_type,
+      AdjListType adj_list_type,
+      const PropertyGroupVector& property_groups = {});
+
+ private:
+  Result<std::shared_ptr<arrow::Table>> readAdjListChunk(
+      IdType vertex_chunk_index, IdType chunk_index) const;
+
+  Result<std::shared_ptr<arrow::Table>> readPropertyChunk(
+      size_t property_group_index, IdType vertex_chunk_index,
+      IdType chunk_index) const;
+
+ private:
+  std::shared_ptr<EdgeInfo> edge_info_;
+  AdjListType adj_list_type_;
+  std::string prefix_;
+  PropertyGroupVector property_groups_;
+  std::vector<std::shared_ptr<arrow::Schema>> schemas_;
+  std::shared_ptr<FileSystem> fs_;
+  std::shared_ptr<OffsetIndex> offset_index_;
 };
+
+/**
+ * @brief The cursor to scan the edges of an adjacency list chunk by chunk.
+ *
+ * Each position of the cursor is one edge chunk, whose source and
+ * destination ids are exposed as contiguous int64 arrays, so that a scan over
+ * the edges of the chunk is a pointer increment. The property columns of the
+ * chunk are loaded on the first GetProperties() call of the chunk.
+ */
+class EdgeChunkCursor {
+ public:
+  /**
+   * @brief Initialize the EdgeChunkCursor, positioned at the first edge chunk
+   * without loading it.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type for the edges.
+   * @param prefix The absolute prefix.
+   * @param property_groups The property groups to load along with the edges,
+   * default is empty.
+   */
+  EdgeChunkCursor(const std::shared_ptr<EdgeInfo>& edge_info,
+                  AdjListType adj_list_type, const std::string& prefix,
+                  const PropertyGroupVector& property_groups = {});
+
+  /**
+   * @brief Move the cursor to an edge chunk and load its ids.
+   *
+   * @param vertex_chunk_index The index of the vertex chunk.
+   * @param chunk_index The index of the edge chunk in the vertex chunk.
+   */
+  Status seek_chunk_index(IdType vertex_chunk_index, IdType chunk_index = 0);
+
+  /**
+   * @brief Move the cursor to the next edge chunk and load its ids, skipping
+   * the vertex chunks without edges. Returns IndexError after the last chunk.
+   */
+  Status next_chunk();
+
+  /** @brief Get the index of the vertex chunk of the current edge chunk. */
+  IdType GetVertexChunkIndex() const noexcept { return vertex_chunk_index_; }
+
+  /** @brief Get the index of the current edge chunk in its vertex chunk. */
+  IdType GetChunkIndex() const noexcept { return chunk_index_; }
+
+  /** @brief Get the number of edges of the current edge chunk. */
+  int64_t size() const noexcept { return num_rows_; }
+
+  /** @brief Get the source ids of the edges of the current edge chunk. */
+  const IdType* sources() const noexcept { return sources_; }
+
+  /** @brief Get the destination ids of the edges of the current edge chunk. */
+  const IdType* destinations() const noexcept { return destinations_; }
+
+  /**
+   * @brief Get the property columns of the current edge chunk, one arrow
+   * chunk per column and aligned with the ids. Returns nullptr if no property
+   * group is requested.
+   */
+  Result<std::shared_ptr<arrow::Table>> GetProperties();
+
+  /**
+   * @brief Create an EdgeChunkCursor instance from edge info.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type for the edges.
+   * @param prefix The absolute prefix of the graph.
+   * @param property_groups The property groups to load along with the edges,
+   * default is empty.
+   */
+  static Result<std::shared_ptr<EdgeChunkCursor>> Make(
+      const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+      const std::string& prefix,
+      const PropertyGroupVector& property_groups = {});
+
+  /**
+   * @brief Create an EdgeChunkCursor instance from graph info.
+   *
+   * @param graph_info The graph info that describes the graph.
+   * @param src_type The source vertex type.
+   * @param edge_type The edge type.
+   * @param dst_type The destination vertex type.
+   * @param adj_list_type The adj list type for the edges.
+   * @param property_groups The property groups to load along with the edges,
+   * default is empty.
+   */
+  static Result<std::shared_ptr<EdgeChunkCursor>> Make(
+      const std::shared_ptr<GraphInfo>& graph_info, const std::string& src_type,
+      const std::string& edge_type, const std::string& dst_type,
+      AdjListType adj_list_type,
+      const PropertyGroupVector& property_groups = {});
+
+ private:
+  Status load();
+
+ private:
+  AdjListArrowChunkReader adj_list_reader_;
+  std::vector<AdjListPropertyArrowChunkReader> property_readers_;
+  std::shared_ptr<const GraphCountIndex> count_index_;
+  IdType chunk_size_;
+  IdType vertex_chunk_index_, chunk_index_;
+  int64_t num_rows_;
+  std::shared_ptr<arrow::Int64Array> src_array_, dst_array_;
+  const IdType* sources_;
+  const IdType* destinations_;
+  std::shared_ptr<arrow::Table> properties_;
+};
+
+/**
+ * @brief Read a whole vertex property group into a single table.
+ *
+ * The chunks are read in parallel on the executor and concatenated in the
+ * order of the chunks, with the filter and projection of the options pushed
+ * down to each chunk.
+ *
+ * @param graph_info The graph info that describes the graph.
+ * @param type The vertex type.
+ * @param property_group The property group to read.
+ * @param options The filter options, default is empty.
+ * @param executor The executor to load the chunks on, the load executor of the
+ * context of the options by default. It can not be the executor that the
+ * files are read on, which the loads wait for.
+ */
+Result<std::shared_ptr<arrow::Table>> ReadVertexPropertyGroup(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& type,
+    const std::shared_ptr<PropertyGroup>& property_group,
+    const util::FilterOptions& options = {},
+    arrow::internal::Executor* executor = nullptr);
+
+/**
+ * @brief Stream a whole vertex property group in the order of the chunks.
+ *
+ * The chunks are read ahead in parallel on the executor, at most as many at a
+ * time as the capacity of the executor, so that the memory stays bounded.
+ *
+ * @param graph_info The graph info that describes the graph.
+ * @param type The vertex type.
+ * @param property_group The property group to read.
+ * @param options The filter options, default is empty.
+ * @param executor The executor to load the chunks on, the load executor of the
+ * context of the options by default. It can not be the executor that the
+ * files are read on, which the loads wait for.
+ */
+Result<std::shared_ptr<arrow::RecordBatchReader>> ReadVertexPropertyGroupStream(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& type,
+    const std::shared_ptr<PropertyGroup>& property_group,
+    const util::FilterOptions& options = {},
+    arrow::internal::Executor* executor = nullptr);
+
+/**
+ * @brief Read a whole adjacency list into a single table.
+ *
+ * The edge chunks of all the vertex chunks are read in parallel on the
+ * executor and concatenated in the order of the chunks, with the filter and
+ * projection of the options pushed down to each chunk.
+ *
+ * @param edge_info The edge info that describes the edge type.
+ * @param adj_list_type The adj list type for the edges.
+ * @param prefix The absolute prefix of the graph.
+ * @param options The filter options, default is empty.
+ * @param executor The executor to load the chunks on, the load executor of the
+ * context of the options by default. It can not be the executor that the
+ * files are read on, which the loads wait for.
+ */
+Result<std::shared_ptr<arrow::Table>> ReadAdjList(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const util::FilterOptions& options = {},
+    arrow::internal::Executor* executor = nullptr);
+
+/**
+ * @brief Stream a whole adjacency list in the order of the chunks.
+ *
+ * The chunks are read ahead in parallel on the executor, at most as many at a
+ * time as the capacity of the executor, so that the memory stays bounded.
+ *
+ * @param edge_info The edge info that describes the edge type.
+ * @param adj_list_type The adj list type for the edges.
+ * @param prefix The absolute prefix of the graph.
+ * @param options The filter options, default is empty.
+ * @param executor The executor to load the chunks on, the load executor of the
+ * context of the options by default. It can not be the executor that the
+ * files are read on, which the loads wait for.
+ */
+Result<std::shared_ptr<arrow::RecordBatchReader>> ReadAdjListStream(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const util::FilterOptions& options = {},
+    arrow::internal::Executor* executor = nullptr);
+
 }  // namespace graphar
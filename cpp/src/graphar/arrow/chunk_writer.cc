@@ -38,7 +38,10 @@
 #include "graphar/arrow/chunk_writer.h"
 #include "graphar/filesystem.h"
 #include "graphar/general_params.h"
+#include "graphar/graph_count_index.h"
 #include "graphar/graph_info.h"
+#include "graphar/label_summary.h"
+#include "graphar/offset_index.h"
 #include "graphar/result.h"
 #include "graphar/status.h"
 #include "graphar/types.h"
@@ -269,10 +272,21 @@ Status VertexPropertyWriter::WriteLabelChunk(
 
   GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto in_table,
                                        input_table->SelectColumns(indices));
+  // the summary row of the chunk would no longer match the rewritten chunk,
+  // so it is removed before
+  GAR_RETURN_NOT_OK(LabelSummary::Remove(fs_, prefix_, vertex_info_,
+                                         {chunk_index}, options_));
+  LabelSummary::Invalidate(prefix_, vertex_info_);
+  return writeLabelChunk(input_table, chunk_index);
+}
+
+Status VertexPropertyWriter::writeLabelChunk(
+    const std::shared_ptr<arrow::Table>& input_table,
+    IdType chunk_index) const {
   std::string suffix =
       vertex_info_->GetPrefix() + "labels/chunk" + std::to_string(chunk_index);
   std::string path = prefix_ + suffix;
-  return fs_->WriteLabelTableToFile(input_table, path);
+  return fs_->WriteLabelTableToFile(input_table, path, options_->getContext());
 }
 
 Status VertexPropertyWriter::WriteTable(
@@ -340,12 +354,27 @@ Status VertexPropertyWriter::WriteLabelTable(
   IdType chunk_size = vertex_info_->GetChunkSize();
   int64_t length = input_table->num_rows();
   IdType chunk_index = start_chunk_index;
+  std::vector<IdType> chunk_indices;
+  std::vector<std::shared_ptr<arrow::Table>> label_tables;
   for (int64_t offset = 0; offset < length;
        offset += chunk_size, chunk_index++) {
-    auto in_chunk = input_table->Slice(offset, chunk_size);
-    GAR_RETURN_NOT_OK(
-        WriteLabelChunk(in_chunk, chunk_index, file_type, validate_level));
+    chunk_indices.push_back(chunk_index);
+    label_tables.push_back(input_table->Slice(offset, chunk_size));
   }
+  // the summary rows of the chunks are removed at once before the chunks are
+  // rewritten
+  GAR_RETURN_NOT_OK(LabelSummary::Remove(fs_, prefix_, vertex_info_,
+                                         chunk_indices, options_));
+  LabelSummary::Invalidate(prefix_, vertex_info_);
+  for (size_t i = 0; i < chunk_indices.size(); ++i) {
+    GAR_RETURN_NOT_OK(writeLabelChunk(label_tables[i], chunk_indices[i]));
+  }
+  // the label counts of the written chunks, for the label filter to skip the
+  // chunks, the registered summary is dropped once the new one is written
+  GAR_RETURN_NOT_OK(LabelSummary::Write(fs_, prefix_, vertex_info_,
+                                        chunk_indices, label_tables,
+                                        options_));
+  LabelSummary::Invalidate(prefix_, vertex_info_);
   return Status::OK();
 }
 
@@ -716,7 +745,8 @@ Status EdgeChunkWriter::WriteEdgesNum(IdType vertex_chunk_index,
   GAR_ASSIGN_OR_RAISE(auto suffix, edge_info_->GetEdgesNumFilePath(
                                        vertex_chunk_index, adj_list_type_));
   std::string path = prefix_ + suffix;
-  return fs_->WriteValueToFile<IdType>(count, path);
+  GAR_RETURN_NOT_OK(fs_->WriteValueToFile<IdType>(count, path));
+  return removeCountManifest();
 }
 
 Status EdgeChunkWriter::WriteVerticesNum(const IdType& count,
@@ -725,7 +755,74 @@ Status EdgeChunkWriter::WriteVerticesNum(const IdType& count,
   GAR_ASSIGN_OR_RAISE(auto suffix,
                       edge_info_->GetVerticesNumFilePath(adj_list_type_));
   std::string path = prefix_ + suffix;
-  return fs_->WriteValueToFile<IdType>(count, path);
+  GAR_RETURN_NOT_OK(fs_->WriteValueToFile<IdType>(count, path));
+  OffsetIndex::Invalidate(prefix_, edge_info_, adj_list_type_);
+  return removeCountManifest();
+}
+
+Status EdgeChunkWriter::WriteCountManifest(
+    const std::vector<IdType>& edge_nums,
+    const std::vector<EdgeChunkIdRange>& id_ranges,
+    ValidateLevel validate_level) const {
+  GAR_RETURN_NOT_OK(validate(0, 0, validate_level));
+  if (!id_ranges.empty() && id_ranges.size() != edge_nums.size()) {
+    return Status::Invalid("The size of the id ranges ", id_ranges.size(),
+                           " does not match the number of vertex chunks ",
+                           edge_nums.size(), ".");
+  }
+  arrow::Int64Builder edge_num_builder;
+  RETURN_NOT_ARROW_OK(edge_num_builder.AppendValues(edge_nums));
+  std::shared_ptr<arrow::Array> edge_num_array;
+  RETURN_NOT_ARROW_OK(edge_num_builder.Finish(&edge_num_array));
+  std::vector<std::shared_ptr<arrow::Field>> fields = {
+      arrow::field(GeneralParams::kEdgeNumCol, arrow::int64(), false)};
+  std::vector<std::shared_ptr<arrow::Array>> arrays = {edge_num_array};
+  if (!id_ranges.empty()) {
+    // the ids of the empty vertex chunks are null
+    arrow::Int64Builder builders[4];
+    for (const auto& range : id_ranges) {
+      IdType ids[4] = {range.min_src, range.max_src, range.min_dst,
+                       range.max_dst};
+      for (int i = 0; i < 4; ++i) {
+        RETURN_NOT_ARROW_OK(range.empty() ? builders[i].AppendNull()
+                                          : builders[i].Append(ids[i]));
+      }
+    }
+    const char* names[4] = {
+        GeneralParams::kMinSrcIndexCol, GeneralParams::kMaxSrcIndexCol,
+        GeneralParams::kMinDstIndexCol, GeneralParams::kMaxDstIndexCol};
+    for (int i = 0; i < 4; ++i) {
+      std::shared_ptr<arrow::Array> array;
+      RETURN_NOT_ARROW_OK(builders[i].Finish(&array));
+      fields.push_back(arrow::field(names[i], arrow::int64()));
+      arrays.push_back(array);
+    }
+  }
+  auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+  GAR_ASSIGN_OR_RAISE(auto suffix,
+                      edge_info_->GetEdgesNumManifestFilePath(adj_list_type_));
+  std::string path = prefix_ + suffix;
+  GAR_RETURN_NOT_OK(
+      fs_->WriteTableToFile(table, FileType::PARQUET, path, options_));
+  // the writes after the manifest delete it again
+  count_manifest_removed_ = false;
+  GraphCountIndex::Invalidate(prefix_, edge_info_, adj_list_type_);
+  return Status::OK();
+}
+
+Status EdgeChunkWriter::removeCountManifest() const {
+  // the manifest is deleted by the first write only, not once per chunk
+  if (!count_manifest_removed_.exchange(true)) {
+    GAR_ASSIGN_OR_RAISE(
+        auto suffix, edge_info_->GetEdgesNumManifestFilePath(adj_list_type_));
+    auto status = fs_->DeleteFileIfExists(prefix_ + suffix);
+    if (!status.ok()) {
+      count_manifest_removed_ = false;
+      return status;
+    }
+  }
+  GraphCountIndex::Invalidate(prefix_, edge_info_, adj_list_type_);
+  return Status::OK();
 }
 
 Status EdgeChunkWriter::WriteOffsetChunk(
@@ -743,7 +840,9 @@ Status EdgeChunkWriter::WriteOffsetChunk(
   GAR_ASSIGN_OR_RAISE(auto suffix, edge_info_->GetAdjListOffsetFilePath(
                                        vertex_chunk_index, adj_list_type_));
   std::string path = prefix_ + suffix;
-  return fs_->WriteTableToFile(in_table, file_type, path, options_);
+  GAR_RETURN_NOT_OK(fs_->WriteTableToFile(in_table, file_type, path, options_));
+  OffsetIndex::Invalidate(prefix_, edge_info_, adj_list_type_);
+  return removeCountManifest();
 }
 
 Status EdgeChunkWriter::WriteAdjListChunk(
@@ -775,7 +874,9 @@ Status EdgeChunkWriter::WriteAdjListChunk(
       auto suffix, edge_info_->GetAdjListFilePath(vertex_chunk_index,
                                                   chunk_index, adj_list_type_));
   std::string path = prefix_ + suffix;
-  return fs_->WriteTableToFile(in_table, file_type, path, options_);
+  GAR_RETURN_NOT_OK(fs_->WriteTableToFile(in_table, file_type, path, options_));
+  // the id ranges of the manifest no longer bound the adjacency list
+  return removeCountManifest();
 }
 
 Status EdgeChunkWriter::WritePropertyChunk(
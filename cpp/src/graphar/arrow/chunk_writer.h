@@ -19,11 +19,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "graphar/fwd.h"
+#include "graphar/graph_count_index.h"
 #include "graphar/writer_util.h"
 
 // forward declaration
@@ -121,7 +123,9 @@ class VertexPropertyWriter {
 
   /**
    * @brief Write all labels of a single vertex chunk
-   * to corresponding files.
+   * to corresponding files. The chunk is read by the label filters
+   * until the label summary of the vertex type is written again by
+   * WriteLabelTable (see LabelSummary).
    *
    * @param input_table The table containing data.
    * @param chunk_index The index of the vertex chunk.
@@ -182,7 +186,8 @@ class VertexPropertyWriter {
 
   /**
    * @brief Write all labels for multiple vertex chunks
-   * to corresponding files.
+   * to corresponding files, together with the label summary
+   * of the chunks (see LabelSummary).
    *
    * @param input_table The table containing data.
    * @param start_chunk_index The start index of the vertex chunks.
@@ -263,6 +268,16 @@ class VertexPropertyWriter {
    */
   Status validate(const IdType& count, ValidateLevel validate_level) const;
 
+  /**
+   * @brief Write the file of a label chunk, without its label summary.
+   *
+   * @param input_table The labels of the vertex chunk.
+   * @param chunk_index The index of the vertex chunk.
+   * @return Status: ok or error.
+   */
+  Status writeLabelChunk(const std::shared_ptr<arrow::Table>& input_table,
+                         IdType chunk_index) const;
+
   /**
    * @brief Check if the operation of copying a file as a chunk is allowed.
    *
@@ -381,6 +396,25 @@ class EdgeChunkWriter {
       const IdType& count,
       ValidateLevel validate_level = ValidateLevel::default_validate) const;
 
+  /**
+   * @brief Write the count manifest of the adjacency list, which holds the
+   * number of edges of every vertex chunk in a single file so that readers
+   * load all the counts with one read instead of one read per vertex chunk.
+   * The later writes of the counts, the offsets or the adjacency list chunks
+   * delete the manifest, so it is written after them.
+   *
+   * @param edge_nums The number of edges of each vertex chunk.
+   * @param id_ranges The min/max source and destination ids of each vertex
+   * chunk, or empty to omit them from the manifest.
+   * @param validate_level The validate level for this operation,
+   * which is the writer's validate level by default.
+   * @return Status: ok or error.
+   */
+  Status WriteCountManifest(
+      const std::vector<IdType>& edge_nums,
+      const std::vector<EdgeChunkIdRange>& id_ranges = {},
+      ValidateLevel validate_level = ValidateLevel::default_validate) const;
+
   /**
    * @brief Validate and write the offset chunk for a vertex chunk.
    *
@@ -727,6 +761,16 @@ class EdgeChunkWriter {
    */
   static std::string getSortColumnName(AdjListType adj_list_type);
 
+  /**
+   * @brief Delete the count manifest after the counts or the adjacency list
+   * are written without it, so that the readers fall back to the count files
+   * instead of reading stale counts and id ranges. The manifest is deleted
+   * once per writer, on the first write after it is written.
+   *
+   * @return Status: ok or error.
+   */
+  Status removeCountManifest() const;
+
   /**
    * @brief Sort a table according to a specific column.
    *
@@ -747,6 +791,8 @@ class EdgeChunkWriter {
   std::shared_ptr<FileSystem> fs_;
   ValidateLevel validate_level_;
   std::shared_ptr<WriterOptions> options_;
+  // whether the count manifest is deleted since the writer last wrote it
+  mutable std::atomic<bool> count_manifest_removed_{false};
 };
 
 }  // namespace graphar
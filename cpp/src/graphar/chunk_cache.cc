@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <sstream>
+
+#include "arrow/api.h"
+#include "arrow/util/byte_size.h"
+
+#include "graphar/chunk_cache.h"
+#include "graphar/expression.h"
+
+namespace graphar {
+
+namespace {
+// the separator of the key components, which can not appear in a path
+constexpr char kKeySeparator = '\0';
+}  // namespace
+
+ChunkTableCache::ChunkTableCache(int64_t capacity)
+    : capacity_(capacity), size_(0), hits_(0), misses_(0), evictions_(0) {}
+
+ChunkTableCache& ChunkTableCache::Global() {
+  static ChunkTableCache cache;
+  return cache;
+}
+
+std::string ChunkTableCache::MakeKey(const std::string& path,
+                                     const std::vector<std::string>& columns,
+                                     const util::Filter& filter) {
+  std::ostringstream ss;
+  ss << path << kKeySeparator;
+  for (const auto& col : columns) {
+    ss << col << ',';
+  }
+  ss << kKeySeparator;
+  if (filter != nullptr) {
+    // the fingerprint is computed once per filter
+    auto maybe_fingerprint = GetFilterFingerprint(filter);
+    if (maybe_fingerprint.has_error()) {
+      return "";
+    }
+    ss << maybe_fingerprint.value();
+  }
+  return ss.str();
+}
+
+std::shared_ptr<arrow::Table> ChunkTableCache::Get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->table;
+}
+
+void ChunkTableCache::Put(const std::string& key, const std::string& path,
+                          const std::shared_ptr<arrow::Table>& table) {
+  if (key.empty() || table == nullptr) {
+    return;
+  }
+  int64_t size = arrow::util::TotalBufferSize(*table);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size > capacity_) {
+    return;
+  }
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    // another reader loaded the same chunk concurrently, keep the new table
+    size_ -= it->second->size;
+    it->second->table = table;
+    it->second->size = size;
+    size_ += size;
+    entries_.splice(entries_.begin(), entries_, it->second);
+  } else {
+    entries_.push_front(Entry{key, path, table, size});
+    index_[key] = entries_.begin();
+    size_ += size;
+  }
+  evictUntilFit(capacity_);
+}
+
+Result<std::shared_ptr<arrow::Table>> ChunkTableCache::GetOrLoad(
+    const std::string& key, const std::string& path, const Loader& loader) {
+  if (key.empty() || !IsEnabled()) {
+    return loader();
+  }
+  auto table = Get(key);
+  if (table != nullptr) {
+    return table;
+  }
+  GAR_ASSIGN_OR_RAISE(table, loader());
+  Put(key, path, table);
+  return table;
+}
+
+void ChunkTableCache::Invalidate(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->path == path) {
+      size_ -= it->size;
+      index_.erase(it->key);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ChunkTableCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  size_ = 0;
+}
+
+void ChunkTableCache::SetCapacity(int64_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity < 0 ? 0 : capacity;
+  evictUntilFit(capacity_);
+}
+
+int64_t ChunkTableCache::GetCapacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+bool ChunkTableCache::IsEnabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_ > 0;
+}
+
+ChunkTableCacheStats ChunkTableCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ChunkTableCacheStats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  stats.num_entries = static_cast<int64_t>(entries_.size());
+  stats.size_bytes = size_;
+  return stats;
+}
+
+void ChunkTableCache::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  hits_ = 0;
+  misses_ = 0;
+  evictions_ = 0;
+}
+
+void ChunkTableCache::evictUntilFit(int64_t capacity) {
+  while (size_ > capacity && !entries_.empty()) {
+    auto& victim = entries_.back();
+    size_ -= victim.size;
+    index_.erase(victim.key);
+    entries_.pop_back();
+    ++evictions_;
+  }
+}
+
+}  // namespace graphar
@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+
+// forward declaration
+namespace arrow {
+class Table;
+}  // namespace arrow
+
+namespace graphar {
+
+/**
+ * @brief The statistics of a ChunkTableCache.
+ */
+struct ChunkTableCacheStats {
+  /// The number of lookups served from the cache.
+  int64_t hits = 0;
+  /// The number of lookups that had to load the chunk.
+  int64_t misses = 0;
+  /// The number of entries dropped to stay within the capacity.
+  int64_t evictions = 0;
+  /// The number of entries currently held.
+  int64_t num_entries = 0;
+  /// The total buffer size in bytes of the entries currently held.
+  int64_t size_bytes = 0;
+};
+
+/**
+ * @brief A thread-safe, size-bounded LRU cache of decoded chunk tables.
+ *
+ * Entries are keyed by the chunk file path, the projected columns and a
+ * fingerprint of the pushed-down filter, so readers with different projections
+ * of the same file never observe each other's tables. The capacity is a memory
+ * budget in bytes measured with the total buffer size of the cached tables;
+ * a capacity of 0 disables the cache.
+ *
+ * The process-wide instance returned by Global() is shared by all the arrow
+ * chunk readers. It is disabled by default, call SetCapacity() to enable it.
+ */
+class ChunkTableCache {
+ public:
+  using Loader = std::function<Result<std::shared_ptr<arrow::Table>>()>;
+
+  /**
+   * @brief Initialize the cache.
+   *
+   * @param capacity The memory budget in bytes, 0 to disable the cache.
+   */
+  explicit ChunkTableCache(int64_t capacity = 0);
+
+  ChunkTableCache(const ChunkTableCache&) = delete;
+  ChunkTableCache& operator=(const ChunkTableCache&) = delete;
+
+  /** @brief Get the process-wide chunk table cache. */
+  static ChunkTableCache& Global();
+
+  /**
+   * @brief Build the cache key of a chunk.
+   *
+   * @param path The path of the chunk file.
+   * @param columns The projected columns, empty means all columns.
+   * @param filter The filter pushed down to the scan, nullptr means no filter.
+   * The filter is keyed by its fingerprint (see GetFilterFingerprint), so
+   * the filters of the same expression share the entries.
+   * @return The cache key, or an empty key that is never cached if the filter
+   * can not be evaluated.
+   */
+  static std::string MakeKey(const std::string& path,
+                             const std::vector<std::string>& columns,
+                             const util::Filter& filter = nullptr);
+
+  /**
+   * @brief Look up a table, the entry becomes the most recently used one.
+   *
+   * @param key The cache key built by MakeKey.
+   * @return The cached table, or nullptr if the key is not cached.
+   */
+  std::shared_ptr<arrow::Table> Get(const std::string& key);
+
+  /**
+   * @brief Insert a table, evicting the least recently used entries if the
+   * capacity is exceeded. Tables larger than the capacity are not cached.
+   *
+   * @param key The cache key built by MakeKey.
+   * @param path The path of the chunk file, used by Invalidate.
+   * @param table The table to cache.
+   */
+  void Put(const std::string& key, const std::string& path,
+           const std::shared_ptr<arrow::Table>& table);
+
+  /**
+   * @brief Look up a table, or load and insert it on a miss.
+   *
+   * The loader runs without holding the cache lock. A nullptr table returned
+   * by the loader, or the table of an empty key, is passed through and not
+   * cached.
+   *
+   * @param key The cache key built by MakeKey.
+   * @param path The path of the chunk file, used by Invalidate.
+   * @param loader The function to load the table on a miss.
+   * @return The cached or loaded table.
+   */
+  Result<std::shared_ptr<arrow::Table>> GetOrLoad(const std::string& key,
+                                                  const std::string& path,
+                                                  const Loader& loader);
+
+  /**
+   * @brief Drop all the entries of a chunk file, e.g., after it is rewritten.
+   *
+   * @param path The path of the chunk file.
+   */
+  void Invalidate(const std::string& path);
+
+  /** @brief Drop all the entries. */
+  void Clear();
+
+  /**
+   * @brief Set the memory budget in bytes, 0 to disable the cache. Entries
+   * are evicted immediately if the new capacity is exceeded.
+   */
+  void SetCapacity(int64_t capacity);
+
+  /** @brief Get the memory budget in bytes. */
+  int64_t GetCapacity() const;
+
+  /** @brief Whether the cache is enabled, i.e., the capacity is not 0. */
+  bool IsEnabled() const;
+
+  /** @brief Get a snapshot of the hit/miss/eviction counters. */
+  ChunkTableCacheStats GetStats() const;
+
+  /** @brief Reset the hit/miss/eviction counters. */
+  void ResetStats();
+
+ private:
+  struct Entry {
+    std::string key;
+    std::string path;
+    std::shared_ptr<arrow::Table> table;
+    int64_t size;
+  };
+
+  void evictUntilFit(int64_t capacity);
+
+  mutable std::mutex mutex_;
+  int64_t capacity_;
+  int64_t size_;
+  // the front is the most recently used entry
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  int64_t hits_;
+  int64_t misses_;
+  int64_t evictions_;
+};
+
+}  // namespace graphar
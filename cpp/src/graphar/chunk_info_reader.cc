@@ -22,6 +22,7 @@
 
 #include "graphar/chunk_info_reader.h"
 #include "graphar/filesystem.h"
+#include "graphar/graph_count_index.h"
 #include "graphar/graph_info.h"
 #include "graphar/reader_util.h"
 #include "graphar/result.h"
@@ -123,11 +124,10 @@ AdjListChunkInfoReader::AdjListChunkInfoReader(
                             edge_info->GetAdjListPathPrefix(adj_list_type));
   base_dir_ = prefix_ + adj_list_path_prefix;
   GAR_ASSIGN_OR_RAISE_ERROR(
-      vertex_chunk_num_,
-      util::GetVertexChunkNum(prefix_, edge_info_, adj_list_type_));
+      count_index_, GraphCountIndex::Get(prefix_, edge_info_, adj_list_type_));
+  vertex_chunk_num_ = count_index_->GetVertexChunkNum();
   GAR_ASSIGN_OR_RAISE_ERROR(
-      chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                        vertex_chunk_index_));
+      chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
 }
 
 Status AdjListChunkInfoReader::seek_src(IdType id) {
@@ -148,8 +148,7 @@ Status AdjListChunkInfoReader::seek_src(IdType id) {
   if (vertex_chunk_index_ != new_vertex_chunk_index) {
     vertex_chunk_index_ = new_vertex_chunk_index;
     GAR_ASSIGN_OR_RAISE(
-        chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                          vertex_chunk_index_));
+        chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   }
 
   if (adj_list_type_ == AdjListType::unordered_by_source) {
@@ -181,8 +180,7 @@ Status AdjListChunkInfoReader::seek_dst(IdType id) {
   if (vertex_chunk_index_ != new_vertex_chunk_index) {
     vertex_chunk_index_ = new_vertex_chunk_index;
     GAR_ASSIGN_OR_RAISE(
-        chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                          vertex_chunk_index_));
+        chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   }
 
   if (adj_list_type_ == AdjListType::unordered_by_dest) {
@@ -223,8 +221,7 @@ Status AdjListChunkInfoReader::next_chunk() {
     }
     chunk_index_ = 0;
     GAR_ASSIGN_OR_RAISE_ERROR(
-        chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                          vertex_chunk_index_));
+        chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   }
   return Status::OK();
 }
@@ -351,11 +348,10 @@ AdjListPropertyChunkInfoReader::AdjListPropertyChunkInfoReader(
       edge_info->GetPropertyGroupPathPrefix(property_group, adj_list_type));
   base_dir_ = prefix_ + pg_path_prefix;
   GAR_ASSIGN_OR_RAISE_ERROR(
-      vertex_chunk_num_,
-      util::GetVertexChunkNum(prefix_, edge_info_, adj_list_type_));
+      count_index_, GraphCountIndex::Get(prefix_, edge_info_, adj_list_type_));
+  vertex_chunk_num_ = count_index_->GetVertexChunkNum();
   GAR_ASSIGN_OR_RAISE_ERROR(
-      chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                        vertex_chunk_index_));
+      chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
 }
 
 Status AdjListPropertyChunkInfoReader::seek_src(IdType id) {
@@ -376,8 +372,7 @@ Status AdjListPropertyChunkInfoReader::seek_src(IdType id) {
   if (vertex_chunk_index_ != new_vertex_chunk_index) {
     vertex_chunk_index_ = new_vertex_chunk_index;
     GAR_ASSIGN_OR_RAISE(
-        chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                          vertex_chunk_index_));
+        chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   }
   if (adj_list_type_ == AdjListType::unordered_by_source) {
     return seek(0);  // start from first chunk
@@ -408,8 +403,7 @@ Status AdjListPropertyChunkInfoReader::seek_dst(IdType id) {
   if (vertex_chunk_index_ != new_vertex_chunk_index) {
     vertex_chunk_index_ = new_vertex_chunk_index;
     GAR_ASSIGN_OR_RAISE(
-        chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                          vertex_chunk_index_));
+        chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   }
 
   if (adj_list_type_ == AdjListType::unordered_by_dest) {
@@ -455,8 +449,7 @@ Status AdjListPropertyChunkInfoReader::next_chunk() {
     }
     chunk_index_ = 0;
     GAR_ASSIGN_OR_RAISE_ERROR(
-        chunk_num_, util::GetEdgeChunkNum(prefix_, edge_info_, adj_list_type_,
-                                          vertex_chunk_index_));
+        chunk_num_, count_index_->GetEdgeChunkNum(vertex_chunk_index_));
   }
   return Status::OK();
 }
@@ -200,6 +200,7 @@ class AdjListChunkInfoReader {
   IdType vertex_chunk_num_, chunk_num_;
   std::string base_dir_;  // the chunk files base dir
   std::shared_ptr<FileSystem> fs_;
+  std::shared_ptr<const GraphCountIndex> count_index_;
 };
 
 class AdjListOffsetChunkInfoReader {
@@ -382,5 +383,6 @@ class AdjListPropertyChunkInfoReader {
   IdType vertex_chunk_num_, chunk_num_;
   std::string base_dir_;  // the chunk files base dir
   std::shared_ptr<FileSystem> fs_;
+  std::shared_ptr<const GraphCountIndex> count_index_;
 };
 }  // namespace graphar
@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/util/future.h"
+#include "arrow/util/thread_pool.h"
+
+#include "graphar/chunk_prefetcher.h"
+#include "graphar/context.h"
+
+namespace graphar {
+
+struct ChunkPrefetcher::PendingLoad {
+  arrow::Future<std::shared_ptr<arrow::Table>> future;
+};
+
+ChunkPrefetcher::ChunkPrefetcher(int depth,
+                                 arrow::internal::Executor* executor)
+    : depth_(depth),
+      executor_(executor != nullptr
+                    ? executor
+                    : ExecutionContext::Default()->GetLoadExecutor()) {}
+
+void ChunkPrefetcher::Prefetch(const std::string& key, Loader loader) {
+  if (key.empty()) {
+    // the chunk of an empty key is not cached, nor taken by the key
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& pending : pending_) {
+    if (pending.first == key) {
+      return;
+    }
+  }
+  auto maybe_future = executor_->Submit(
+      [loader = std::move(loader)]()
+          -> arrow::Result<std::shared_ptr<arrow::Table>> {
+        auto maybe_table = loader();
+        if (maybe_table.has_error()) {
+          return arrow::Status::IOError(maybe_table.status().message());
+        }
+        return maybe_table.value();
+      });
+  if (!maybe_future.ok()) {
+    // the chunk is loaded synchronously by Take
+    return;
+  }
+  pending_.emplace_back(key, std::make_shared<PendingLoad>(PendingLoad{
+                                 maybe_future.MoveValueUnsafe()}));
+  while (pending_.size() > static_cast<size_t>(2 * depth_)) {
+    pending_.pop_front();
+  }
+}
+
+Result<std::shared_ptr<arrow::Table>> ChunkPrefetcher::Take(
+    const std::string& key, const Loader& loader) {
+  std::shared_ptr<PendingLoad> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+      if (it->first == key) {
+        pending = std::move(it->second);
+        pending_.erase(it);
+        break;
+      }
+    }
+  }
+  if (pending == nullptr) {
+    return loader();
+  }
+  // wait without holding the lock
+  const auto& result = pending->future.result();
+  if (!result.ok()) {
+    return loader();
+  }
+  return result.ValueUnsafe();
+}
+
+bool ChunkPrefetcher::IsPending(const std::string& key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& pending : pending_) {
+    if (pending.first == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ChunkPrefetcher::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_.clear();
+}
+
+}  // namespace graphar
@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "graphar/chunk_cache.h"
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+
+// forward declaration
+namespace arrow {
+class Table;
+namespace internal {
+class Executor;
+}  // namespace internal
+}  // namespace arrow
+
+namespace graphar {
+
+/**
+ * @brief The read-ahead of the chunks of a sequential scan.
+ *
+ * A reader hands the loaders of the chunks it is about to visit to
+ * Prefetch(), which runs them on the load executor of the reader's context,
+ * and collects the table with Take() when it gets there, so that the
+ * decoding of a chunk overlaps the IO of the following ones. Loads that are
+ * never taken, e.g., after the reader seeks elsewhere, are dropped once more
+ * than twice the depth of loads are pending.
+ */
+class ChunkPrefetcher {
+ public:
+  using Loader = ChunkTableCache::Loader;
+
+  /**
+   * @brief Initialize the prefetcher.
+   *
+   * @param depth The number of chunks to read ahead, must be positive.
+   * @param executor The executor to load the chunks on, the load executor of
+   * the default context if nullptr. It can not be the executor that the
+   * files are read on, which the loads wait for.
+   */
+  explicit ChunkPrefetcher(int depth,
+                           arrow::internal::Executor* executor = nullptr);
+
+  ChunkPrefetcher(const ChunkPrefetcher&) = delete;
+  ChunkPrefetcher& operator=(const ChunkPrefetcher&) = delete;
+
+  /** @brief Get the number of chunks to read ahead. */
+  int GetDepth() const noexcept { return depth_; }
+
+  /** @brief Get the executor that the chunks are loaded on. */
+  arrow::internal::Executor* GetExecutor() const noexcept { return executor_; }
+
+  /**
+   * @brief Start loading a chunk in the background, unless the chunk is
+   * already pending.
+   *
+   * @param key The cache key of the chunk built by ChunkTableCache::MakeKey.
+   * @param loader The function to load the chunk, it must not reference the
+   * state of the reader since it runs on another thread.
+   */
+  void Prefetch(const std::string& key, Loader loader);
+
+  /**
+   * @brief Get the table of a chunk, waiting for its pending load if any,
+   * otherwise loading it with the loader in the calling thread. A failed
+   * background load is retried in the calling thread to report its error.
+   *
+   * @param key The cache key of the chunk.
+   * @param loader The function to load the chunk if it is not pending.
+   */
+  Result<std::shared_ptr<arrow::Table>> Take(const std::string& key,
+                                             const Loader& loader);
+
+  /** @brief Whether the load of a chunk is pending, i.e., not taken yet. */
+  bool IsPending(const std::string& key) const;
+
+  /** @brief Drop all the pending loads. */
+  void Clear();
+
+ private:
+  struct PendingLoad;
+
+  int depth_;
+  arrow::internal::Executor* executor_;
+  mutable std::mutex mutex_;
+  // the pending loads in the order they are issued
+  std::list<std::pair<std::string, std::shared_ptr<PendingLoad>>> pending_;
+};
+
+}  // namespace graphar
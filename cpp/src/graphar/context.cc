@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "arrow/api.h"
+#include "arrow/io/interfaces.h"
+#include "arrow/util/thread_pool.h"
+
+#include "graphar/context.h"
+#include "graphar/parallel_load.h"
+#include "graphar/status.h"
+
+namespace graphar {
+
+ExecutionContext::ExecutionContext()
+    : ExecutionContext(nullptr, nullptr, nullptr) {}
+
+ExecutionContext::ExecutionContext(arrow::MemoryPool* pool,
+                                   arrow::internal::Executor* executor,
+                                   arrow::internal::Executor* load_executor)
+    : pool_(pool != nullptr ? pool : arrow::default_memory_pool()),
+      executor_(executor != nullptr
+                    ? executor
+                    : arrow::io::default_io_context().executor()),
+      load_executor_(load_executor != nullptr ? load_executor
+                                              : GetLoadThreadPool()),
+      io_context_(std::make_shared<arrow::io::IOContext>(pool_, executor_)) {}
+
+bool ExecutionContext::IsDefaultMemoryPool() const {
+  return pool_ == arrow::default_memory_pool();
+}
+
+const std::shared_ptr<ExecutionContext>& ExecutionContext::Default() {
+  static const auto context = std::make_shared<ExecutionContext>();
+  return context;
+}
+
+Status ParallelLoad(const ExecutionContext& context, int64_t num_loads,
+                    const std::function<Status(int64_t index)>& load) {
+  return ParallelLoad(context.GetLoadExecutor(), num_loads, load);
+}
+
+}  // namespace graphar
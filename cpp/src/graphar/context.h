@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "graphar/fwd.h"
+
+// forward declarations
+namespace arrow {
+class MemoryPool;
+}  // namespace arrow
+
+namespace arrow::internal {
+class Executor;
+}  // namespace arrow::internal
+
+namespace arrow::io {
+class IOContext;
+}  // namespace arrow::io
+
+namespace graphar {
+
+/**
+ * @brief The memory pool and the executor that reads and writes run with.
+ *
+ * The readers take the context in util::FilterOptions, and the writers and
+ * builders take it in WriterOptions. The arrow allocations of the chunks they
+ * read, cast and build are made from the memory pool of the context. A query
+ * can therefore cap and track its memory with its own pool, e.g., an
+ * arrow::ProxyMemoryPool or a jemalloc/mimalloc pool. The chunks read with a
+ * pool other than the default one are not kept in the process-wide
+ * ChunkTableCache, so that they are released together with the query.
+ */
+class ExecutionContext {
+ public:
+  /** @brief Create a context of the default memory pool and IO executor. */
+  ExecutionContext();
+
+  /**
+   * @brief Create a context.
+   *
+   * @param pool The memory pool to allocate from, the arrow default memory
+   * pool if nullptr.
+   * @param executor The executor of the file reads, the arrow IO thread pool
+   * if nullptr.
+   * @param load_executor The executor of the parallel chunk loads, the load
+   * thread pool (see GetLoadThreadPool) if nullptr. A load waits for its file
+   * reads on the executor of the reads, so it has to be another executor.
+   */
+  explicit ExecutionContext(arrow::MemoryPool* pool,
+                            arrow::internal::Executor* executor = nullptr,
+                            arrow::internal::Executor* load_executor = nullptr);
+
+  /** @brief Get the memory pool. */
+  arrow::MemoryPool* GetMemoryPool() const { return pool_; }
+
+  /** @brief Get the executor of the file reads. */
+  arrow::internal::Executor* GetExecutor() const { return executor_; }
+
+  /** @brief Get the executor of the parallel chunk loads. */
+  arrow::internal::Executor* GetLoadExecutor() const { return load_executor_; }
+
+  /** @brief Get the arrow IO context of the memory pool and the executor. */
+  const arrow::io::IOContext& GetIOContext() const { return *io_context_; }
+
+  /** @brief Whether the memory pool is the arrow default memory pool. */
+  bool IsDefaultMemoryPool() const;
+
+  /**
+   * @brief Set whether to memory-map the local files instead of reading them
+   * into buffers, the files of remote file systems are read as usual.
+   */
+  void SetUseMmap(bool use_mmap) { use_mmap_ = use_mmap; }
+
+  /** @brief Whether to memory-map the local files. */
+  bool UseMmap() const { return use_mmap_; }
+
+  /** @brief Get the context of the default memory pool and IO executor. */
+  static const std::shared_ptr<ExecutionContext>& Default();
+
+  /**
+   * @brief Get the context, or the default context if it is nullptr.
+   *
+   * @param context The context, can be nullptr.
+   */
+  static const ExecutionContext& OrDefault(
+      const std::shared_ptr<ExecutionContext>& context) {
+    return context != nullptr ? *context : *Default();
+  }
+
+ private:
+  arrow::MemoryPool* pool_;
+  arrow::internal::Executor* executor_;
+  arrow::internal::Executor* load_executor_;
+  std::shared_ptr<arrow::io::IOContext> io_context_;
+  bool use_mmap_ = false;
+};
+
+/**
+ * @brief Run loads in parallel on the load executor of a context and wait for
+ * all of them.
+ *
+ * @param context The context of the load executor.
+ * @param num_loads The number of loads.
+ * @param load The load of an index in [0, num_loads).
+ * @return The error of the first failed load, or OK.
+ */
+Status ParallelLoad(const ExecutionContext& context, int64_t num_loads,
+                    const std::function<Status(int64_t index)>& load);
+
+}  // namespace graphar
@@ -0,0 +1,384 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/array/concatenate.h"
+
+#include "graphar/context.h"
+#include "graphar/csr_graph.h"
+#include "graphar/filesystem.h"
+#include "graphar/general_params.h"
+#include "graphar/graph_count_index.h"
+#include "graphar/graph_info.h"
+#include "graphar/reader_util.h"
+#include "graphar/types.h"
+
+namespace graphar {
+
+namespace {
+// the requested properties of a property group, and their indices in the
+// requested properties
+struct PropertyColumns {
+  std::shared_ptr<PropertyGroup> property_group;
+  std::vector<std::string> names;
+  std::vector<size_t> indices;
+};
+
+// the arrays of each requested property of the edges of a vertex chunk
+using ChunkProperties = std::vector<arrow::ArrayVector>;
+
+// read an int64 column of a file
+Result<std::shared_ptr<arrow::ChunkedArray>> ReadInt64Column(
+    const std::shared_ptr<FileSystem>& fs, const std::string& path,
+    FileType file_type, const std::string& column_name,
+    const std::shared_ptr<ReadContext>& context) {
+  std::vector<std::string> columns = {column_name};
+  util::FilterOptions options;
+  options.columns = columns;
+  options.context = context;
+  GAR_ASSIGN_OR_RAISE(auto table,
+                      fs->ReadFileToTable(path, file_type, options));
+  auto column = table->GetColumnByName(column_name);
+  if (column == nullptr || column->type()->id() != arrow::Type::INT64) {
+    return Status::TypeError("The column ", column_name, " of ", path,
+                             " is not an int64 column.");
+  }
+  return column;
+}
+
+// copy the first length values of an int64 column, adding delta to each
+void CopyValues(const arrow::ChunkedArray& column, int64_t length,
+                IdType delta, IdType* out) {
+  for (const auto& chunk : column.chunks()) {
+    if (length <= 0) {
+      break;
+    }
+    const auto& array = static_cast<const arrow::Int64Array&>(*chunk);
+    int64_t num = std::min(length, array.length());
+    const int64_t* values = array.raw_values();
+    if (delta == 0) {
+      std::memcpy(out, values, num * sizeof(IdType));
+    } else {
+      for (int64_t i = 0; i < num; ++i) {
+        out[i] = values[i] + delta;
+      }
+    }
+    out += num;
+    length -= num;
+  }
+}
+
+IdType ValueAt(const arrow::ChunkedArray& column, int64_t index) {
+  for (const auto& chunk : column.chunks()) {
+    if (index < chunk->length()) {
+      return static_cast<const arrow::Int64Array&>(*chunk).Value(index);
+    }
+    index -= chunk->length();
+  }
+  return -1;
+}
+
+// Load the vertex chunks of an adjacency list into the CSR arrays, the
+// vertex chunks are written to disjoint ranges of the arrays.
+class CSRLoader {
+ public:
+  CSRLoader(std::shared_ptr<FileSystem> fs, std::string prefix,
+            std::shared_ptr<EdgeInfo> edge_info, AdjListType adj_list_type,
+            std::shared_ptr<const GraphCountIndex> count_index,
+            std::vector<PropertyColumns> properties,
+            std::shared_ptr<arrow::Buffer> offsets,
+            std::shared_ptr<arrow::Buffer> neighbors,
+            std::shared_ptr<ReadContext> context)
+      : fs_(std::move(fs)),
+        prefix_(std::move(prefix)),
+        edge_info_(std::move(edge_info)),
+        adj_list_type_(adj_list_type),
+        count_index_(std::move(count_index)),
+        properties_(std::move(properties)),
+        offsets_(std::move(offsets)),
+        neighbors_(std::move(neighbors)),
+        context_(std::move(context)) {
+    // the first edge of each vertex chunk
+    IdType edge_begin = 0;
+    for (IdType edge_num : count_index_->GetEdgeNums()) {
+      edge_begins_.push_back(edge_begin);
+      edge_begin += edge_num;
+    }
+    property_num_ = 0;
+    for (const auto& columns : properties_) {
+      property_num_ += columns.names.size();
+    }
+  }
+
+  Result<ChunkProperties> Load(IdType vertex_chunk_index) const {
+    const IdType vertex_chunk_size = count_index_->GetVertexChunkSize();
+    const IdType chunk_size = edge_info_->GetChunkSize();
+    const IdType vertex_begin = vertex_chunk_index * vertex_chunk_size;
+    const IdType vertex_end = std::min(vertex_begin + vertex_chunk_size,
+                                       count_index_->GetVertexNum());
+    const IdType edge_begin = edge_begins_[vertex_chunk_index];
+    const IdType edge_num = count_index_->GetEdgeNums()[vertex_chunk_index];
+    auto file_type = edge_info_->GetAdjacentList(adj_list_type_)->GetFileType();
+    auto* offsets = reinterpret_cast<IdType*>(offsets_->mutable_data());
+    auto* neighbors = reinterpret_cast<IdType*>(neighbors_->mutable_data());
+
+    // the offsets of the vertex chunk start from 0, shift them to the first
+    // edge of the vertex chunk
+    GAR_ASSIGN_OR_RAISE(auto offset_path,
+                        edge_info_->GetAdjListOffsetFilePath(
+                            vertex_chunk_index, adj_list_type_));
+    GAR_ASSIGN_OR_RAISE(auto offset_column,
+                        ReadInt64Column(fs_, prefix_ + offset_path, file_type,
+                                        GeneralParams::kOffsetCol, context_));
+    IdType vertex_num = std::max<IdType>(vertex_end - vertex_begin, 0);
+    if (offset_column->length() <= vertex_num ||
+        ValueAt(*offset_column, vertex_num) != edge_num) {
+      return Status::Invalid("The offset chunk ", vertex_chunk_index,
+                             " of edge ", edge_info_->GetEdgeType(),
+                             " does not match its ", vertex_num,
+                             " vertices and ", edge_num, " edges.");
+    }
+    CopyValues(*offset_column, vertex_num, edge_begin, offsets + vertex_begin);
+
+    const std::string neighbor_column =
+        adj_list_type_ == AdjListType::ordered_by_source
+            ? GeneralParams::kDstIndexCol
+            : GeneralParams::kSrcIndexCol;
+    ChunkProperties chunk_properties(property_num_);
+    IdType edge_chunk_num = (edge_num + chunk_size - 1) / chunk_size;
+    for (IdType i = 0; i < edge_chunk_num; ++i) {
+      IdType row_num = std::min(chunk_size, edge_num - i * chunk_size);
+      GAR_ASSIGN_OR_RAISE(auto adj_list_path,
+                          edge_info_->GetAdjListFilePath(vertex_chunk_index, i,
+                                                         adj_list_type_));
+      GAR_ASSIGN_OR_RAISE(auto column,
+                          ReadInt64Column(fs_, prefix_ + adj_list_path,
+                                          file_type, neighbor_column,
+                                          context_));
+      if (column->length() != row_num) {
+        return Status::Invalid("The edge chunk ", i, " of vertex chunk ",
+                               vertex_chunk_index, " has ", column->length(),
+                               " edges, expected ", row_num, ".");
+      }
+      CopyValues(*column, row_num, 0,
+                 neighbors + edge_begin + i * chunk_size);
+      GAR_RETURN_NOT_OK(
+          LoadProperties(vertex_chunk_index, i, row_num, &chunk_properties));
+    }
+    return chunk_properties;
+  }
+
+ private:
+  Status LoadProperties(IdType vertex_chunk_index, IdType chunk_index,
+                        IdType row_num,
+                        ChunkProperties* chunk_properties) const {
+    for (const auto& columns : properties_) {
+      GAR_ASSIGN_OR_RAISE(
+          auto path,
+          edge_info_->GetPropertyFilePath(columns.property_group,
+                                          adj_list_type_, vertex_chunk_index,
+                                          chunk_index));
+      std::vector<std::string> names = columns.names;
+      util::FilterOptions options;
+      options.columns = names;
+      options.context = context_;
+      GAR_ASSIGN_OR_RAISE(
+          auto table,
+          fs_->ReadFileToTable(prefix_ + path,
+                               columns.property_group->GetFileType(),
+                               options));
+      for (size_t i = 0; i < columns.names.size(); ++i) {
+        auto column = table->GetColumnByName(columns.names[i]);
+        if (column == nullptr || column->length() != row_num) {
+          return Status::Invalid("The property ", columns.names[i],
+                                 " of edge chunk ", chunk_index,
+                                 " of vertex chunk ", vertex_chunk_index,
+                                 " is missing or does not match the edges.");
+        }
+        auto& arrays = (*chunk_properties)[columns.indices[i]];
+        arrays.insert(arrays.end(), column->chunks().begin(),
+                      column->chunks().end());
+      }
+    }
+    return Status::OK();
+  }
+
+  std::shared_ptr<FileSystem> fs_;
+  std::string prefix_;
+  std::shared_ptr<EdgeInfo> edge_info_;
+  AdjListType adj_list_type_;
+  std::shared_ptr<const GraphCountIndex> count_index_;
+  std::vector<PropertyColumns> properties_;
+  size_t property_num_;
+  std::shared_ptr<arrow::Buffer> offsets_;
+  std::shared_ptr<arrow::Buffer> neighbors_;
+  std::shared_ptr<ReadContext> context_;
+  std::vector<IdType> edge_begins_;
+};
+}  // namespace
+
+Result<std::shared_ptr<arrow::Array>> CSRGraph::GetProperty(
+    const std::string& property_name) const {
+  auto it = properties_.find(property_name);
+  if (it == properties_.end()) {
+    return Status::KeyError("The property ", property_name,
+                            " is not loaded.");
+  }
+  return it->second;
+}
+
+int64_t CSRGraph::GetMemoryUsage() const {
+  return (vertex_num_ + 1 + edge_num_) * static_cast<int64_t>(sizeof(IdType));
+}
+
+Result<std::shared_ptr<CSRGraph>> CSRGraph::Make(
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    const std::string& prefix, const std::vector<std::string>& property_names,
+    const std::shared_ptr<ReadContext>& context) {
+  if (adj_list_type != AdjListType::ordered_by_source &&
+      adj_list_type != AdjListType::ordered_by_dest) {
+    return Status::Invalid(
+        "The adj list type has to be ordered_by_source or ordered_by_dest, but "
+        "got ",
+        std::string(AdjListTypeToString(adj_list_type)));
+  }
+  if (!edge_info->HasAdjacentListType(adj_list_type)) {
+    return Status::KeyError(
+        "The adjacent list type ", AdjListTypeToString(adj_list_type),
+        " doesn't exist in edge ", edge_info->GetEdgeType(), ".");
+  }
+  // group the properties by their property groups, to read each chunk of a
+  // property group once
+  std::vector<std::string> names;
+  std::vector<PropertyColumns> properties;
+  for (const auto& name : property_names) {
+    if (std::find(names.begin(), names.end(), name) != names.end()) {
+      continue;
+    }
+    auto property_group = edge_info->GetPropertyGroup(name);
+    if (property_group == nullptr) {
+      return Status::KeyError("Property ", name, " does not exist in the ",
+                              edge_info->GetEdgeType(), " edge info.");
+    }
+    auto it = std::find_if(properties.begin(), properties.end(),
+                           [&](const PropertyColumns& columns) {
+                             return columns.property_group == property_group;
+                           });
+    if (it == properties.end()) {
+      properties.push_back({property_group, {}, {}});
+      it = properties.end() - 1;
+    }
+    it->names.push_back(name);
+    it->indices.push_back(names.size());
+    names.push_back(name);
+  }
+
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(
+      auto count_index,
+      GraphCountIndex::Get(fs, out_prefix, edge_info, adj_list_type));
+  const IdType vertex_num = count_index->GetVertexNum();
+  const IdType edge_num = count_index->GetTotalEdgeNum();
+  const auto& read_context = ExecutionContext::OrDefault(context);
+  arrow::MemoryPool* pool = read_context.GetMemoryPool();
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto offsets_buffer,
+      arrow::AllocateBuffer((vertex_num + 1) * sizeof(IdType), pool));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto neighbors_buffer,
+      arrow::AllocateBuffer(edge_num * sizeof(IdType), pool));
+  std::shared_ptr<arrow::Buffer> offsets(std::move(offsets_buffer));
+  std::shared_ptr<arrow::Buffer> neighbors(std::move(neighbors_buffer));
+  CSRLoader loader(fs, out_prefix, edge_info, adj_list_type, count_index,
+                   std::move(properties), offsets, neighbors, context);
+
+  // the vertex chunks are independent, load them concurrently on the load
+  // executor, which waits for the file reads on the IO executor
+  const IdType vertex_chunk_num = count_index->GetVertexChunkNum();
+  std::vector<ChunkProperties> chunk_properties(vertex_chunk_num);
+  GAR_RETURN_NOT_OK(ParallelLoad(
+      read_context, vertex_chunk_num, [&](int64_t i) -> Status {
+        GAR_ASSIGN_OR_RAISE(chunk_properties[i], loader.Load(i));
+        return Status::OK();
+      }));
+  std::vector<arrow::ArrayVector> property_arrays(names.size());
+  for (auto& properties_of_chunk : chunk_properties) {
+    for (size_t j = 0; j < names.size(); ++j) {
+      auto& arrays = properties_of_chunk[j];
+      property_arrays[j].insert(property_arrays[j].end(), arrays.begin(),
+                                arrays.end());
+    }
+  }
+
+  // the vertices past the vertex chunks of the adjacency list have no edges
+  auto* offsets_data = reinterpret_cast<IdType*>(offsets->mutable_data());
+  IdType loaded_vertex_num =
+      std::min(vertex_num, count_index->GetVertexChunkNum() *
+                               count_index->GetVertexChunkSize());
+  std::fill(offsets_data + loaded_vertex_num, offsets_data + vertex_num + 1,
+            edge_num);
+
+  std::shared_ptr<CSRGraph> graph(new CSRGraph());
+  graph->adj_list_type_ = adj_list_type;
+  graph->vertex_num_ = vertex_num;
+  graph->edge_num_ = edge_num;
+  graph->offsets_ =
+      std::make_shared<arrow::Int64Array>(vertex_num + 1, offsets);
+  graph->neighbors_ = std::make_shared<arrow::Int64Array>(edge_num, neighbors);
+  graph->offsets_data_ = graph->offsets_->raw_values();
+  graph->neighbors_data_ = graph->neighbors_->raw_values();
+  for (size_t i = 0; i < names.size(); ++i) {
+    std::shared_ptr<arrow::Array> array;
+    if (property_arrays[i].size() == 1) {
+      array = property_arrays[i][0];
+    } else if (property_arrays[i].empty()) {
+      GAR_ASSIGN_OR_RAISE(auto type, edge_info->GetPropertyType(names[i]));
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          array,
+          arrow::MakeEmptyArray(DataType::DataTypeToArrowDataType(type)));
+    } else {
+      // combine the chunks so that the values are addressed by edge
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          array, arrow::Concatenate(property_arrays[i], pool));
+    }
+    graph->properties_.emplace(names[i], std::move(array));
+  }
+  return graph;
+}
+
+Result<std::shared_ptr<CSRGraph>> CSRGraph::Make(
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& src_type,
+    const std::string& edge_type, const std::string& dst_type,
+    AdjListType adj_list_type, const std::vector<std::string>& property_names,
+    const std::shared_ptr<ReadContext>& context) {
+  auto edge_info = graph_info->GetEdgeInfo(src_type, edge_type, dst_type);
+  if (!edge_info) {
+    return Status::KeyError("The edge ", src_type, " ", edge_type, " ",
+                            dst_type, " doesn't exist.");
+  }
+  return Make(edge_info, adj_list_type, graph_info->GetPrefix(),
+              property_names, context);
+}
+
+}  // namespace graphar
@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+
+// forward declaration
+namespace arrow {
+class Array;
+class Int64Array;
+}  // namespace arrow
+
+namespace graphar {
+
+/**
+ * @brief An ordered adjacency list materialized in memory in CSR layout.
+ *
+ * The neighbors of vertex v are neighbors()[offsets()[v], offsets()[v + 1]),
+ * the destinations of its outgoing edges if the adjacency list is
+ * ordered_by_source (CSR), or the sources of its incoming edges if it is
+ * ordered_by_dest (CSC). The offset chunk and the neighbor column of the
+ * edge chunks of each vertex chunk are copied in bulk into the two arrays,
+ * the vertex chunks are loaded in parallel through ParallelLoad on the load
+ * executor of the context.
+ */
+class CSRGraph {
+ public:
+  /** @brief Get the number of vertices. */
+  IdType GetVertexNum() const { return vertex_num_; }
+
+  /** @brief Get the number of edges. */
+  IdType GetEdgeNum() const { return edge_num_; }
+
+  /** @brief Get the adj list type, ordered_by_source or ordered_by_dest. */
+  AdjListType GetAdjListType() const { return adj_list_type_; }
+
+  /** @brief The offsets of the vertices, of vertex num plus one entries. */
+  const IdType* offsets() const noexcept { return offsets_data_; }
+
+  /** @brief The internal ids of the neighbors, of edge num entries. */
+  const IdType* neighbors() const noexcept { return neighbors_data_; }
+
+  /** @brief Get the degree of a vertex, the id has to be in range. */
+  IdType GetDegree(IdType vid) const noexcept {
+    return offsets_data_[vid + 1] - offsets_data_[vid];
+  }
+
+  /** @brief Get the offsets as an arrow array. */
+  const std::shared_ptr<arrow::Int64Array>& GetOffsetArray() const {
+    return offsets_;
+  }
+
+  /** @brief Get the neighbors as an arrow array. */
+  const std::shared_ptr<arrow::Int64Array>& GetNeighborArray() const {
+    return neighbors_;
+  }
+
+  /** @brief Whether a property of the edges is loaded. */
+  bool HasProperty(const std::string& property_name) const {
+    return properties_.find(property_name) != properties_.end();
+  }
+
+  /**
+   * @brief Get the values of a loaded property of the edges, the i-th value
+   * is of the edge to the i-th neighbor.
+   *
+   * @param property_name The property name.
+   * @return The values, or KeyError if the property is not loaded.
+   */
+  Result<std::shared_ptr<arrow::Array>> GetProperty(
+      const std::string& property_name) const;
+
+  /** @brief Get the size in bytes of the offsets and the neighbors. */
+  int64_t GetMemoryUsage() const;
+
+  /**
+   * @brief Load an ordered adjacency list into memory.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type, ordered_by_source to load the
+   * outgoing edges or ordered_by_dest to load the incoming edges.
+   * @param prefix The absolute prefix of the graph.
+   * @param property_names The properties of the edges to load along with the
+   * neighbors, default is empty.
+   * @param context The context to read with, whose memory pool the arrays are
+   * allocated from and whose load executor the vertex chunks are loaded on,
+   * the default context if nullptr.
+   * @return The loaded graph, or error if any chunk fails to be read or does
+   * not match the edge counts.
+   */
+  static Result<std::shared_ptr<CSRGraph>> Make(
+      const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+      const std::string& prefix,
+      const std::vector<std::string>& property_names = {},
+      const std::shared_ptr<ReadContext>& context = nullptr);
+
+  /**
+   * @brief Load an ordered adjacency list into memory.
+   *
+   * @param graph_info The graph info that describes the graph.
+   * @param src_type The source vertex type.
+   * @param edge_type The edge type.
+   * @param dst_type The destination vertex type.
+   * @param adj_list_type The adj list type, ordered_by_source or
+   * ordered_by_dest.
+   * @param property_names The properties of the edges to load along with the
+   * neighbors, default is empty.
+   * @param context The context to read with, the default context if nullptr.
+   */
+  static Result<std::shared_ptr<CSRGraph>> Make(
+      const std::shared_ptr<GraphInfo>& graph_info, const std::string& src_type,
+      const std::string& edge_type, const std::string& dst_type,
+      AdjListType adj_list_type,
+      const std::vector<std::string>& property_names = {},
+      const std::shared_ptr<ReadContext>& context = nullptr);
+
+ private:
+  CSRGraph() = default;
+
+  AdjListType adj_list_type_;
+  IdType vertex_num_ = 0;
+  IdType edge_num_ = 0;
+  std::shared_ptr<arrow::Int64Array> offsets_;
+  std::shared_ptr<arrow::Int64Array> neighbors_;
+  const IdType* offsets_data_ = nullptr;
+  const IdType* neighbors_data_ = nullptr;
+  std::unordered_map<std::string, std::shared_ptr<arrow::Array>> properties_;
+};
+
+}  // namespace graphar
@@ -17,11 +17,62 @@
  * under the License.
  */
 
+#include <map>
+#include <mutex>
+
 #include "graphar/expression.h"
 #include "graphar/result.h"
 
 namespace graphar {
 
+namespace {
+// a filter evaluated as an arrow expression, and the string of the expression
+struct EvaluatedFilter {
+  ArrowExpression expression;
+  std::string fingerprint;
+};
+
+std::mutex evaluated_filters_mutex;
+// the evaluated filters, kept while the filters are alive
+std::map<std::weak_ptr<Expression>, std::shared_ptr<const EvaluatedFilter>,
+         std::owner_less<std::weak_ptr<Expression>>>
+    evaluated_filters;
+
+Result<std::shared_ptr<const EvaluatedFilter>> GetEvaluatedFilter(
+    const std::shared_ptr<Expression>& filter) {
+  {
+    std::lock_guard<std::mutex> lock(evaluated_filters_mutex);
+    auto it = evaluated_filters.find(filter);
+    if (it != evaluated_filters.end()) {
+      return it->second;
+    }
+  }
+  GAR_ASSIGN_OR_RAISE(auto expression, filter->Evaluate());
+  auto evaluated = std::make_shared<const EvaluatedFilter>(
+      EvaluatedFilter{expression, expression.ToString()});
+  std::lock_guard<std::mutex> lock(evaluated_filters_mutex);
+  if (evaluated_filters.size() >= 64) {
+    // drop the entries of the released filters
+    for (auto it = evaluated_filters.begin(); it != evaluated_filters.end();) {
+      it = it->first.expired() ? evaluated_filters.erase(it) : std::next(it);
+    }
+  }
+  return evaluated_filters.emplace(filter, evaluated).first->second;
+}
+}  // namespace
+
+Result<ArrowExpression> EvaluateFilter(
+    const std::shared_ptr<Expression>& filter) {
+  GAR_ASSIGN_OR_RAISE(auto evaluated, GetEvaluatedFilter(filter));
+  return evaluated->expression;
+}
+
+Result<std::string> GetFilterFingerprint(
+    const std::shared_ptr<Expression>& filter) {
+  GAR_ASSIGN_OR_RAISE(auto evaluated, GetEvaluatedFilter(filter));
+  return evaluated->fingerprint;
+}
+
 Result<ArrowExpression> ExpressionProperty::Evaluate() {
   return arrow::compute::field_ref(property_.name);
 }
@@ -286,6 +286,28 @@ class ExpressionOr : public ExpressionBinaryOp {
   Result<ArrowExpression> Evaluate() override;
 };
 
+/**
+ * @brief Evaluate a filter as arrow::compute::Expression. The expression is
+ * kept while the filter is alive, so that a filter applied to many chunks is
+ * evaluated once.
+ *
+ * @param filter The filter, not nullptr.
+ * @return The arrow::compute::Expression instance
+ */
+Result<ArrowExpression> EvaluateFilter(
+    const std::shared_ptr<Expression>& filter);
+
+/**
+ * @brief Get the fingerprint of a filter, the string of its evaluated
+ * expression, which is computed once while the filter is alive. The filters
+ * of the same expression have the same fingerprint.
+ *
+ * @param filter The filter, not nullptr.
+ * @return The fingerprint, or the error of evaluating the filter.
+ */
+Result<std::string> GetFilterFingerprint(
+    const std::shared_ptr<Expression>& filter);
+
 /**
  * Helper functions to construct a Expression.
  */
@@ -17,7 +17,11 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "graphar/writer_util.h"
 #ifdef ARROW_ORC
 #include "arrow/adapters/orc/adapter.h"
@@ -31,170 +35,315 @@
 #endif
 #include "arrow/filesystem/api.h"
 #include "arrow/filesystem/s3fs.h"
+#include "arrow/io/file.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
 #include "arrow/ipc/writer.h"
 #include "parquet/arrow/writer.h"
 #include "simple-uri-parser/uri_parser.h"
 
+#include "graphar/chunk_cache.h"
 #include "graphar/expression.h"
 #include "graphar/filesystem.h"
 #include "graphar/fwd.h"
 #include "graphar/general_params.h"
 
-namespace graphar::detail {
-template <typename U, typename T>
-static Status CastToLargeOffsetArray(
-    const std::shared_ptr<arrow::Array>& in,
-    const std::shared_ptr<arrow::DataType>& to_type,
-    std::shared_ptr<arrow::Array>& out) {  // NOLINT(runtime/references)
-  auto array_data = in->data()->Copy();
-  auto offset = array_data->buffers[1];
-  using from_offset_type = typename U::offset_type;
-  using to_string_offset_type = typename T::offset_type;
-  auto raw_value_offsets_ =
-      offset == NULLPTR
-          ? NULLPTR
-          : reinterpret_cast<const from_offset_type*>(offset->data());
-  std::vector<to_string_offset_type> to_offset(offset->size() /
-                                               sizeof(from_offset_type));
-  for (size_t i = 0; i < to_offset.size(); ++i) {
-    to_offset[i] = raw_value_offsets_[i];
-  }
-  std::shared_ptr<arrow::Buffer> buffer;
-  arrow::TypedBufferBuilder<to_string_offset_type> buffer_builder;
-  RETURN_NOT_ARROW_OK(
-      buffer_builder.Append(to_offset.data(), to_offset.size()));
-  RETURN_NOT_ARROW_OK(buffer_builder.Finish(&buffer));
-  array_data->type = to_type;
-  array_data->buffers[1] = buffer;
-  out = arrow::MakeArray(array_data);
-  RETURN_NOT_ARROW_OK(out->ValidateFull());
-  return Status::OK();
-}
-
-template <typename U, typename T>
-static Status CastToLargeOffsetArray(
-    const std::shared_ptr<arrow::ChunkedArray>& in,
-    const std::shared_ptr<arrow::DataType>& to_type,
-    std::shared_ptr<arrow::ChunkedArray>& out) {  // NOLINT(runtime/references)
-  std::vector<std::shared_ptr<arrow::Array>> chunks;
-  for (auto const& chunk : in->chunks()) {
-    std::shared_ptr<arrow::Array> array;
-    auto status = CastToLargeOffsetArray<U, T>(chunk, to_type, array);
-    GAR_RETURN_NOT_OK(status);
-    chunks.emplace_back(array);
-  }
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(out, arrow::ChunkedArray::Make(chunks));
-  return Status::OK();
-}
-}  // namespace graphar::detail
-
 namespace graphar {
 namespace ds = arrow::dataset;
 
 std::shared_ptr<ds::FileFormat> FileSystem::GetFileFormat(
     const FileType type) const {
+  // the formats hold no state of a file, share one instance per file type
   switch (type) {
-  case CSV:
-    return std::make_shared<ds::CsvFileFormat>();
-  case PARQUET:
-    return std::make_shared<ds::ParquetFileFormat>();
-  case JSON:
-    return std::make_shared<ds::JsonFileFormat>();
+  case CSV: {
+    static const auto format = std::make_shared<ds::CsvFileFormat>();
+    return format;
+  }
+  case PARQUET: {
+    static const auto format = std::make_shared<ds::ParquetFileFormat>();
+    return format;
+  }
+  case JSON: {
+    static const auto format = std::make_shared<ds::JsonFileFormat>();
+    return format;
+  }
+  case IPC: {
+    static const auto format = std::make_shared<ds::IpcFileFormat>();
+    return format;
+  }
 #ifdef ARROW_ORC
-  case ORC:
-    return std::make_shared<ds::OrcFileFormat>();
+  case ORC: {
+    static const auto format = std::make_shared<ds::OrcFileFormat>();
+    return format;
+  }
 #endif
   default:
     return nullptr;
   }
 }
 
+bool FileSystem::UseMmap(const std::shared_ptr<ReadContext>& context) const {
+  return context != nullptr && context->UseMmap() &&
+         arrow_fs_->type_name() == "local";
+}
+
+Result<std::shared_ptr<arrow::io::RandomAccessFile>> FileSystem::OpenInputFile(
+    const std::string& path,
+    const std::shared_ptr<ReadContext>& context) const {
+  if (UseMmap(context)) {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto file,
+        arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ));
+    return file;
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto file,
+                                       arrow_fs_->OpenInputFile(path));
+  return file;
+}
+
+namespace {
+// read the column names from the header line of a csv file, the input is
+// left at the start of the file
+Result<std::vector<std::string>> ReadCsvColumnNames(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& input,
+    const arrow::io::IOContext& io_context) {
+  constexpr int64_t kHeaderReadSize = 64 * 1024;
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto size, input->GetSize());
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto buffer, input->ReadAt(0, std::min(size, kHeaderReadSize)));
+  RETURN_NOT_ARROW_OK(input->Seek(0));
+  const void* end = std::memchr(buffer->data(), '\n', buffer->size());
+  if (end != nullptr) {
+    buffer = arrow::SliceBuffer(
+        buffer, static_cast<const uint8_t*>(end) - buffer->data() + 1);
+  }
+  // parse the header alone, so that the quoted names are unescaped
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto reader,
+      arrow::csv::TableReader::Make(
+          io_context, std::make_shared<arrow::io::BufferReader>(buffer),
+          arrow::csv::ReadOptions::Defaults(),
+          arrow::csv::ParseOptions::Defaults(),
+          arrow::csv::ConvertOptions::Defaults()));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto header, reader->Read());
+  return header->ColumnNames();
+}
+}  // namespace
+
 Result<std::shared_ptr<arrow::Table>> FileSystem::ReadFileToTable(
     const std::string& path, FileType file_type,
-    const std::vector<int>& column_indices) const noexcept {
-  parquet::arrow::FileReaderBuilder builder;
-  auto open_file_status = builder.OpenFile(path);
-  if (!open_file_status.ok()) {
+    const std::vector<int>& column_indices,
+    const std::shared_ptr<ReadContext>& context) const noexcept {
+  const auto& read_context = ExecutionContext::OrDefault(context);
+  if (file_type == FileType::JSON) {
+    // no projecting reader for json, project the scanned table instead
+    util::FilterOptions options;
+    options.context = context;
+    GAR_ASSIGN_OR_RAISE(auto table, ReadFileToTable(path, file_type, options));
+    if (column_indices.empty()) {
+      return table;
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table,
+                                         table->SelectColumns(column_indices));
+    return table;
+  }
+  // open the file through the wrapped filesystem, so that remote files are
+  // read with ranged reads
+  auto maybe_input = OpenInputFile(path, context);
+  if (maybe_input.has_error()) {
     return Status::Invalid("Failed to open file: ", path, " - ",
-                           open_file_status.ToString());
+                           maybe_input.status().message());
   }
-  builder.memory_pool(arrow::default_memory_pool());
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto reader, builder.Build());
+  auto input = maybe_input.value();
   std::shared_ptr<arrow::Table> table;
-  if (column_indices.empty()) {
-    arrow::Status read_status = reader->ReadTable(&table);
+  switch (file_type) {
+  case FileType::PARQUET: {
+    // pre-buffer the column chunks of the projection with coalesced reads
+    parquet::ArrowReaderProperties arrow_properties;
+    arrow_properties.set_pre_buffer(true);
+    arrow_properties.set_cache_options(arrow::io::CacheOptions::LazyDefaults());
+    arrow_properties.set_io_context(read_context.GetIOContext());
+    parquet::arrow::FileReaderBuilder builder;
+    RETURN_NOT_ARROW_OK(builder.Open(input));
+    builder.memory_pool(read_context.GetMemoryPool())
+        ->properties(arrow_properties);
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto reader, builder.Build());
+    arrow::Status read_status = column_indices.empty()
+                                    ? reader->ReadTable(&table)
+                                    : reader->ReadTable(column_indices, &table);
     if (!read_status.ok()) {
       return Status::Invalid("Failed to read table from file: ", path, " - ",
                              read_status.ToString());
     }
-  } else {
-    arrow::Status read_status = reader->ReadTable(column_indices, &table);
-    if (!read_status.ok()) {
-      return Status::Invalid("Failed to read table from file: ", path, " - ",
-                             read_status.ToString());
+    break;
+  }
+#ifdef ARROW_ORC
+  case FileType::ORC: {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto reader, arrow::adapters::orc::ORCFileReader::Open(
+                         input, read_context.GetMemoryPool()));
+    if (column_indices.empty()) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table, reader->Read());
+    } else {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table, reader->Read(column_indices));
     }
+    break;
+  }
+#endif
+  case FileType::IPC: {
+    // the record batches are slices of the read buffers unless the file is
+    // compressed, so the read of a memory-mapped file copies no bytes
+    auto ipc_options = arrow::ipc::IpcReadOptions::Defaults();
+    ipc_options.memory_pool = read_context.GetMemoryPool();
+    ipc_options.included_fields = column_indices;
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto reader,
+        arrow::ipc::RecordBatchFileReader::Open(input, ipc_options));
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches(
+        reader->num_record_batches());
+    for (int i = 0; i < reader->num_record_batches(); ++i) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(batches[i],
+                                           reader->ReadRecordBatch(i));
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        table, arrow::Table::FromRecordBatches(reader->schema(), batches));
+    break;
+  }
+  case FileType::CSV: {
+    // csv has no column layout to project on, name the projected columns
+    // from the header so that the table reader converts only those
+    auto convert_options = arrow::csv::ConvertOptions::Defaults();
+    if (!column_indices.empty()) {
+      GAR_ASSIGN_OR_RAISE(
+          auto names, ReadCsvColumnNames(input, read_context.GetIOContext()));
+      for (int index : column_indices) {
+        if (index < 0 || index >= static_cast<int>(names.size())) {
+          return Status::IndexError("Column index ", index,
+                                    " is out-of-bounds for file: ", path);
+        }
+        convert_options.include_columns.push_back(names[index]);
+      }
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto reader,
+        arrow::csv::TableReader::Make(read_context.GetIOContext(), input,
+                                      arrow::csv::ReadOptions::Defaults(),
+                                      arrow::csv::ParseOptions::Defaults(),
+                                      convert_options));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table, reader->Read());
+    break;
+  }
+  default:
+    return Status::Invalid("Unsupported file type: ",
+                           FileTypeToString(file_type), " for reading.");
   }
   return table;
 }
 
-Result<std::shared_ptr<arrow::Table>> FileSystem::ReadFileToTable(
-    const std::string& path, FileType file_type,
-    const util::FilterOptions& options) const noexcept {
-  std::shared_ptr<ds::FileFormat> format = GetFileFormat(file_type);
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      auto factory, arrow::dataset::FileSystemDatasetFactory::Make(
-                        arrow_fs_, {path}, format,
-                        arrow::dataset::FileSystemFactoryOptions()));
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto dataset, factory->Finish());
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto scan_builder, dataset->NewScan());
+namespace {
+std::mutex bound_scan_options_mutex;
+// the scan options with the filter and the projection bound to a schema,
+// keyed by the schema, the filter fingerprint and the projected columns
+std::unordered_map<std::string, std::shared_ptr<const ds::ScanOptions>>
+    bound_scan_options;
 
+// get the scan options of the filter options bound to the physical schema of
+// a chunk file. The chunks of a property group share the schema, so the
+// filter and the projection are bound once rather than once per chunk.
+Result<std::shared_ptr<const ds::ScanOptions>> GetBoundScanOptions(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const util::FilterOptions& options) {
+  std::string key = schema->ToString();
+  key.push_back('\0');
+  if (options.filter) {
+    GAR_ASSIGN_OR_RAISE(auto fingerprint,
+                        GetFilterFingerprint(options.filter));
+    key += fingerprint;
+  }
+  if (options.columns) {
+    for (const auto& column : *options.columns) {
+      key.push_back('\0');
+      key += column;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(bound_scan_options_mutex);
+    auto it = bound_scan_options.find(key);
+    if (it != bound_scan_options.end()) {
+      return it->second;
+    }
+  }
+  auto dataset = std::make_shared<ds::FragmentDataset>(schema,
+                                                       ds::FragmentVector{});
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto scan_builder, dataset->NewScan());
   // Apply the row filter and select the specified columns
   if (options.filter) {
-    GAR_ASSIGN_OR_RAISE(auto filter, options.filter->Evaluate());
+    GAR_ASSIGN_OR_RAISE(auto filter, EvaluateFilter(options.filter));
     RETURN_NOT_ARROW_OK(scan_builder->Filter(filter));
   }
   if (options.columns) {
     RETURN_NOT_ARROW_OK(scan_builder->Project(*options.columns));
   }
+  // binds the default projection of all columns if none is specified
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto scan_options,
+                                       scan_builder->GetScanOptions());
+  std::shared_ptr<const ds::ScanOptions> bound = scan_options;
+  std::lock_guard<std::mutex> lock(bound_scan_options_mutex);
+  if (bound_scan_options.size() >= 256) {
+    bound_scan_options.clear();
+  }
+  return bound_scan_options.emplace(key, bound).first->second;
+}
+}  // namespace
 
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto scanner, scan_builder->Finish());
+Result<std::shared_ptr<arrow::Table>> FileSystem::ReadFileToTable(
+    const std::string& path, FileType file_type,
+    const util::FilterOptions& options) const noexcept {
+  std::shared_ptr<ds::FileFormat> format = GetFileFormat(file_type);
+  if (format == nullptr) {
+    return Status::Invalid("Unsupported file type: ",
+                           FileTypeToString(file_type), " for reading.");
+  }
+  // scan the single file as a fragment, which skips the listing and the
+  // inspection of a dataset factory. The parquet fragment keeps the footer
+  // read for the schema and prunes the row groups by the filter statistics.
+  ds::FileSource source(path, arrow_fs_);
+  if (UseMmap(options.context)) {
+    GAR_ASSIGN_OR_RAISE(auto input, OpenInputFile(path, options.context));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto size, input->GetSize());
+    // the buffer is a slice of the mapping, no bytes are copied
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto buffer, input->ReadAt(0, size));
+    source = ds::FileSource(buffer);
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto fragment,
+                                       format->MakeFragment(source));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto schema,
+                                       fragment->ReadPhysicalSchema());
+  GAR_ASSIGN_OR_RAISE(auto bound_options, GetBoundScanOptions(schema, options));
+  const auto& read_context = ExecutionContext::OrDefault(options.context);
+  // the builder writes the dataset schema to the options, scan a copy
+  auto scan_options = std::make_shared<ds::ScanOptions>(*bound_options);
+  scan_options->pool = read_context.GetMemoryPool();
+  ds::ScannerBuilder scan_builder(schema, fragment, scan_options);
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto scanner, scan_builder.Finish());
   GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto table, scanner->ToTable());
-  // cast string array to large string array as we need concatenate chunks in
-  // some places, e.g., in vineyard
+  if (!options.large_string_offsets) {
+    return table;
+  }
+  // widen string array to large string array as we need concatenate chunks
+  // in some places, e.g., in vineyard
   for (int i = 0; i < table->num_columns(); ++i) {
-    std::shared_ptr<arrow::DataType> type = table->column(i)->type();
-    if (type->id() == arrow::Type::STRING) {
-      type = arrow::large_utf8();
-    } else if (type->id() == arrow::Type::BINARY) {
-      type = arrow::large_binary();
-    }
-    if (type->Equals(table->column(i)->type())) {
+    auto type_id = table->column(i)->type()->id();
+    if (type_id != arrow::Type::STRING && type_id != arrow::Type::BINARY) {
       continue;
     }
-    // do casting
-    auto field = table->field(i)->WithType(type);
-    std::shared_ptr<arrow::ChunkedArray> chunked_array;
-
-    if (table->num_rows() == 0) {
-      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-          chunked_array, arrow::ChunkedArray::MakeEmpty(type));
-    } else if (type->Equals(arrow::large_utf8())) {
-      auto status = detail::CastToLargeOffsetArray<arrow::StringArray,
-                                                   arrow::LargeStringArray>(
-          table->column(i), type, chunked_array);
-      GAR_RETURN_NOT_OK(status);
-    } else if (type->Equals(arrow::large_binary())) {
-      auto status = detail::CastToLargeOffsetArray<arrow::BinaryArray,
-                                                   arrow::LargeBinaryArray>(
-          table->column(i), type, chunked_array);
-      GAR_RETURN_NOT_OK(status);
-    } else {
-      // noop
-      chunked_array = table->column(i);
-    }
-    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table, table->RemoveColumn(i));
+    GAR_ASSIGN_OR_RAISE(
+        auto chunked_array,
+        util::WidenStringOffsets(table->column(i),
+                                 read_context.GetMemoryPool()));
+    auto field = table->field(i)->WithType(chunked_array->type());
     GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-        table, table->AddColumn(i, field, chunked_array));
+        table, table->SetColumn(i, field, chunked_array));
   }
   return table;
 }
@@ -249,16 +398,23 @@ Status FileSystem::WriteTableToFile(
     const std::shared_ptr<arrow::Table>& table, FileType file_type,
     const std::string& path,
     const std::shared_ptr<WriterOptions>& options) const noexcept {
+  // drop the stale tables of the file from the chunk cache
+  ChunkTableCache::Global().Invalidate(path);
   // try to create the directory, oss filesystem may not support this, ignore
   ARROW_UNUSED(arrow_fs_->CreateDir(path.substr(0, path.find_last_of("/"))));
   GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto output_stream,
                                        arrow_fs_->OpenOutputStream(path));
+  const auto& write_context =
+      ExecutionContext::OrDefault(options->getContext());
   switch (file_type) {
   case FileType::CSV: {
+    auto csv_options = options->getCsvOption();
+    if (options->getContext() != nullptr) {
+      csv_options.io_context = write_context.GetIOContext();
+    }
     GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-        auto writer,
-        arrow::csv::MakeCSVWriter(output_stream.get(), table->schema(),
-                                  options->getCsvOption()));
+        auto writer, arrow::csv::MakeCSVWriter(output_stream.get(),
+                                               table->schema(), csv_options));
     RETURN_NOT_ARROW_OK(writer->WriteTable(*table));
     RETURN_NOT_ARROW_OK(writer->Close());
     break;
@@ -266,7 +422,7 @@ Status FileSystem::WriteTableToFile(
   case FileType::PARQUET: {
     auto schema = table->schema();
     RETURN_NOT_ARROW_OK(parquet::arrow::WriteTable(
-        *table, arrow::default_memory_pool(), output_stream, 64 * 1024 * 1024,
+        *table, write_context.GetMemoryPool(), output_stream, 64 * 1024 * 1024,
         options->getParquetWriterProperties(),
         options->getArrowWriterProperties()));
     break;
@@ -281,6 +437,16 @@ Status FileSystem::WriteTableToFile(
     break;
   }
 #endif
+  case FileType::IPC: {
+    GAR_ASSIGN_OR_RAISE(auto ipc_options, options->getIpcOption());
+    ipc_options.memory_pool = write_context.GetMemoryPool();
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto writer, arrow::ipc::MakeFileWriter(output_stream, table->schema(),
+                                                ipc_options));
+    RETURN_NOT_ARROW_OK(writer->WriteTable(*table));
+    RETURN_NOT_ARROW_OK(writer->Close());
+    break;
+  }
   default:
     return Status::Invalid(
         "Unsupported file type: ", FileTypeToString(file_type), " for wrting.");
@@ -289,8 +455,9 @@ Status FileSystem::WriteTableToFile(
 }
 
 Status FileSystem::WriteLabelTableToFile(
-    const std::shared_ptr<arrow::Table>& table, const std::string& path) const
-    noexcept {
+    const std::shared_ptr<arrow::Table>& table, const std::string& path,
+    const std::shared_ptr<WriteContext>& context) const noexcept {
+  ChunkTableCache::Global().Invalidate(path);
   // try to create the directory, oss filesystem may not support this, ignore
   ARROW_UNUSED(arrow_fs_->CreateDir(path.substr(0, path.find_last_of("/"))));
   GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto output_stream,
@@ -301,13 +468,15 @@ Status FileSystem::WriteLabelTableToFile(
   builder.compression(arrow::Compression::type::ZSTD);  // enable compression
   builder.encoding(parquet::Encoding::RLE);
   RETURN_NOT_ARROW_OK(parquet::arrow::WriteTable(
-      *table, arrow::default_memory_pool(), output_stream, 64 * 1024 * 1024,
-      builder.build(), parquet::default_arrow_writer_properties()));
+      *table, ExecutionContext::OrDefault(context).GetMemoryPool(),
+      output_stream, 64 * 1024 * 1024, builder.build(),
+      parquet::default_arrow_writer_properties()));
   return Status::OK();
 }
 
 Status FileSystem::CopyFile(const std::string& src_path,
                             const std::string& dst_path) const noexcept {
+  ChunkTableCache::Global().Invalidate(dst_path);
   // try to create the directory, oss filesystem may not support this, ignore
   ARROW_UNUSED(
       arrow_fs_->CreateDir(dst_path.substr(0, dst_path.find_last_of("/"))));
@@ -327,24 +496,65 @@ Result<IdType> FileSystem::GetFileNumOfDir(const std::string& dir_path,
   return static_cast<IdType>(file_infos.size());
 }
 
+Result<bool> FileSystem::FileExists(const std::string& path) const noexcept {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto file_info,
+                                       arrow_fs_->GetFileInfo(path));
+  return file_info.type() != arrow::fs::FileType::NotFound;
+}
+
+Status FileSystem::DeleteFileIfExists(const std::string& path) const
+    noexcept {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto file_info,
+                                       arrow_fs_->GetFileInfo(path));
+  if (file_info.type() == arrow::fs::FileType::NotFound) {
+    return Status::OK();
+  }
+  auto status = arrow_fs_->DeleteFile(path);
+  RETURN_NOT_ARROW_OK(status);
+  return Status::OK();
+}
+
 FileSystem::~FileSystem() {}
 
+namespace {
+// The registry of the FileSystem instances interned by
+// FileSystemFromUriOrPath, keyed by scheme, authority and options.
+std::mutex file_system_registry_mutex;
+std::unordered_map<std::string, std::shared_ptr<FileSystem>>
+    file_system_registry;
+
+template <typename Creator>
+Result<std::shared_ptr<FileSystem>> GetOrCreateFileSystem(
+    const std::string& key, Creator&& create) {
+  {
+    std::lock_guard<std::mutex> lock(file_system_registry_mutex);
+    auto it = file_system_registry.find(key);
+    if (it != file_system_registry.end()) {
+      return it->second;
+    }
+  }
+  // create outside the lock, building a remote client may be slow
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto arrow_fs, create());
+  auto fs = std::make_shared<FileSystem>(arrow_fs);
+  std::lock_guard<std::mutex> lock(file_system_registry_mutex);
+  // keep the first one if another thread has created it concurrently
+  return file_system_registry.emplace(key, fs).first->second;
+}
+}  // namespace
+
 Result<std::shared_ptr<FileSystem>> FileSystemFromUriOrPath(
     const std::string& uri_string, std::string* out_path) {
   if (uri_string.length() >= 1 && uri_string[0] == '/') {
     // if the uri_string is an absolute path, we need to create a local file
-    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-        auto arrow_fs,
-        arrow::fs::FileSystemFromUriOrPath(uri_string, out_path));
     // arrow would delete the last slash, so use uri string
     if (out_path != nullptr) {
       *out_path = uri_string;
     }
-    return std::make_shared<FileSystem>(arrow_fs);
+    return GetOrCreateFileSystem("file://", [&uri_string]() {
+      return arrow::fs::FileSystemFromUriOrPath(uri_string);
+    });
   }
 
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      auto arrow_fs, arrow::fs::FileSystemFromUriOrPath(uri_string));
   auto uri = uri::parse_uri(uri_string);
   if (uri.error != uri::Error::None) {
     return Status::Invalid("Failed to parse URI: ", uri_string);
@@ -360,7 +570,30 @@ Result<std::shared_ptr<FileSystem>> FileSystemFromUriOrPath(
                              uri_string);
     }
   }
-  return std::make_shared<FileSystem>(arrow_fs);
+  // the path is not part of the key, the file systems with the same scheme,
+  // authority (including the user info) and options are shared
+  std::string key =
+      uri.scheme + "://" + uri.authority.authority + "?" + uri.query_string;
+  auto use_mmap = uri.query.find("use_mmap");
+  if (uri.scheme == "file" && use_mmap != uri.query.end()) {
+    // arrow does not take the local options from the URI
+    arrow::fs::LocalFileSystemOptions options;
+    options.use_mmap = use_mmap->second.empty() ||
+                       use_mmap->second == "true" || use_mmap->second == "1";
+    return GetOrCreateFileSystem(
+        key,
+        [&options]() -> arrow::Result<std::shared_ptr<arrow::fs::FileSystem>> {
+          return std::make_shared<arrow::fs::LocalFileSystem>(options);
+        });
+  }
+  return GetOrCreateFileSystem(key, [&uri_string]() {
+    return arrow::fs::FileSystemFromUriOrPath(uri_string);
+  });
+}
+
+void ClearFileSystemRegistry() {
+  std::lock_guard<std::mutex> lock(file_system_registry_mutex);
+  file_system_registry.clear();
 }
 
 // arrow::fs::InitializeS3 and arrow::fs::FinalizeS3 need arrow_version >= 15
@@ -378,6 +611,8 @@ Status InitializeS3() {
 }
 
 Status FinalizeS3() {
+  // the S3 file systems must be released before finalizing the S3 APIs
+  ClearFileSystemRegistry();
 #if defined(ARROW_VERSION) && ARROW_VERSION >= 15000000
   RETURN_NOT_ARROW_OK(arrow::fs::FinalizeS3());
 #endif
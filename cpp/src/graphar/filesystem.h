@@ -19,10 +19,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "graphar/context.h"
 #include "graphar/result.h"
 #include "graphar/status.h"
 #include "graphar/types.h"
@@ -70,6 +72,11 @@ class FileSystem {
   /**
    * @brief Read and filter a file as an arrow::Table.
    *
+   * The file is scanned as a single fragment of a shared file format, and the
+   * row groups of a parquet file are pruned by their statistics under the
+   * filter. The filter is evaluated once and reused while it is alive, so
+   * the same filter can be applied to many chunks cheaply.
+   *
    * @param path The path of the file to read.
    * @param file_type The type of the file to read.
    * @param options Row filter and columns to be selected
@@ -80,9 +87,32 @@ class FileSystem {
       const std::string& path, FileType file_type,
       const util::FilterOptions& options = {}) const noexcept;
 
+  /**
+   * @brief Read the columns of a file as an arrow::Table.
+   *
+   * @param path The path of the file to read.
+   * @param file_type The type of the file to read.
+   * @param column_indices The indices of the columns to read, empty means all
+   * columns.
+   * @param context The memory pool, executor and mmap mode to read with, the
+   * default ones if nullptr.
+   */
   Result<std::shared_ptr<arrow::Table>> ReadFileToTable(
       const std::string& path, FileType file_type,
-      const std::vector<int>& column_indices) const noexcept;
+      const std::vector<int>& column_indices,
+      const std::shared_ptr<ReadContext>& context = nullptr) const noexcept;
+
+  /**
+   * @brief Open a file for random access, e.g., to read the footer and the
+   * column chunks of a parquet file with ranged reads.
+   *
+   * @param path The path of the file to open.
+   * @param context The local files are memory-mapped if the context has
+   * UseMmap().
+   */
+  Result<std::shared_ptr<arrow::io::RandomAccessFile>> OpenInputFile(
+      const std::string& path,
+      const std::shared_ptr<ReadContext>& context = nullptr) const;
 
   /**
    * @brief Read a file and convert its bytes to a value of type T.
@@ -124,10 +154,12 @@ class FileSystem {
    * @brief Write a label table to a file with parquet type.
    * @param input_table The label table to write.
    * @param path The path of the output file.
+   * @param context The memory pool to write with, the default one if nullptr.
    * @return A Status indicating OK if successful, or an error if unsuccessful.
    */
-  Status WriteLabelTableToFile(const std::shared_ptr<arrow::Table>& table,
-                               const std::string& path) const noexcept;
+  Status WriteLabelTableToFile(
+      const std::shared_ptr<arrow::Table>& table, const std::string& path,
+      const std::shared_ptr<WriteContext>& context = nullptr) const noexcept;
 
   /**
    * Copy a file.
@@ -146,10 +178,30 @@ class FileSystem {
   Result<IdType> GetFileNumOfDir(const std::string& dir_path,
                                  bool recursive = false) const noexcept;
 
+  /**
+   * @brief Check whether a file exists.
+   *
+   * @param path The path of the file.
+   * @return Whether the file exists, or an error if it fails to be checked.
+   */
+  Result<bool> FileExists(const std::string& path) const noexcept;
+
+  /**
+   * @brief Delete a file if it exists.
+   *
+   * @param path The path of the file.
+   * @return A Status indicating OK if the file is deleted or does not exist,
+   * or an error if unsuccessful.
+   */
+  Status DeleteFileIfExists(const std::string& path) const noexcept;
+
  private:
   std::shared_ptr<arrow::dataset::FileFormat> GetFileFormat(
       const FileType file_type) const;
 
+  // whether the reads with the context memory-map the files
+  bool UseMmap(const std::shared_ptr<ReadContext>& context) const;
+
  private:
   std::shared_ptr<arrow::fs::FileSystem> arrow_fs_;
 };
@@ -164,10 +216,27 @@ class FileSystem {
  *
  * in addition also recognize non-URIs, and treat them as local filesystem
  * paths. Only absolute local filesystem paths are allowed.
+ *
+ * The local files are memory-mapped instead of read into buffers if the
+ * "file" URI has the option "use_mmap=true", e.g.,
+ * "file:///path/to/graph?use_mmap=true". The reads of a ReadContext with
+ * UseMmap() map the local files of any local FileSystem.
+ *
+ * The created FileSystem instances are interned in a process-wide registry
+ * by scheme, authority and options, so the URIs of the same storage share one
+ * FileSystem (and one client and connection pool for remote storage).
  */
 Result<std::shared_ptr<FileSystem>> FileSystemFromUriOrPath(
     const std::string& uri, std::string* out_path = nullptr);
 
+/**
+ * @brief Release the FileSystem instances interned by FileSystemFromUriOrPath.
+ *
+ * The instances still referenced elsewhere stay valid, the later calls of
+ * FileSystemFromUriOrPath create new ones.
+ */
+void ClearFileSystemRegistry();
+
 /**
  * @brief Initialize the S3 APIs.
  *
@@ -67,13 +67,21 @@ using Result = cpp::result<T, Status>;
 struct GeneralParams;
 class Yaml;
 class FileSystem;
+class GraphCountIndex;
+class OffsetIndex;
+class ChunkPrefetcher;
+class ExecutionContext;
+/** The context of the readers, see ExecutionContext. */
+using ReadContext = ExecutionContext;
+/** The context of the writers and builders, see ExecutionContext. */
+using WriteContext = ExecutionContext;
 
 /** Type of vertex id or vertex index. */
 using IdType = int64_t;
 enum class Type;
 class DataType;
 /** Type of file format */
-enum FileType { CSV = 0, PARQUET = 1, ORC = 2, JSON = 3 };
+enum FileType { CSV = 0, PARQUET = 1, ORC = 2, JSON = 3, IPC = 4 };
 enum SelectType { PROPERTIES = 0, LABELS = 1 };
 /** GetChunkVersion: V1 use scanner, V2 use FileReader */
 enum GetChunkVersion { AUTO = 0, V1 = 1, V2 = 2 };
@@ -88,6 +96,9 @@ class Property;
 class PropertyGroup;
 class AdjacentList;
 class Expression;
+class LabelPredicate;
+class LabelSummary;
+class VertexSet;
 
 class VertexInfo;
 class EdgeInfo;
@@ -28,6 +28,13 @@ struct GeneralParams {
   static constexpr const char* kOffsetCol = "_graphArOffset";
   static constexpr const char* kPrimaryCol = "_graphArPrimary";
   static constexpr const char* kLabelCol = ":LABEL";
+  static constexpr const char* kEdgeNumCol = "_graphArEdgeNum";
+  static constexpr const char* kVertexNumCol = "_graphArVertexNum";
+  static constexpr const char* kChunkIndexCol = "_graphArChunkIndex";
+  static constexpr const char* kMinSrcIndexCol = "_graphArMinSrcIndex";
+  static constexpr const char* kMaxSrcIndexCol = "_graphArMaxSrcIndex";
+  static constexpr const char* kMinDstIndexCol = "_graphArMinDstIndex";
+  static constexpr const char* kMaxDstIndexCol = "_graphArMaxDstIndex";
 };
 
 }  // namespace graphar
@@ -0,0 +1,264 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "arrow/api.h"
+
+#include "graphar/filesystem.h"
+#include "graphar/general_params.h"
+#include "graphar/graph_count_index.h"
+#include "graphar/graph_info.h"
+#include "graphar/parallel_load.h"
+#include "graphar/reader_util.h"
+#include "graphar/types.h"
+
+namespace graphar {
+
+namespace {
+std::mutex count_index_registry_mutex;
+std::unordered_map<std::string, std::shared_ptr<const GraphCountIndex>>
+    count_index_registry;
+bool count_index_registry_enabled = true;
+
+Result<std::string> GetRegistryKey(const std::string& prefix,
+                                   const std::shared_ptr<EdgeInfo>& edge_info,
+                                   AdjListType adj_list_type) {
+  GAR_ASSIGN_OR_RAISE(auto adj_list_path_prefix,
+                      edge_info->GetAdjListPathPrefix(adj_list_type));
+  return prefix + adj_list_path_prefix;
+}
+
+// read an int64 column of the count manifest, null values are read as
+// `null_value`
+Status ReadManifestColumn(const std::shared_ptr<arrow::Table>& table,
+                          const std::string& name, IdType null_value,
+                          std::vector<IdType>* out) {
+  auto column = table->GetColumnByName(name);
+  if (column == nullptr || column->type()->id() != arrow::Type::INT64) {
+    return Status::Invalid("The count manifest has no int64 column ", name);
+  }
+  out->clear();
+  out->reserve(column->length());
+  for (const auto& chunk : column->chunks()) {
+    auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+    for (int64_t i = 0; i < array->length(); ++i) {
+      out->push_back(array->IsNull(i) ? null_value : array->Value(i));
+    }
+  }
+  return Status::OK();
+}
+
+// load the edge counts and the id ranges from the count manifest
+Status ReadCountManifest(const std::shared_ptr<FileSystem>& fs,
+                         const std::string& prefix,
+                         const std::shared_ptr<EdgeInfo>& edge_info,
+                         AdjListType adj_list_type,
+                         std::vector<IdType>* edge_nums,
+                         std::vector<EdgeChunkIdRange>* id_ranges) {
+  GAR_ASSIGN_OR_RAISE(auto manifest_suffix,
+                      edge_info->GetEdgesNumManifestFilePath(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto table, fs->ReadFileToTable(prefix + manifest_suffix,
+                                                      FileType::PARQUET));
+  GAR_RETURN_NOT_OK(
+      ReadManifestColumn(table, GeneralParams::kEdgeNumCol, 0, edge_nums));
+  id_ranges->clear();
+  if (table->GetColumnByName(GeneralParams::kMinSrcIndexCol) == nullptr) {
+    return Status::OK();
+  }
+  std::vector<IdType> min_src, max_src, min_dst, max_dst;
+  GAR_RETURN_NOT_OK(ReadManifestColumn(table, GeneralParams::kMinSrcIndexCol,
+                                       0, &min_src));
+  GAR_RETURN_NOT_OK(ReadManifestColumn(table, GeneralParams::kMaxSrcIndexCol,
+                                       -1, &max_src));
+  GAR_RETURN_NOT_OK(ReadManifestColumn(table, GeneralParams::kMinDstIndexCol,
+                                       0, &min_dst));
+  GAR_RETURN_NOT_OK(ReadManifestColumn(table, GeneralParams::kMaxDstIndexCol,
+                                       -1, &max_dst));
+  id_ranges->resize(edge_nums->size());
+  for (size_t i = 0; i < edge_nums->size(); ++i) {
+    (*id_ranges)[i] = {min_src[i], max_src[i], min_dst[i], max_dst[i]};
+  }
+  return Status::OK();
+}
+}  // namespace
+
+GraphCountIndex::GraphCountIndex(IdType vertex_num, IdType vertex_chunk_size,
+                                 IdType edge_chunk_size,
+                                 std::vector<IdType> edge_nums,
+                                 std::vector<EdgeChunkIdRange> id_ranges)
+    : vertex_num_(vertex_num),
+      vertex_chunk_size_(vertex_chunk_size),
+      edge_chunk_size_(edge_chunk_size),
+      total_edge_num_(0),
+      edge_nums_(std::move(edge_nums)),
+      id_ranges_(std::move(id_ranges)) {
+  for (auto edge_num : edge_nums_) {
+    total_edge_num_ += edge_num;
+  }
+}
+
+Result<IdType> GraphCountIndex::GetEdgeNum(IdType vertex_chunk_index) const {
+  if (vertex_chunk_index < 0 ||
+      vertex_chunk_index >= static_cast<IdType>(edge_nums_.size())) {
+    return Status::IndexError("vertex chunk index ", vertex_chunk_index,
+                              " is out-of-bounds for vertex chunk num ",
+                              edge_nums_.size());
+  }
+  return edge_nums_[vertex_chunk_index];
+}
+
+Result<IdType> GraphCountIndex::GetEdgeChunkNum(
+    IdType vertex_chunk_index) const {
+  GAR_ASSIGN_OR_RAISE(auto edge_num, GetEdgeNum(vertex_chunk_index));
+  return (edge_num + edge_chunk_size_ - 1) / edge_chunk_size_;
+}
+
+std::vector<IdType> GraphCountIndex::GetEdgeChunkNums() const {
+  std::vector<IdType> edge_chunk_nums(edge_nums_.size());
+  for (size_t i = 0; i < edge_nums_.size(); ++i) {
+    edge_chunk_nums[i] =
+        (edge_nums_[i] + edge_chunk_size_ - 1) / edge_chunk_size_;
+  }
+  return edge_chunk_nums;
+}
+
+Result<EdgeChunkIdRange> GraphCountIndex::GetIdRange(
+    IdType vertex_chunk_index) const {
+  if (id_ranges_.empty()) {
+    return Status::Invalid("The id ranges of the vertex chunks are unknown.");
+  }
+  GAR_RETURN_NOT_OK(GetEdgeNum(vertex_chunk_index).status());
+  return id_ranges_[vertex_chunk_index];
+}
+
+Result<std::shared_ptr<const GraphCountIndex>> GraphCountIndex::Load(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type) {
+  GAR_ASSIGN_OR_RAISE(auto vertex_num, util::GetVertexNum(fs, prefix, edge_info,
+                                                          adj_list_type));
+  IdType vertex_chunk_size;
+  if (adj_list_type == AdjListType::ordered_by_source ||
+      adj_list_type == AdjListType::unordered_by_source) {
+    vertex_chunk_size = edge_info->GetSrcChunkSize();
+  } else {
+    vertex_chunk_size = edge_info->GetDstChunkSize();
+  }
+  IdType vertex_chunk_num =
+      (vertex_num + vertex_chunk_size - 1) / vertex_chunk_size;
+
+  // prefer the count manifest, fallback to the count files if it is absent
+  std::vector<IdType> manifest_edge_nums;
+  std::vector<EdgeChunkIdRange> id_ranges;
+  if (ReadCountManifest(fs, prefix, edge_info, adj_list_type,
+                        &manifest_edge_nums, &id_ranges)
+          .ok() &&
+      static_cast<IdType>(manifest_edge_nums.size()) == vertex_chunk_num) {
+    return std::make_shared<const GraphCountIndex>(
+        vertex_num, vertex_chunk_size, edge_info->GetChunkSize(),
+        std::move(manifest_edge_nums), std::move(id_ranges));
+  }
+
+  // the count files are tiny, read them concurrently on the load thread pool
+  std::vector<IdType> edge_nums(vertex_chunk_num);
+  GAR_RETURN_NOT_OK(ParallelLoad(
+      GetLoadThreadPool(), vertex_chunk_num, [&](int64_t i) -> Status {
+        GAR_ASSIGN_OR_RAISE(auto suffix,
+                            edge_info->GetEdgesNumFilePath(i, adj_list_type));
+        GAR_ASSIGN_OR_RAISE(edge_nums[i],
+                            fs->ReadFileToValue<IdType>(prefix + suffix));
+        return Status::OK();
+      }));
+  return std::make_shared<const GraphCountIndex>(
+      vertex_num, vertex_chunk_size, edge_info->GetChunkSize(),
+      std::move(edge_nums));
+}
+
+Result<std::shared_ptr<const GraphCountIndex>> GraphCountIndex::Get(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type) {
+  GAR_ASSIGN_OR_RAISE(auto key,
+                      GetRegistryKey(prefix, edge_info, adj_list_type));
+  {
+    std::lock_guard<std::mutex> lock(count_index_registry_mutex);
+    auto it = count_index_registry.find(key);
+    if (it != count_index_registry.end()) {
+      return it->second;
+    }
+  }
+  GAR_ASSIGN_OR_RAISE(auto index, Load(fs, prefix, edge_info, adj_list_type));
+  std::lock_guard<std::mutex> lock(count_index_registry_mutex);
+  if (!count_index_registry_enabled) {
+    return index;
+  }
+  return count_index_registry.emplace(key, index).first->second;
+}
+
+Result<std::shared_ptr<const GraphCountIndex>> GraphCountIndex::Get(
+    const std::string& prefix, const std::shared_ptr<EdgeInfo>& edge_info,
+    AdjListType adj_list_type) {
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  return Get(fs, out_prefix, edge_info, adj_list_type);
+}
+
+std::shared_ptr<const GraphCountIndex> GraphCountIndex::Lookup(
+    const std::string& prefix, const std::shared_ptr<EdgeInfo>& edge_info,
+    AdjListType adj_list_type) {
+  auto maybe_key = GetRegistryKey(prefix, edge_info, adj_list_type);
+  if (maybe_key.has_error()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(count_index_registry_mutex);
+  auto it = count_index_registry.find(maybe_key.value());
+  return it == count_index_registry.end() ? nullptr : it->second;
+}
+
+void GraphCountIndex::Invalidate(const std::string& prefix,
+                                 const std::shared_ptr<EdgeInfo>& edge_info,
+                                 AdjListType adj_list_type) {
+  auto maybe_key = GetRegistryKey(prefix, edge_info, adj_list_type);
+  if (maybe_key.has_error()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(count_index_registry_mutex);
+  count_index_registry.erase(maybe_key.value());
+}
+
+void GraphCountIndex::Clear() {
+  std::lock_guard<std::mutex> lock(count_index_registry_mutex);
+  count_index_registry.clear();
+}
+
+void GraphCountIndex::SetRegistryEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(count_index_registry_mutex);
+  count_index_registry_enabled = enabled;
+  if (!enabled) {
+    count_index_registry.clear();
+  }
+}
+
+bool GraphCountIndex::IsRegistryEnabled() {
+  std::lock_guard<std::mutex> lock(count_index_registry_mutex);
+  return count_index_registry_enabled;
+}
+
+}  // namespace graphar
@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+
+namespace graphar {
+
+/**
+ * @brief The min/max source and destination ids of the edges of a vertex
+ * chunk. The range of an empty vertex chunk has min > max.
+ */
+struct EdgeChunkIdRange {
+  IdType min_src = 0;
+  IdType max_src = -1;
+  IdType min_dst = 0;
+  IdType max_dst = -1;
+
+  bool empty() const { return min_src > max_src; }
+};
+
+/**
+ * @brief The vertex and edge counts of an adjacency list of an edge type.
+ *
+ * The index holds the vertex count and the edge count of every vertex chunk
+ * of the adjacency list, which are otherwise stored in one small file per
+ * vertex chunk. When the adjacency list has a count manifest (see
+ * EdgeChunkWriter::WriteCountManifest) the index is loaded from it with a
+ * single read, together with the id ranges of the vertex chunks if present.
+ * Otherwise the edge count files are read in parallel on the load thread
+ * pool (see GetLoadThreadPool). The readers and collections look up the
+ * counts in memory afterwards.
+ *
+ * The loaded indices are kept in a process-wide registry, which does not see
+ * the counts rewritten by another process. Call Invalidate() or Clear() after
+ * such a rewrite, or turn the registry off with SetRegistryEnabled(false) for
+ * graphs that are written while they are read.
+ */
+class GraphCountIndex {
+ public:
+  /**
+   * @brief Initialize the GraphCountIndex with the counts.
+   *
+   * @param vertex_num The number of vertices of the adjacency list.
+   * @param vertex_chunk_size The vertex chunk size of the adjacency list.
+   * @param edge_chunk_size The edge chunk size of the edge type.
+   * @param edge_nums The number of edges of each vertex chunk.
+   * @param id_ranges The id ranges of each vertex chunk, empty if unknown.
+   */
+  GraphCountIndex(IdType vertex_num, IdType vertex_chunk_size,
+                  IdType edge_chunk_size, std::vector<IdType> edge_nums,
+                  std::vector<EdgeChunkIdRange> id_ranges = {});
+
+  /** @brief Get the number of vertices. */
+  IdType GetVertexNum() const { return vertex_num_; }
+
+  /** @brief Get the vertex chunk size of the adjacency list. */
+  IdType GetVertexChunkSize() const { return vertex_chunk_size_; }
+
+  /** @brief Get the number of vertex chunks. */
+  IdType GetVertexChunkNum() const {
+    return static_cast<IdType>(edge_nums_.size());
+  }
+
+  /** @brief Get the total number of edges of all the vertex chunks. */
+  IdType GetTotalEdgeNum() const { return total_edge_num_; }
+
+  /**
+   * @brief Get the number of edges of a vertex chunk.
+   *
+   * @param vertex_chunk_index The index of the vertex chunk.
+   */
+  Result<IdType> GetEdgeNum(IdType vertex_chunk_index) const;
+
+  /**
+   * @brief Get the number of edge chunks of a vertex chunk.
+   *
+   * @param vertex_chunk_index The index of the vertex chunk.
+   */
+  Result<IdType> GetEdgeChunkNum(IdType vertex_chunk_index) const;
+
+  /** @brief Get the number of edges of each vertex chunk. */
+  const std::vector<IdType>& GetEdgeNums() const { return edge_nums_; }
+
+  /** @brief Get the number of edge chunks of each vertex chunk. */
+  std::vector<IdType> GetEdgeChunkNums() const;
+
+  /** @brief Whether the id ranges of the vertex chunks are known. */
+  bool HasIdRanges() const { return !id_ranges_.empty(); }
+
+  /**
+   * @brief Get the min/max source and destination ids of the edges of a
+   * vertex chunk, only available if HasIdRanges().
+   *
+   * @param vertex_chunk_index The index of the vertex chunk.
+   */
+  Result<EdgeChunkIdRange> GetIdRange(IdType vertex_chunk_index) const;
+
+  /**
+   * @brief Load the counts of an adjacency list from the count manifest if
+   * present, otherwise from the count files of the vertex chunks.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type.
+   * @return The loaded index, or error if any count file fails to be read.
+   */
+  static Result<std::shared_ptr<const GraphCountIndex>> Load(
+      const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+      const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type);
+
+  /**
+   * @brief Get the index of an adjacency list from the process-wide registry,
+   * loading it on the first call. The index is loaded on every call if the
+   * registry is disabled.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type.
+   */
+  static Result<std::shared_ptr<const GraphCountIndex>> Get(
+      const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+      const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type);
+
+  /**
+   * @brief Get the index of an adjacency list from the process-wide registry,
+   * loading it on the first call.
+   *
+   * @param prefix The absolute prefix or URI of the graph.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type.
+   */
+  static Result<std::shared_ptr<const GraphCountIndex>> Get(
+      const std::string& prefix, const std::shared_ptr<EdgeInfo>& edge_info,
+      AdjListType adj_list_type);
+
+  /**
+   * @brief Get the index of an adjacency list from the process-wide registry
+   * without loading it.
+   *
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type.
+   * @return The registered index, or nullptr if it is not loaded yet.
+   */
+  static std::shared_ptr<const GraphCountIndex> Lookup(
+      const std::string& prefix, const std::shared_ptr<EdgeInfo>& edge_info,
+      AdjListType adj_list_type);
+
+  /**
+   * @brief Drop the registered index of an adjacency list, e.g., after its
+   * count files are rewritten.
+   *
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type.
+   */
+  static void Invalidate(const std::string& prefix,
+                         const std::shared_ptr<EdgeInfo>& edge_info,
+                         AdjListType adj_list_type);
+
+  /** @brief Drop all the registered indices. */
+  static void Clear();
+
+  /**
+   * @brief Enable or disable the process-wide registry, it is enabled by
+   * default. Disabling it drops the registered indices, and the counts are
+   * then read from the files on every Get() and util::GetEdgeNum().
+   *
+   * @param enabled Whether the loaded indices are registered.
+   */
+  static void SetRegistryEnabled(bool enabled);
+
+  /** @brief Whether the process-wide registry is enabled. */
+  static bool IsRegistryEnabled();
+
+ private:
+  IdType vertex_num_;
+  IdType vertex_chunk_size_;
+  IdType edge_chunk_size_;
+  IdType total_edge_num_;
+  std::vector<IdType> edge_nums_;
+  std::vector<EdgeChunkIdRange> id_ranges_;
+};
+
+}  // namespace graphar
@@ -116,7 +116,7 @@ bool PropertyGroup::HasProperty(const std::string& property_name) const {
 bool PropertyGroup::IsValidated() const {
   if (prefix_.empty() ||
       (file_type_ != FileType::CSV && file_type_ != FileType::PARQUET &&
-       file_type_ != FileType::ORC)) {
+       file_type_ != FileType::ORC && file_type_ != FileType::IPC)) {
     return false;
   }
   if (properties_.empty()) {
@@ -175,7 +175,7 @@ bool AdjacentList::IsValidated() const {
   }
   if (prefix_.empty() ||
       (file_type_ != FileType::CSV && file_type_ != FileType::PARQUET &&
-       file_type_ != FileType::ORC)) {
+       file_type_ != FileType::ORC && file_type_ != FileType::IPC)) {
     return false;
   }
   return true;
@@ -710,6 +710,14 @@ Result<std::string> EdgeInfo::GetEdgesNumFilePath(
          "edge_count" + std::to_string(vertex_chunk_index);
 }
 
+Result<std::string> EdgeInfo::GetEdgesNumManifestFilePath(
+    AdjListType adj_list_type) const {
+  CHECK_HAS_ADJ_LIST_TYPE(adj_list_type);
+  int i = impl_->adjacent_list_type_to_index_.at(adj_list_type);
+  return BuildPath({impl_->prefix_, impl_->adjacent_lists_[i]->GetPrefix()}) +
+         "edge_count_manifest";
+}
+
 Result<std::string> EdgeInfo::GetAdjListFilePath(
     IdType vertex_chunk_index, IdType edge_chunk_index,
     AdjListType adj_list_type) const {
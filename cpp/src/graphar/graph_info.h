@@ -564,6 +564,17 @@ class EdgeInfo {
   Result<std::string> GetEdgesNumFilePath(IdType vertex_chunk_index,
                                           AdjListType adj_list_type) const;
 
+  /**
+   * @brief Get the file path of the count manifest, which holds the number of
+   * edges of all the vertex chunks in one file.
+   *
+   * @param adj_list_type The adjacency list type.
+   * @return A Result object containing the file path of the count manifest,
+   * or a Status object indicating an error.
+   */
+  Result<std::string> GetEdgesNumManifestFilePath(
+      AdjListType adj_list_type) const;
+
   /**
    * @brief Get the file path of adj list topology chunk
    *
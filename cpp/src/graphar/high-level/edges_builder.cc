@@ -17,8 +17,12 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "arrow/api.h"
 
+#include "graphar/context.h"
 #include "graphar/convert_to_arrow_type.h"
 #include "graphar/general_params.h"
 #include "graphar/high-level/edges_builder.h"
@@ -61,14 +65,25 @@ Status EdgesBuilder::Dump() {
   // dump the edge nums
   IdType vertex_chunk_num =
       (num_vertices_ + vertex_chunk_size_ - 1) / vertex_chunk_size_;
+  std::vector<IdType> edge_nums(vertex_chunk_num, 0);
+  std::vector<EdgeChunkIdRange> id_ranges(vertex_chunk_num);
   for (IdType vertex_chunk_index = 0; vertex_chunk_index < vertex_chunk_num;
        vertex_chunk_index++) {
-    if (edges_.find(vertex_chunk_index) == edges_.end()) {
-      GAR_RETURN_NOT_OK(writer.WriteEdgesNum(vertex_chunk_index, 0));
-    } else {
-      GAR_RETURN_NOT_OK(writer.WriteEdgesNum(
-          vertex_chunk_index, edges_[vertex_chunk_index].size()));
+    auto it = edges_.find(vertex_chunk_index);
+    if (it != edges_.end() && !it->second.empty()) {
+      edge_nums[vertex_chunk_index] = it->second.size();
+      auto& range = id_ranges[vertex_chunk_index];
+      range = {it->second[0].GetSource(), it->second[0].GetSource(),
+               it->second[0].GetDestination(), it->second[0].GetDestination()};
+      for (const auto& e : it->second) {
+        range.min_src = std::min(range.min_src, e.GetSource());
+        range.max_src = std::max(range.max_src, e.GetSource());
+        range.min_dst = std::min(range.min_dst, e.GetDestination());
+        range.max_dst = std::max(range.max_dst, e.GetDestination());
+      }
     }
+    GAR_RETURN_NOT_OK(writer.WriteEdgesNum(vertex_chunk_index,
+                                           edge_nums[vertex_chunk_index]));
   }
   // dump the edges
   for (auto& chunk_edges : edges_) {
@@ -79,6 +94,9 @@ Status EdgesBuilder::Dump() {
     GAR_RETURN_NOT_OK(writer.WriteTable(input_table, vertex_chunk_index, 0));
     chunk_edges.second.clear();
   }
+  // dump the count manifest of all the vertex chunks, after the counts and
+  // the adjacency list that remove a stale manifest
+  GAR_RETURN_NOT_OK(writer.WriteCountManifest(edge_nums, id_ranges));
   is_saved_ = true;
   return Status::OK();
 }
@@ -182,13 +200,19 @@ Status EdgesBuilder::validate(const Edge& e,
   return Status::OK();
 }
 
+arrow::MemoryPool* EdgesBuilder::getMemoryPool() const {
+  return ExecutionContext::OrDefault(
+             writer_options_ ? writer_options_->getContext() : nullptr)
+      .GetMemoryPool();
+}
+
 template <Type type>
 Status EdgesBuilder::tryToAppend(
     const std::string& property_name,
     std::shared_ptr<arrow::Array>& array,  // NOLINT
     const std::vector<Edge>& edges) {
   using CType = typename TypeToArrowType<type>::CType;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  arrow::MemoryPool* pool = getMemoryPool();
   typename TypeToArrowType<type>::BuilderType builder(pool);
   for (const auto& e : edges) {
     if (e.Empty() || (!e.ContainProperty(property_name))) {
@@ -208,7 +232,7 @@ Status EdgesBuilder::tryToAppend<Type::TIMESTAMP>(
     std::shared_ptr<arrow::Array>& array,  // NOLINT
     const std::vector<Edge>& edges) {
   using CType = typename TypeToArrowType<Type::TIMESTAMP>::CType::c_type;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  arrow::MemoryPool* pool = getMemoryPool();
   typename TypeToArrowType<Type::TIMESTAMP>::BuilderType builder(
       arrow::timestamp(arrow::TimeUnit::MILLI), pool);
   for (const auto& e : edges) {
@@ -229,7 +253,7 @@ Status EdgesBuilder::tryToAppend<Type::DATE>(
     std::shared_ptr<arrow::Array>& array,  // NOLINT
     const std::vector<Edge>& edges) {
   using CType = typename TypeToArrowType<Type::DATE>::CType::c_type;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  arrow::MemoryPool* pool = getMemoryPool();
   typename TypeToArrowType<Type::DATE>::BuilderType builder(pool);
   for (const auto& e : edges) {
     if (e.Empty() || (!e.ContainProperty(property_name))) {
@@ -274,7 +298,7 @@ Status EdgesBuilder::tryToAppend(
     int src_or_dest,
     std::shared_ptr<arrow::Array>& array,  // NOLINT
     const std::vector<Edge>& edges) {
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  arrow::MemoryPool* pool = getMemoryPool();
   typename arrow::TypeTraits<arrow::Int64Type>::BuilderType builder(pool);
   for (const auto& e : edges) {
     RETURN_NOT_ARROW_OK(builder.Append(std::any_cast<int64_t>(
@@ -319,7 +343,7 @@ Result<std::shared_ptr<arrow::Table>> EdgesBuilder::convertToTable(
 
 Result<std::shared_ptr<arrow::Table>> EdgesBuilder::getOffsetTable(
     IdType vertex_chunk_index, const std::vector<Edge>& edges) {
-  arrow::Int64Builder builder;
+  arrow::Int64Builder builder(getMemoryPool());
   IdType begin_index = vertex_chunk_index * vertex_chunk_size_,
          end_index = begin_index + vertex_chunk_size_;
   RETURN_NOT_ARROW_OK(builder.Append(0));
@@ -34,6 +34,7 @@
 
 namespace arrow {
 class Array;
+class MemoryPool;
 }
 
 namespace graphar::builder {
@@ -468,6 +469,12 @@ class EdgesBuilder {
   Result<std::shared_ptr<arrow::Table>> getOffsetTable(
       IdType vertex_chunk_index, const std::vector<Edge>& edges);
 
+  /**
+   * @brief Get the memory pool of the context of the writer options, or the
+   * default memory pool if there is none.
+   */
+  arrow::MemoryPool* getMemoryPool() const;
+
  private:
   std::shared_ptr<EdgeInfo> edge_info_;
   std::string prefix_;
@@ -19,63 +19,93 @@
 
 #include "graphar/high-level/graph_reader.h"
 #include <algorithm>
-#include <unordered_set>
+#include <atomic>
+#include <mutex>
 #include "arrow/array.h"
+#include "arrow/util/thread_pool.h"
 #include "graphar/api/arrow_reader.h"
 #include "graphar/convert_to_arrow_type.h"
+#include "graphar/filesystem.h"
 #include "graphar/label.h"
+#include "graphar/label_summary.h"
 #include "graphar/types.h"
 
 namespace graphar {
 
 template <Type type>
-Status CastToAny(std::shared_ptr<arrow::Array> array,
+Status CastToAny(std::shared_ptr<arrow::Array> array, int64_t row,
                  std::any& any) {  // NOLINT
-  if (array->IsNull(0)) {
+  if (array->IsNull(row)) {
     any = std::any();
     return Status::OK();
   }
   using ArrayType = typename TypeToArrowType<type>::ArrayType;
   auto column = std::dynamic_pointer_cast<ArrayType>(array);
-  any = column->GetView(0);
+  any = column->GetView(row);
   return Status::OK();
 }
 
 template <>
 Status CastToAny<Type::STRING>(std::shared_ptr<arrow::Array> array,
+                               int64_t row,
                                std::any& any) {  // NOLINT
   using ArrayType = typename TypeToArrowType<Type::STRING>::ArrayType;
   auto column = std::dynamic_pointer_cast<ArrayType>(array);
-  any = column->GetString(0);
+  any = column->GetString(row);
   return Status::OK();
 }
 
 Status TryToCastToAny(const std::shared_ptr<DataType>& type,
-                      std::shared_ptr<arrow::Array> array,
+                      std::shared_ptr<arrow::Array> array, int64_t row,
                       std::any& any) {  // NOLINT
   switch (type->id()) {
   case Type::BOOL:
-    return CastToAny<Type::BOOL>(array, any);
+    return CastToAny<Type::BOOL>(array, row, any);
   case Type::INT32:
-    return CastToAny<Type::INT32>(array, any);
+    return CastToAny<Type::INT32>(array, row, any);
   case Type::INT64:
-    return CastToAny<Type::INT64>(array, any);
+    return CastToAny<Type::INT64>(array, row, any);
   case Type::FLOAT:
-    return CastToAny<Type::FLOAT>(array, any);
+    return CastToAny<Type::FLOAT>(array, row, any);
   case Type::DOUBLE:
-    return CastToAny<Type::DOUBLE>(array, any);
+    return CastToAny<Type::DOUBLE>(array, row, any);
   case Type::STRING:
-    return CastToAny<Type::STRING>(array, any);
+    return CastToAny<Type::STRING>(array, row, any);
   case Type::DATE:
-    return CastToAny<Type::DATE>(array, any);
+    return CastToAny<Type::DATE>(array, row, any);
   case Type::TIMESTAMP:
-    return CastToAny<Type::TIMESTAMP>(array, any);
+    return CastToAny<Type::TIMESTAMP>(array, row, any);
   default:
     return Status::TypeError("Unsupported type.");
   }
   return Status::OK();
 }
 
+// cast the values of a row of the columns of a chunk into the maps of a
+// vertex or an edge
+Status CastRowToAny(
+    const PropertyChunk& chunk, int64_t row,
+    std::map<std::string, std::any>& properties,  // NOLINT
+    std::map<std::string, std::shared_ptr<arrow::Array>>&
+        list_properties) {  // NOLINT
+  const auto& layout = chunk.layout();
+  for (int i = 0; i < layout.size(); ++i) {
+    if (!chunk.HasColumn(i)) {
+      continue;
+    }
+    const auto& array = chunk.array(i);
+    if (array->type()->id() == arrow::Type::LIST) {
+      auto list_array = std::static_pointer_cast<arrow::ListArray>(array);
+      list_properties[layout.GetName(i)] = list_array->value_slice(row);
+    } else {
+      auto type = DataType::ArrowDataTypeToDataType(array->type());
+      GAR_RETURN_NOT_OK(
+          TryToCastToAny(type, array, row, properties[layout.GetName(i)]));
+    }
+  }
+  return Status::OK();
+}
+
 Vertex::Vertex(IdType id,
                std::vector<VertexPropertyArrowChunkReader>& readers)  // NOLINT
     : id_(id) {
@@ -94,15 +124,42 @@ Vertex::Vertex(IdType id,
         auto type = DataType::ArrowDataTypeToDataType(field->type());
         GAR_RAISE_ERROR_NOT_OK(TryToCastToAny(type,
                                               chunk_table->column(i)->chunk(0),
-                                              properties_[field->name()]));
+                                              0, properties_[field->name()]));
       }
     }
   }
 }
 
+Vertex::Vertex(const VertexView& view) : id_(view.id()) {
+  GAR_RAISE_ERROR_NOT_OK(CastRowToAny(view.chunk(), view.row(), properties_,
+                                      list_properties_));
+}
+
+Status VertexIter::load(IdType vid) {
+  IdType chunk_index = vid / chunk_size_;
+  if (chunk_ != nullptr && chunk_index == loaded_chunk_index_) {
+    return Status::OK();
+  }
+  // read the whole chunk once, the vertices of the chunk are rows of it
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  for (auto& reader : readers_) {
+    GAR_RETURN_NOT_OK(reader.seek(chunk_index * chunk_size_));
+    GAR_ASSIGN_OR_RAISE(auto chunk_table,
+                        reader.GetChunk(graphar::GetChunkVersion::V1));
+    tables.push_back(std::move(chunk_table));
+  }
+  GAR_ASSIGN_OR_RAISE(
+      chunk_, PropertyChunk::Make(layout_, tables,
+                                  readers_.empty()
+                                      ? nullptr
+                                      : readers_.front().GetReadContext()));
+  loaded_chunk_index_ = chunk_index;
+  return Status::OK();
+}
+
 Result<bool> VertexIter::hasLabel(const std::string& label) noexcept {
   std::shared_ptr<arrow::ChunkedArray> column(nullptr);
-  label_reader_.seek(cur_offset_);
+  label_reader_.seek(id());
   GAR_ASSIGN_OR_RAISE(auto chunk_table, label_reader_.GetLabelChunk());
   column = util::GetArrowColumnByName(chunk_table, label);
   if (column != nullptr) {
@@ -117,10 +174,7 @@ Result<bool> VertexIter::hasLabel(const std::string& label) noexcept {
 Result<std::vector<std::string>> VertexIter::label() noexcept {
   std::shared_ptr<arrow::ChunkedArray> column(nullptr);
   std::vector<std::string> vertex_label;
-  if (is_filtered_)
-    label_reader_.seek(filtered_ids_[cur_offset_]);
-  else
-    label_reader_.seek(cur_offset_);
+  label_reader_.seek(id());
   GAR_ASSIGN_OR_RAISE(auto chunk_table, label_reader_.GetLabelChunk());
   for (auto label : labels_) {
     column = util::GetArrowColumnByName(chunk_table, label);
@@ -135,82 +189,91 @@ Result<std::vector<std::string>> VertexIter::label() noexcept {
   return vertex_label;
 }
 
-static inline bool IsValid(bool* state, int column_number) {
-  for (int i = 0; i < column_number; ++i) {
-    // AND case
-    if (!state[i])
-      return false;
-    // OR case
-    // if (state[i]) return true;
-  }
-  // AND case
-  return true;
-  // OR case
-  // return false;
-}
-
-Result<std::vector<IdType>> VerticesCollection::filter(
-    std::vector<std::string> filter_labels,
-    std::vector<IdType>* new_valid_chunk) {
-  std::vector<int> indices;
-  const int TOT_ROWS_NUM = vertex_num_;
-  const int CHUNK_SIZE = vertex_info_->GetChunkSize();
-  const int TOT_LABEL_NUM = labels_.size();
-  const int TESTED_LABEL_NUM = filter_labels.size();
-  std::vector<int> tested_label_ids;
-
+namespace {
+// the predicate that the vertex has all the filter labels the vertex type has
+Result<std::shared_ptr<LabelPredicate>> AllOfKnownLabels(
+    const std::vector<std::string>& labels,
+    const std::vector<std::string>& filter_labels) {
+  std::vector<std::string> tested_labels;
   for (const auto& filter_label : filter_labels) {
-    auto it = std::find(labels_.begin(), labels_.end(), filter_label);
-    if (it != labels_.end()) {
-      tested_label_ids.push_back(std::distance(labels_.begin(), it));
+    if (std::find(labels.begin(), labels.end(), filter_label) !=
+        labels.end()) {
+      tested_labels.push_back(filter_label);
     }
   }
-  if (tested_label_ids.empty())
+  if (tested_labels.empty())
     return Status::KeyError(
         "query label"
         " does not exist in the vertex.");
+  return LabelPredicate::AllOf(tested_labels);
+}
+}  // namespace
 
-  uint64_t* bitmap = new uint64_t[TOT_ROWS_NUM / 64 + 1];
-  memset(bitmap, 0, sizeof(uint64_t) * (TOT_ROWS_NUM / 64 + 1));
-  int total_count = 0;
-  int row_num;
+Result<std::vector<IdType>> VerticesCollection::filter(
+    std::vector<std::string> filter_labels,
+    std::vector<IdType>* new_valid_chunk) {
+  GAR_ASSIGN_OR_RAISE(auto predicate,
+                      AllOfKnownLabels(labels_, filter_labels));
+  return filter(predicate, new_valid_chunk);
+}
+
+Result<std::vector<IdType>> VerticesCollection::filter(
+    const std::shared_ptr<LabelPredicate>& predicate,
+    std::vector<IdType>* new_valid_chunk) {
+  GAR_ASSIGN_OR_RAISE(auto vertex_set, filterSet(predicate, new_valid_chunk));
+  return vertex_set->ToVector();
+}
 
+Result<std::shared_ptr<VertexSet>> VerticesCollection::filterSet(
+    const std::shared_ptr<LabelPredicate>& predicate,
+    std::vector<IdType>* new_valid_chunk) {
+  GAR_ASSIGN_OR_RAISE(auto compiled,
+                      CompiledLabelPredicate::Compile(predicate, labels_));
+  const IdType chunk_size = vertex_info_->GetChunkSize();
+  std::vector<IdType> chunk_indices;
   if (is_filtered_) {
-    for (int chunk_idx : valid_chunk_) {
-      row_num = std::min(CHUNK_SIZE, TOT_ROWS_NUM - chunk_idx * CHUNK_SIZE);
-      std::string new_filename =
-          prefix_ + vertex_info_->GetPrefix() + "labels/chunk";
-      int count = read_parquet_file_and_get_valid_indices(
-          new_filename.c_str(), row_num, TOT_LABEL_NUM, TESTED_LABEL_NUM,
-          tested_label_ids, IsValid, chunk_idx, CHUNK_SIZE, &indices, bitmap,
-          QUERY_TYPE::INDEX);
-      if (count != 0 && new_valid_chunk != nullptr)
-        new_valid_chunk->emplace_back(static_cast<IdType>(chunk_idx));
-    }
+    chunk_indices = valid_chunk_;
   } else {
-    for (int chunk_idx = 0; chunk_idx * CHUNK_SIZE < TOT_ROWS_NUM;
+    for (IdType chunk_idx = 0; chunk_idx * chunk_size < vertex_num_;
          ++chunk_idx) {
-      row_num = std::min(CHUNK_SIZE, TOT_ROWS_NUM - chunk_idx * CHUNK_SIZE);
-      std::string new_filename =
-          prefix_ + vertex_info_->GetPrefix() + "labels/chunk";
-      int count = read_parquet_file_and_get_valid_indices(
-          new_filename.c_str(), row_num, TOT_LABEL_NUM, TESTED_LABEL_NUM,
-          tested_label_ids, IsValid, chunk_idx, CHUNK_SIZE, &indices, bitmap,
-          QUERY_TYPE::INDEX);
-      if (count != 0)
-        valid_chunk_.emplace_back(static_cast<IdType>(chunk_idx));
+      chunk_indices.push_back(chunk_idx);
     }
   }
-  // std::cout << "Total valid count: " << total_count << std::endl;
-  std::vector<int64_t> indices64;
-
-  for (int value : indices) {
-    indices64.push_back(static_cast<int64_t>(value));
+  std::string base_dir;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix_, &base_dir));
+  // the label chunks are written by WriteLabelTable in parquet
+  std::string label_chunk_prefix =
+      base_dir + vertex_info_->GetPrefix() + "labels/chunk";
+  // skip the chunks the label summary rules out, a summary that fails to
+  // load only leaves every chunk to be read
+  auto maybe_summary =
+      LabelSummary::Get(fs, base_dir, vertex_info_, vertex_num_);
+  std::shared_ptr<const LabelSummary> summary;
+  if (!maybe_summary.has_error()) {
+    summary = maybe_summary.value();
   }
-
-  delete[] bitmap;
-
-  return indices64;
+  GAR_ASSIGN_OR_RAISE(
+      auto result,
+      FilterLabelChunks(fs, label_chunk_prefix, FileType::PARQUET, vertex_num_,
+                        chunk_size, chunk_indices, compiled,
+                        QUERY_TYPE::ADAPTIVE, summary));
+  if (is_filtered_) {
+    if (new_valid_chunk != nullptr) {
+      new_valid_chunk->insert(new_valid_chunk->end(),
+                              result.valid_chunks.begin(),
+                              result.valid_chunks.end());
+    }
+  } else {
+    valid_chunk_.insert(valid_chunk_.end(), result.valid_chunks.begin(),
+                        result.valid_chunks.end());
+  }
+  // a dense result is compressed from the bitmap without listing the ids
+  if (result.type == QUERY_TYPE::BITMAP) {
+    return std::make_shared<VertexSet>(
+        VertexSet::FromBitmap(result.bitmap.data(), vertex_num_));
+  }
+  return std::make_shared<VertexSet>(
+      VertexSet::FromIds(std::move(result.indices)));
 }
 
 Result<std::vector<IdType>> VerticesCollection::filter_by_acero(
@@ -267,81 +330,68 @@ Result<std::vector<IdType>> VerticesCollection::filter_by_acero(
 Result<std::vector<IdType>> VerticesCollection::filter(
     std::string property_name, std::shared_ptr<Expression> filter_expression,
     std::vector<IdType>* new_valid_chunk) {
-  std::vector<int> indices;
-  const int TOT_ROWS_NUM = vertex_num_;
-  const int CHUNK_SIZE = vertex_info_->GetChunkSize();
-  int total_count = 0;
+  GAR_ASSIGN_OR_RAISE(
+      auto vertex_set,
+      filterSet(property_name, filter_expression, new_valid_chunk));
+  return vertex_set->ToVector();
+}
+
+Result<std::shared_ptr<VertexSet>> VerticesCollection::filterSet(
+    const std::string& property_name,
+    const std::shared_ptr<Expression>& filter_expression,
+    std::vector<IdType>* new_valid_chunk) {
+  const IdType chunk_size = vertex_info_->GetChunkSize();
+  std::vector<IdType> chunk_indices;
+  if (is_filtered_) {
+    chunk_indices = valid_chunk_;
+  } else {
+    for (IdType chunk_idx = 0; chunk_idx * chunk_size < vertex_num_;
+         ++chunk_idx) {
+      chunk_indices.push_back(chunk_idx);
+    }
+  }
   auto property_group = vertex_info_->GetPropertyGroup(property_name);
-  auto maybe_filter_reader = graphar::VertexPropertyArrowChunkReader::Make(
-      vertex_info_, property_group, prefix_, {});
-  auto filter_reader = maybe_filter_reader.value();
+  GAR_ASSIGN_OR_RAISE(auto filter_reader,
+                      VertexPropertyArrowChunkReader::Make(
+                          vertex_info_, property_group, prefix_, {}));
   filter_reader->Filter(filter_expression);
-  std::vector<int64_t> indices64;
-  if (is_filtered_) {
-    for (int chunk_idx : valid_chunk_) {
-      // how to itetate valid_chunk_?
-      filter_reader->seek(chunk_idx * CHUNK_SIZE);
-      auto filter_result =
-          filter_reader->GetChunk(graphar::GetChunkVersion::V1);
-      auto filter_table = filter_result.value();
-      int count = filter_table->num_rows();
-      if (count != 0 && new_valid_chunk != nullptr) {
-        new_valid_chunk->emplace_back(static_cast<IdType>(chunk_idx));
-        // TODO(elssky): record indices
-        int kVertexIndexCol = filter_table->schema()->GetFieldIndex(
-            GeneralParams::kVertexIndexCol);
-        auto column_array = filter_table->column(kVertexIndexCol)->chunk(0);
-        auto int64_array =
-            std::static_pointer_cast<arrow::Int64Array>(column_array);
-        for (int64_t i = 0; i < int64_array->length(); ++i) {
-          if (!int64_array->IsNull(i)) {
-            indices64.push_back(int64_array->Value(i));
-          }
-        }
+  auto vertex_set = std::make_shared<VertexSet>();
+  for (IdType chunk_idx : chunk_indices) {
+    GAR_RETURN_NOT_OK(filter_reader->seek(chunk_idx * chunk_size));
+    GAR_ASSIGN_OR_RAISE(auto filter_table,
+                        filter_reader->GetChunk(GetChunkVersion::V1));
+    if (filter_table->num_rows() == 0) {
+      continue;
+    }
+    if (is_filtered_) {
+      if (new_valid_chunk != nullptr) {
+        new_valid_chunk->push_back(chunk_idx);
       }
+    } else {
+      valid_chunk_.push_back(chunk_idx);
     }
-  } else {
-    for (int chunk_idx = 0; chunk_idx * CHUNK_SIZE < TOT_ROWS_NUM;
-         ++chunk_idx) {
-      auto filter_result =
-          filter_reader->GetChunk(graphar::GetChunkVersion::V1);
-      auto filter_table = filter_result.value();
-      int count = filter_table->num_rows();
-      filter_reader->next_chunk();
-      total_count += count;
-      if (count != 0) {
-        valid_chunk_.emplace_back(static_cast<IdType>(chunk_idx));
-        // TODO(elssky): record indices
-        int kVertexIndexCol = filter_table->schema()->GetFieldIndex(
-            GeneralParams::kVertexIndexCol);
-        auto column_array = filter_table->column(kVertexIndexCol)->chunk(0);
-        auto int64_array =
-            std::static_pointer_cast<arrow::Int64Array>(column_array);
-        for (int64_t i = 0; i < int64_array->length(); ++i) {
-          if (!int64_array->IsNull(i)) {
-            indices64.push_back(int64_array->Value(i));
-          }
+    // the ids of a chunk are added in ascending order as it is read, which
+    // only appends to the last block of the set
+    auto column =
+        filter_table->GetColumnByName(GeneralParams::kVertexIndexCol);
+    for (const auto& chunk : column->chunks()) {
+      auto ids = std::static_pointer_cast<arrow::Int64Array>(chunk);
+      for (int64_t i = 0; i < ids->length(); ++i) {
+        if (!ids->IsNull(i)) {
+          vertex_set->Add(ids->Value(i));
         }
       }
     }
   }
-  // std::cout << "Total valid count: " << total_count << std::endl;
-  return indices64;
+  return vertex_set;
 }
 
 Result<std::shared_ptr<VerticesCollection>>
 VerticesCollection::verticesWithLabel(
     const std::string& filter_label,
     const std::shared_ptr<GraphInfo>& graph_info, const std::string& type) {
-  auto prefix = graph_info->GetPrefix();
-  auto vertex_info = graph_info->GetVertexInfo(type);
-  auto labels = vertex_info->GetLabels();
-  auto vertices_collection =
-      std::make_shared<VerticesCollection>(vertex_info, prefix);
-  vertices_collection->filtered_ids_ =
-      vertices_collection->filter({filter_label}).value();
-  vertices_collection->is_filtered_ = true;
-  return vertices_collection;
+  return verticesWithMultipleLabels(std::vector<std::string>{filter_label},
+                                    graph_info, type);
 }
 
 Result<std::shared_ptr<VerticesCollection>>
@@ -350,12 +400,12 @@ VerticesCollection::verticesWithLabelbyAcero(
     const std::shared_ptr<GraphInfo>& graph_info, const std::string& type) {
   auto prefix = graph_info->GetPrefix();
   auto vertex_info = graph_info->GetVertexInfo(type);
-  auto labels = vertex_info->GetLabels();
   auto vertices_collection =
       std::make_shared<VerticesCollection>(vertex_info, prefix);
-  vertices_collection->filtered_ids_ =
-      vertices_collection->filter_by_acero({filter_label}).value();
-  vertices_collection->is_filtered_ = true;
+  GAR_ASSIGN_OR_RAISE(auto filtered_ids,
+                      vertices_collection->filter_by_acero({filter_label}));
+  vertices_collection->SetFiltered(
+      VertexSet::FromIds(std::move(filtered_ids)));
   return vertices_collection;
 }
 
@@ -363,44 +413,37 @@ Result<std::shared_ptr<VerticesCollection>>
 VerticesCollection::verticesWithLabel(
     const std::string& filter_label,
     const std::shared_ptr<VerticesCollection>& vertices_collection) {
-  auto new_vertices_collection = std::make_shared<VerticesCollection>(
-      vertices_collection->vertex_info_, vertices_collection->prefix_);
-  auto filtered_ids =
-      new_vertices_collection
-          ->filter({filter_label}, &new_vertices_collection->valid_chunk_)
-          .value();
-  if (vertices_collection->is_filtered_) {
-    std::unordered_set<IdType> origin_set(
-        vertices_collection->filtered_ids_.begin(),
-        vertices_collection->filtered_ids_.end());
-    std::unordered_set<int> intersection;
-    for (int num : filtered_ids) {
-      if (origin_set.count(num)) {
-        intersection.insert(num);
-      }
-    }
-    filtered_ids =
-        std::vector<IdType>(intersection.begin(), intersection.end());
+  return verticesWithMultipleLabels(std::vector<std::string>{filter_label},
+                                    vertices_collection);
+}
 
-    new_vertices_collection->is_filtered_ = true;
+Result<std::shared_ptr<VerticesCollection>>
+VerticesCollection::verticesWithMultipleLabels(
+    const std::vector<std::string>& filter_labels,
+    const std::shared_ptr<GraphInfo>& graph_info, const std::string& type) {
+  auto vertex_info = graph_info->GetVertexInfo(type);
+  if (!vertex_info) {
+    return Status::KeyError("The vertex ", type, " doesn't exist.");
   }
-  new_vertices_collection->filtered_ids_ = filtered_ids;
-
-  return new_vertices_collection;
+  GAR_ASSIGN_OR_RAISE(auto predicate, AllOfKnownLabels(vertex_info->GetLabels(),
+                                                       filter_labels));
+  return verticesWithMultipleLabels(predicate, graph_info, type);
 }
 
 Result<std::shared_ptr<VerticesCollection>>
 VerticesCollection::verticesWithMultipleLabels(
-    const std::vector<std::string>& filter_labels,
+    const std::shared_ptr<LabelPredicate>& predicate,
     const std::shared_ptr<GraphInfo>& graph_info, const std::string& type) {
   auto prefix = graph_info->GetPrefix();
   auto vertex_info = graph_info->GetVertexInfo(type);
-  auto labels = vertex_info->GetLabels();
+  if (!vertex_info) {
+    return Status::KeyError("The vertex ", type, " doesn't exist.");
+  }
   auto vertices_collection =
       std::make_shared<VerticesCollection>(vertex_info, prefix);
-  vertices_collection->filtered_ids_ =
-      vertices_collection->filter(filter_labels).value();
-  vertices_collection->is_filtered_ = true;
+  GAR_ASSIGN_OR_RAISE(auto vertex_set,
+                      vertices_collection->filterSet(predicate));
+  vertices_collection->SetFiltered(std::move(*vertex_set));
   return vertices_collection;
 }
 
@@ -410,12 +453,12 @@ VerticesCollection::verticesWithMultipleLabelsbyAcero(
     const std::shared_ptr<GraphInfo>& graph_info, const std::string& type) {
   auto prefix = graph_info->GetPrefix();
   auto vertex_info = graph_info->GetVertexInfo(type);
-  auto labels = vertex_info->GetLabels();
   auto vertices_collection =
       std::make_shared<VerticesCollection>(vertex_info, prefix);
-  vertices_collection->filtered_ids_ =
-      vertices_collection->filter_by_acero(filter_labels).value();
-  vertices_collection->is_filtered_ = true;
+  GAR_ASSIGN_OR_RAISE(auto filtered_ids,
+                      vertices_collection->filter_by_acero(filter_labels));
+  vertices_collection->SetFiltered(
+      VertexSet::FromIds(std::move(filtered_ids)));
   return vertices_collection;
 }
 
@@ -423,29 +466,32 @@ Result<std::shared_ptr<VerticesCollection>>
 VerticesCollection::verticesWithMultipleLabels(
     const std::vector<std::string>& filter_labels,
     const std::shared_ptr<VerticesCollection>& vertices_collection) {
+  GAR_ASSIGN_OR_RAISE(auto predicate, AllOfKnownLabels(
+                                          vertices_collection->labels_,
+                                          filter_labels));
+  return verticesWithMultipleLabels(predicate, vertices_collection);
+}
+
+Result<std::shared_ptr<VerticesCollection>>
+VerticesCollection::verticesWithMultipleLabels(
+    const std::shared_ptr<LabelPredicate>& predicate,
+    const std::shared_ptr<VerticesCollection>& vertices_collection) {
   auto new_vertices_collection = std::make_shared<VerticesCollection>(
       vertices_collection->vertex_info_, vertices_collection->prefix_);
-  auto filtered_ids =
-      vertices_collection
-          ->filter(filter_labels, &new_vertices_collection->valid_chunk_)
-          .value();
-  if (vertices_collection->is_filtered_) {
-    std::unordered_set<IdType> origin_set(
-        vertices_collection->filtered_ids_.begin(),
-        vertices_collection->filtered_ids_.end());
-    std::unordered_set<int> intersection;
-    for (int num : filtered_ids) {
-      if (origin_set.count(num)) {
-        intersection.insert(num);
-      }
-    }
-    filtered_ids =
-        std::vector<IdType>(intersection.begin(), intersection.end());
-
-    new_vertices_collection->is_filtered_ = true;
+  if (!vertices_collection->is_filtered_) {
+    GAR_ASSIGN_OR_RAISE(auto vertex_set,
+                        new_vertices_collection->filterSet(predicate));
+    new_vertices_collection->SetFiltered(std::move(*vertex_set));
+    return new_vertices_collection;
   }
-  new_vertices_collection->filtered_ids_ = filtered_ids;
-
+  // only the chunks of the collection are filtered, and the result is
+  // intersected with its set
+  new_vertices_collection->valid_chunk_ = vertices_collection->valid_chunk_;
+  new_vertices_collection->is_filtered_ = true;
+  GAR_ASSIGN_OR_RAISE(auto vertex_set,
+                      new_vertices_collection->filterSet(predicate));
+  new_vertices_collection->SetFiltered(VertexSet::Intersect(
+      *vertex_set, *vertices_collection->filtered_ids_));
   return new_vertices_collection;
 }
 
@@ -457,9 +503,9 @@ VerticesCollection::verticesWithProperty(
   auto vertex_info = graph_info->GetVertexInfo(type);
   auto vertices_collection =
       std::make_shared<VerticesCollection>(vertex_info, prefix);
-  vertices_collection->filtered_ids_ =
-      vertices_collection->filter(property_name, filter).value();
-  vertices_collection->is_filtered_ = true;
+  GAR_ASSIGN_OR_RAISE(auto vertex_set,
+                      vertices_collection->filterSet(property_name, filter));
+  vertices_collection->SetFiltered(std::move(*vertex_set));
   return vertices_collection;
 }
 
@@ -469,28 +515,30 @@ VerticesCollection::verticesWithProperty(
     const std::shared_ptr<VerticesCollection>& vertices_collection) {
   auto new_vertices_collection = std::make_shared<VerticesCollection>(
       vertices_collection->vertex_info_, vertices_collection->prefix_);
-  auto filtered_ids = vertices_collection
-                          ->filter(property_name, filter,
-                                   &new_vertices_collection->valid_chunk_)
-                          .value();
+  std::vector<IdType> valid_chunks;
+  GAR_ASSIGN_OR_RAISE(
+      auto vertex_set,
+      vertices_collection->filterSet(property_name, filter, &valid_chunks));
   if (vertices_collection->is_filtered_) {
-    std::unordered_set<IdType> origin_set(
-        vertices_collection->filtered_ids_.begin(),
-        vertices_collection->filtered_ids_.end());
-    std::unordered_set<int> intersection;
-    for (int num : filtered_ids) {
-      if (origin_set.count(num)) {
-        intersection.insert(num);
-      }
-    }
-    filtered_ids =
-        std::vector<IdType>(intersection.begin(), intersection.end());
-    new_vertices_collection->is_filtered_ = true;
+    *vertex_set =
+        VertexSet::Intersect(*vertex_set, *vertices_collection->filtered_ids_);
   }
-  new_vertices_collection->filtered_ids_ = filtered_ids;
+  new_vertices_collection->SetFiltered(std::move(*vertex_set));
   return new_vertices_collection;
 }
 
+void VerticesCollection::SetFiltered(VertexSet vertex_set) {
+  // the chunks that have a vertex of the set
+  valid_chunk_.clear();
+  const IdType chunk_size = vertex_info_->GetChunkSize();
+  for (IdType id = vertex_set.Select(0); id >= 0;
+       id = vertex_set.Next((id / chunk_size + 1) * chunk_size - 1)) {
+    valid_chunk_.push_back(id / chunk_size);
+  }
+  filtered_ids_ = std::make_shared<const VertexSet>(std::move(vertex_set));
+  is_filtered_ = true;
+}
+
 template <typename T>
 Result<T> Vertex::property(const std::string& property) const {
   if constexpr (std::is_final<T>::value) {
@@ -592,12 +640,41 @@ Edge::Edge(
         auto type = DataType::ArrowDataTypeToDataType(field->type());
         GAR_RAISE_ERROR_NOT_OK(TryToCastToAny(type,
                                               chunk_table->column(i)->chunk(0),
-                                              properties_[field->name()]));
+                                              0, properties_[field->name()]));
       }
     }
   }
 }
 
+Edge::Edge(EdgeChunkCursor& cursor, int64_t row)  // NOLINT
+    : src_id_(cursor.sources()[row]), dst_id_(cursor.destinations()[row]) {
+  GAR_ASSIGN_OR_RAISE_ERROR(auto chunk_table, cursor.GetProperties());
+  if (chunk_table == nullptr) {
+    return;
+  }
+  // the property columns of the cursor are combined into a single chunk
+  for (int i = 0; i < chunk_table->num_columns(); ++i) {
+    auto field = chunk_table->field(i);
+    auto array = chunk_table->column(i)->chunk(0);
+    if (field->type()->id() == arrow::Type::LIST) {
+      auto list_array = std::dynamic_pointer_cast<arrow::ListArray>(array);
+      list_properties_[field->name()] = list_array->value_slice(row);
+    } else {
+      auto type = DataType::ArrowDataTypeToDataType(field->type());
+      GAR_RAISE_ERROR_NOT_OK(
+          TryToCastToAny(type, array, row, properties_[field->name()]));
+    }
+  }
+}
+
+Edge::Edge(const EdgeView& view)
+    : src_id_(view.source()), dst_id_(view.destination()) {
+  if (view.chunk() != nullptr) {
+    GAR_RAISE_ERROR_NOT_OK(CastRowToAny(*view.chunk(), view.row(),
+                                        properties_, list_properties_));
+  }
+}
+
 template <typename T>
 Result<T> Edge::property(const std::string& property) const {
   if constexpr (std::is_final<T>::value) {
@@ -694,22 +771,6 @@ INSTANTIATE_PROPERTY(DoubleArray)
 INSTANTIATE_PROPERTY(std::string)
 INSTANTIATE_PROPERTY(const std::string&)
 
-IdType EdgeIter::source() {
-  adj_list_reader_.seek(cur_offset_);
-  GAR_ASSIGN_OR_RAISE_ERROR(auto chunk, adj_list_reader_.GetChunk());
-  auto src_column = chunk->column(0);
-  return std::dynamic_pointer_cast<arrow::Int64Array>(src_column->chunk(0))
-      ->GetView(0);
-}
-
-IdType EdgeIter::destination() {
-  adj_list_reader_.seek(cur_offset_);
-  GAR_ASSIGN_OR_RAISE_ERROR(auto chunk, adj_list_reader_.GetChunk());
-  auto src_column = chunk->column(1);
-  return std::dynamic_pointer_cast<arrow::Int64Array>(src_column->chunk(0))
-      ->GetView(0);
-}
-
 bool EdgeIter::first_src(const EdgeIter& from, IdType id) {
   if (from.is_end())
     return false;
@@ -781,14 +842,12 @@ bool EdgeIter::first_src(const EdgeIter& from, IdType id) {
   if (!st.ok()) {
     return false;
   }
-  auto maybe_offset_chunk = offset_reader_->GetChunk();
-  if (!maybe_offset_chunk.status().ok()) {
+  auto maybe_range = offset_reader_->GetRange();
+  if (!maybe_range.status().ok()) {
     return false;
   }
-  auto offset_array =
-      std::dynamic_pointer_cast<arrow::Int64Array>(maybe_offset_chunk.value());
-  auto begin_offset = static_cast<IdType>(offset_array->Value(0));
-  auto end_offset = static_cast<IdType>(offset_array->Value(1));
+  auto begin_offset = maybe_range.value().first;
+  auto end_offset = maybe_range.value().second;
   if (begin_offset >= end_offset) {
     return false;
   }
@@ -896,14 +955,12 @@ bool EdgeIter::first_dst(const EdgeIter& from, IdType id) {
   if (!st.ok()) {
     return false;
   }
-  auto maybe_offset_chunk = offset_reader_->GetChunk();
-  if (!maybe_offset_chunk.status().ok()) {
+  auto maybe_range = offset_reader_->GetRange();
+  if (!maybe_range.status().ok()) {
     return false;
   }
-  auto offset_array =
-      std::dynamic_pointer_cast<arrow::Int64Array>(maybe_offset_chunk.value());
-  auto begin_offset = static_cast<IdType>(offset_array->Value(0));
-  auto end_offset = static_cast<IdType>(offset_array->Value(1));
+  auto begin_offset = maybe_range.value().first;
+  auto end_offset = maybe_range.value().second;
   if (begin_offset >= end_offset) {
     return false;
   }
@@ -978,4 +1035,178 @@ Result<std::shared_ptr<EdgesCollection>> EdgesCollection::Make(
   return Status::OK();
 }
 
+namespace {
+// merge consecutive ranges into at most num_parts ranges of about the same
+// number of elements
+std::vector<ChunkRange> MergeChunkRanges(const std::vector<ChunkRange>& ranges,
+                                         int num_parts) {
+  num_parts = std::max(num_parts, 1);
+  IdType total = 0;
+  for (const auto& range : ranges) {
+    total += range.size;
+  }
+  std::vector<ChunkRange> parts;
+  for (const auto& range : ranges) {
+    // part k begins at the first range past the k-th quantile of the elements
+    IdType num = static_cast<IdType>(parts.size());
+    if (parts.empty() ||
+        (num < num_parts && range.offset >= total * num / num_parts)) {
+      parts.push_back(range);
+      continue;
+    }
+    parts.back().chunk_end = range.chunk_end;
+    parts.back().size += range.size;
+  }
+  return parts;
+}
+
+// Run the workers on a thread pool of their own. A worker takes the ranges
+// one by one and processes them by the function made for it, until all the
+// ranges are taken or a range fails.
+Status RunOnChunkRanges(
+    const std::vector<ChunkRange>& ranges, int num_threads,
+    const std::function<std::function<Status(const ChunkRange&)>(int)>&
+        make_worker) {
+  num_threads = static_cast<int>(
+      std::min<size_t>(std::max(num_threads, 1), ranges.size()));
+  if (num_threads == 0) {
+    return Status::OK();
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto pool, arrow::internal::ThreadPool::Make(num_threads));
+  std::atomic<size_t> next_range(0);
+  std::atomic<bool> failed(false);
+  std::mutex mutex;
+  Status status = Status::OK();
+  auto fail = [&](Status error) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (status.ok()) {
+      status = std::move(error);
+    }
+    failed = true;
+  };
+  std::vector<arrow::Future<>> futures;
+  for (int worker = 0; worker < num_threads; ++worker) {
+    auto maybe_future = pool->Submit([&, worker]() {
+      try {
+        auto process = make_worker(worker);
+        for (size_t i = next_range++; i < ranges.size() && !failed;
+             i = next_range++) {
+          Status st = process(ranges[i]);
+          if (!st.ok()) {
+            fail(std::move(st));
+          }
+        }
+      } catch (const std::exception& e) {
+        fail(Status::UnknownError(e.what()));
+      }
+    });
+    if (!maybe_future.ok()) {
+      fail(Status::ArrowError(maybe_future.status().ToString()));
+      break;
+    }
+    futures.push_back(std::move(maybe_future).ValueUnsafe());
+  }
+  // the workers refer to the locals, wait for all of them before returning
+  for (auto& future : futures) {
+    future.Wait();
+  }
+  return status;
+}
+}  // namespace
+
+Result<std::vector<ChunkRange>> VerticesCollection::partition(
+    int num_parts) const {
+  const IdType chunk_size = vertex_info_->GetChunkSize();
+  std::vector<ChunkRange> chunks;
+  if (!is_filtered_) {
+    for (IdType begin = 0; begin < vertex_num_; begin += chunk_size) {
+      IdType chunk_index = begin / chunk_size;
+      chunks.push_back({chunk_index, chunk_index + 1, begin,
+                        std::min(chunk_size, vertex_num_ - begin)});
+    }
+    return MergeChunkRanges(chunks, num_parts);
+  }
+  // the chunks that have a vertex of the set, the offset of a vertex in the
+  // collection is its rank in the set
+  for (IdType id = filtered_ids_->Select(0); id >= 0;
+       id = filtered_ids_->Next((id / chunk_size + 1) * chunk_size - 1)) {
+    IdType chunk_index = id / chunk_size;
+    IdType begin = filtered_ids_->Rank(id);
+    IdType end = filtered_ids_->Rank((chunk_index + 1) * chunk_size);
+    chunks.push_back({chunk_index, chunk_index + 1, begin, end - begin});
+  }
+  return MergeChunkRanges(chunks, num_parts);
+}
+
+Result<std::vector<ChunkRange>> EdgesCollection::partition(
+    int num_parts) const {
+  GAR_ASSIGN_OR_RAISE(
+      auto count_index,
+      GraphCountIndex::Get(prefix_, edge_info_, adj_list_type_));
+  const auto& edge_nums = count_index->GetEdgeNums();
+  const IdType chunk_size = edge_info_->GetChunkSize();
+  // weight the edge chunks by their numbers of edges, the last edge chunk of
+  // a vertex chunk is partially filled
+  std::vector<ChunkRange> chunks;
+  IdType offset = 0;
+  for (IdType i = chunk_begin_; i < chunk_end_; ++i) {
+    auto index_pair = index_converter_->GlobalChunkIndexToIndexPair(i);
+    IdType size =
+        std::min(chunk_size,
+                 edge_nums[index_pair.first] - index_pair.second * chunk_size);
+    chunks.push_back({i, i + 1, offset, size});
+    offset += size;
+  }
+  return MergeChunkRanges(chunks, num_parts);
+}
+
+EdgeIter EdgesCollection::rangeBegin(const ChunkRange& range) const {
+  EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_begin_, 0,
+                chunk_begin_, chunk_end_, index_converter_, layout_);
+  iter.seek_range(range.chunk_begin, range.chunk_end);
+  return iter;
+}
+
+Status ParallelForEachChunk(
+    VerticesCollection& vertices,
+    const std::function<Status(VertexIter& it, IdType count, int worker)>& fn,
+    int num_threads) {
+  if (num_threads <= 0) {
+    num_threads = arrow::GetCpuThreadPoolCapacity();
+  }
+  // more ranges than workers, to balance the workers by taking the ranges
+  GAR_ASSIGN_OR_RAISE(auto ranges, vertices.partition(num_threads * 4));
+  return RunOnChunkRanges(ranges, num_threads, [&](int worker) {
+    // the readers of the worker, which are copied to its iterators
+    auto begin = std::make_shared<VertexIter>(vertices.begin());
+    return [begin, &fn, worker](const ChunkRange& range) {
+      VertexIter it = *begin + range.offset;
+      return fn(it, range.size, worker);
+    };
+  });
+}
+
+Status ParallelForEachChunk(
+    EdgesCollection& edges,
+    const std::function<Status(EdgeIter& it, IdType count, int worker)>& fn,
+    int num_threads) {
+  if (num_threads <= 0) {
+    num_threads = arrow::GetCpuThreadPoolCapacity();
+  }
+  GAR_ASSIGN_OR_RAISE(auto ranges, edges.partition(num_threads * 4));
+  return RunOnChunkRanges(ranges, num_threads, [&](int worker) {
+    // the iterator of the worker, moved to the range it takes
+    std::shared_ptr<EdgeIter> it;
+    return [it, &edges, &fn, worker](const ChunkRange& range) mutable {
+      if (it == nullptr) {
+        it = std::make_shared<EdgeIter>(edges.rangeBegin(range));
+      } else {
+        it->seek_range(range.chunk_begin, range.chunk_end);
+      }
+      return fn(*it, range.size, worker);
+    };
+  });
+}
+
 }  // namespace graphar
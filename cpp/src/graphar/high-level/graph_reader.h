@@ -20,19 +20,24 @@
 #pragma once
 
 #include <any>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "graphar/arrow/chunk_reader.h"
 #include "graphar/filesystem.h"
+#include "graphar/graph_count_index.h"
 #include "graphar/graph_info.h"
+#include "graphar/high-level/property_chunk.h"
 #include "graphar/reader_util.h"
 #include "graphar/types.h"
 #include "graphar/util.h"
+#include "graphar/vertex_set.h"
 
 // forward declarations
 namespace arrow {
@@ -42,6 +47,141 @@ class Array;
 
 namespace graphar {
 
+/**
+ * @brief A view of a vertex in a loaded chunk, valid as long as the iterator
+ * that made it stays in the chunk.
+ *
+ * The view is a row of the chunk, its properties are read from the columns of
+ * the chunk on access without copying the row.
+ */
+class VertexView {
+ public:
+  /**
+   * Initialize the view.
+   *
+   * @param id The vertex id.
+   * @param chunk The chunk of the vertex.
+   * @param row The row of the vertex in the chunk.
+   */
+  VertexView(IdType id, const PropertyChunk* chunk, int64_t row) noexcept
+      : id_(id), chunk_(chunk), row_(row) {}
+
+  /** @brief Get the id of the vertex. */
+  IdType id() const noexcept { return id_; }
+
+  /**
+   * @brief Get the property value of the vertex, a string is read as a
+   * std::string_view into the chunk.
+   *
+   * @param property The property name.
+   * @return Result: The property value or error.
+   */
+  template <typename T>
+  Result<T> property(const std::string& property) const {
+    int index = chunk_->layout().GetIndex(property);
+    if (!chunk_->HasColumn(index)) {
+      return Status::KeyError("Property with name ", property,
+                              " does not exist in the vertex.");
+    }
+    return chunk_->GetValue<T>(index, row_);
+  }
+
+  /**
+   * @brief Return true if value at the property is valid (not null).
+   *
+   * @param property The property name.
+   * @return True if value at the property is valid, False otherwise.
+   */
+  bool IsValid(const std::string& property) const {
+    int index = chunk_->layout().GetIndex(property);
+    if (!chunk_->HasColumn(index)) {
+      throw std::invalid_argument("Property with name " + property +
+                                  " does not exist in the vertex.");
+    }
+    return !chunk_->column(index).IsNull(row_);
+  }
+
+  /** @brief Get the chunk of the vertex. */
+  const PropertyChunk& chunk() const noexcept { return *chunk_; }
+
+  /** @brief Get the row of the vertex in its chunk. */
+  int64_t row() const noexcept { return row_; }
+
+ private:
+  IdType id_;
+  const PropertyChunk* chunk_;
+  int64_t row_;
+};
+
+/**
+ * @brief A view of an edge in a loaded chunk, valid as long as the iterator
+ * that made it stays in the chunk.
+ */
+class EdgeView {
+ public:
+  /**
+   * Initialize the view.
+   *
+   * @param src_id The id of the source vertex.
+   * @param dst_id The id of the destination vertex.
+   * @param chunk The property chunk of the edge, nullptr if the edge type has
+   * no property.
+   * @param row The row of the edge in the chunk.
+   */
+  EdgeView(IdType src_id, IdType dst_id, const PropertyChunk* chunk,
+           int64_t row) noexcept
+      : src_id_(src_id), dst_id_(dst_id), chunk_(chunk), row_(row) {}
+
+  /** @brief Get source id of the edge. */
+  IdType source() const noexcept { return src_id_; }
+
+  /** @brief Get destination id of the edge. */
+  IdType destination() const noexcept { return dst_id_; }
+
+  /**
+   * @brief Get the property value of the edge, a string is read as a
+   * std::string_view into the chunk.
+   *
+   * @param property The property name.
+   * @return Result: The property value or error.
+   */
+  template <typename T>
+  Result<T> property(const std::string& property) const {
+    int index = chunk_ == nullptr ? -1 : chunk_->layout().GetIndex(property);
+    if (index < 0 || !chunk_->HasColumn(index)) {
+      return Status::KeyError("Property with name ", property,
+                              " does not exist in the edge.");
+    }
+    return chunk_->GetValue<T>(index, row_);
+  }
+
+  /**
+   * @brief Return true if value at the property is valid (not null).
+   *
+   * @param property The property name.
+   * @return True if value at the property is valid, False otherwise.
+   */
+  bool IsValid(const std::string& property) const {
+    int index = chunk_ == nullptr ? -1 : chunk_->layout().GetIndex(property);
+    if (index < 0 || !chunk_->HasColumn(index)) {
+      throw std::invalid_argument("Property with name " + property +
+                                  " does not exist in the edge.");
+    }
+    return !chunk_->column(index).IsNull(row_);
+  }
+
+  /** @brief Get the property chunk of the edge, nullptr if there is none. */
+  const PropertyChunk* chunk() const noexcept { return chunk_; }
+
+  /** @brief Get the row of the edge in its chunk. */
+  int64_t row() const noexcept { return row_; }
+
+ private:
+  IdType src_id_, dst_id_;
+  const PropertyChunk* chunk_;
+  int64_t row_;
+};
+
 /**
  * @brief Vertex contains information of certain vertex.
  */
@@ -57,6 +197,13 @@ class Vertex {
       IdType id,
       std::vector<VertexPropertyArrowChunkReader>& readers);  // NOLINT
 
+  /**
+   * Initialize the Vertex with the values of a vertex view.
+   *
+   * @param view The view of the vertex.
+   */
+  explicit Vertex(const VertexView& view);
+
   /**
    * @brief Get the id of the vertex.
    *
@@ -118,6 +265,21 @@ class Edge {
                 std::vector<AdjListPropertyArrowChunkReader>&
                     property_readers);  // NOLINT
 
+  /**
+   * Initialize the Edge from a row of the chunk loaded by an edge cursor.
+   *
+   * @param cursor The cursor that holds the current edge chunk.
+   * @param row The row of the edge in the current edge chunk.
+   */
+  explicit Edge(EdgeChunkCursor& cursor, int64_t row);  // NOLINT
+
+  /**
+   * Initialize the Edge with the values of an edge view.
+   *
+   * @param view The view of the edge.
+   */
+  explicit Edge(const EdgeView& view);
+
   /**
    * @brief Get source id of the edge.
    *
@@ -176,12 +338,15 @@ class VertexIter {
    * @param vertex_info The vertex info that describes the vertex type.
    * @param prefix The absolute prefix.
    * @param offset The current offset of the readers.
+   * @param layout The property layout of the vertex type, shared by the
+   * iterators of a collection, made from the vertex info if nullptr.
    */
-  explicit VertexIter(const std::shared_ptr<VertexInfo>& vertex_info,
-                      const std::string& prefix, IdType offset,
-                      const std::vector<std::string>& labels,
-                      const bool& is_filtered = false,
-                      const std::vector<IdType>& filtered_ids = {}) noexcept {
+  explicit VertexIter(
+      const std::shared_ptr<VertexInfo>& vertex_info, const std::string& prefix,
+      IdType offset, const std::vector<std::string>& labels,
+      const bool& is_filtered = false,
+      std::shared_ptr<const VertexSet> filtered_ids = nullptr,
+      std::shared_ptr<const PropertyLayout> layout = nullptr) noexcept {
     if (!labels.empty()) {
       labels_ = labels;
       label_reader_ =
@@ -191,76 +356,89 @@ class VertexIter {
       readers_.emplace_back(vertex_info, pg, prefix);
     }
     is_filtered_ = is_filtered;
-    filtered_ids_ = filtered_ids;
+    filtered_ids_ = std::move(filtered_ids);
     cur_offset_ = offset;
+    chunk_size_ = vertex_info->GetChunkSize();
+    layout_ = layout != nullptr ? std::move(layout)
+                                : std::make_shared<const PropertyLayout>(
+                                      vertex_info->GetPropertyGroups());
   }
 
-  /** Copy constructor. */
+  /** Copy constructor, the filtered set and the loaded chunk are shared. */
   VertexIter(const VertexIter& other)
       : readers_(other.readers_),
-        cur_offset_(other.cur_offset_),
-        labels_(other.labels_),
         label_reader_(other.label_reader_),
+        labels_(other.labels_),
+        cur_offset_(other.cur_offset_),
         is_filtered_(other.is_filtered_),
-        filtered_ids_(other.filtered_ids_) {}
+        filtered_ids_(other.filtered_ids_),
+        cached_offset_(other.cached_offset_),
+        cached_id_(other.cached_id_),
+        chunk_size_(other.chunk_size_),
+        layout_(other.layout_),
+        chunk_(other.chunk_),
+        loaded_chunk_index_(other.loaded_chunk_index_) {}
 
   /** Construct and return the vertex of the current offset. */
-  Vertex operator*() noexcept {
-    if (is_filtered_) {
-      for (auto& reader : readers_) {
-        reader.seek(filtered_ids_[cur_offset_]);
-      }
-    } else {
-      for (auto& reader : readers_) {
-        reader.seek(cur_offset_);
-      }
-    }
+  Vertex operator*() noexcept { return Vertex(view()); }
 
-    return Vertex(cur_offset_, readers_);
+  /**
+   * @brief Get the view of the vertex of the current offset, which reads the
+   * properties from the loaded chunk without copying them. The view is valid
+   * until the iterator moves to another chunk.
+   */
+  VertexView view() {
+    IdType vid = id();
+    GAR_RAISE_ERROR_NOT_OK(load(vid));
+    return VertexView(vid, chunk_.get(),
+                      vid - loaded_chunk_index_ * chunk_size_);
   }
 
   /** Get the vertex id of the current offset. */
   IdType id() {
-    if (is_filtered_) {
-      return filtered_ids_[cur_offset_];
-    } else {
+    if (!is_filtered_) {
       return cur_offset_;
     }
+    // a step forward takes the next member instead of selecting by rank
+    if (cur_offset_ != cached_offset_) {
+      cached_id_ = cur_offset_ == cached_offset_ + 1 && cached_offset_ >= 0
+                       ? filtered_ids_->Next(cached_id_)
+                       : filtered_ids_->Select(cur_offset_);
+      cached_offset_ = cur_offset_;
+    }
+    return cached_id_;
   }
 
   /** Get the value for a property of the current vertex. */
   template <typename T>
   Result<T> property(const std::string& property) noexcept {
-    std::shared_ptr<arrow::ChunkedArray> column(nullptr);
-    if (is_filtered_) {
-      for (auto& reader : readers_) {
-        reader.seek(filtered_ids_[cur_offset_]);
-        GAR_ASSIGN_OR_RAISE(auto chunk_table,
-                            reader.GetChunk(graphar::GetChunkVersion::V1));
-        column = util::GetArrowColumnByName(chunk_table, property);
-        if (column != nullptr) {
-          break;
-        }
-      }
-    } else {
-      for (auto& reader : readers_) {
-        reader.seek(cur_offset_);
-        GAR_ASSIGN_OR_RAISE(auto chunk_table,
-                            reader.GetChunk(graphar::GetChunkVersion::V1));
-        column = util::GetArrowColumnByName(chunk_table, property);
-        if (column != nullptr) {
-          break;
-        }
-      }
-    }
+    IdType vid = id();
+    GAR_RETURN_NOT_OK(load(vid));
+    return VertexView(vid, chunk_.get(),
+                      vid - loaded_chunk_index_ * chunk_size_)
+        .property<T>(property);
+  }
 
-    if (column != nullptr) {
-      auto array = util::GetArrowArrayByChunkIndex(column, 0);
-      GAR_ASSIGN_OR_RAISE(auto data, util::GetArrowArrayData(array));
-      return util::ValueGetter<T>::Value(data, 0);
-    }
-    return Status::KeyError("Property with name ", property,
-                            " does not exist in the vertex.");
+  /**
+   * @brief Get the value of a resolved property of the current vertex, a
+   * typed load from the loaded chunk. The value of a null is unspecified,
+   * check a nullable property with isNull first.
+   *
+   * @param handle The handle from VerticesCollection::propertyHandle.
+   * @return The value, throws if the data of the chunk is not of type T.
+   */
+  template <typename T>
+  T get(const PropertyHandle<T>& handle) {
+    int64_t row;
+    const ColumnView& column = locate(handle, &row);
+    return RowValue<T>::Load(column, row);
+  }
+
+  /** Whether the value of a resolved property of the current vertex is null. */
+  template <typename T>
+  bool isNull(const PropertyHandle<T>& handle) {
+    int64_t row;
+    return locate(handle, &row).IsNull(row);
   }
 
   /** Determine whether a vertex has the input label. */
@@ -305,13 +483,60 @@ class VertexIter {
     return cur_offset_ != rhs.cur_offset_;
   }
 
+ private:
+  // Load the property chunk of the vertex if it is not loaded yet.
+  Status load(IdType vid);
+
+  // Get the column of a handle in the loaded chunk and the row of the
+  // current vertex in it, throws if the value can not be loaded as T.
+  template <typename T>
+  const ColumnView& locate(const PropertyHandle<T>& handle, int64_t* row) {
+    IdType vid = id();
+    *row = vid - loaded_chunk_index_ * chunk_size_;
+    if (chunk_ == nullptr || *row < 0 || *row >= chunk_size_) {
+      GAR_RAISE_ERROR_NOT_OK(load(vid));
+      *row = vid - loaded_chunk_index_ * chunk_size_;
+    }
+    int index = handle.index();
+    if (!chunk_->HasColumn(index) ||
+        !RowValue<T>::Match(chunk_->column(index)) ||
+        *row >= chunk_->column(index).length) {
+      // report why the value can not be loaded
+      GAR_RAISE_ERROR_NOT_OK(chunk_->GetValue<T>(index, *row));
+    }
+    return chunk_->column(index);
+  }
+
  private:
   std::vector<VertexPropertyArrowChunkReader> readers_;
   VertexPropertyArrowChunkReader label_reader_;
   std::vector<std::string> labels_;
   IdType cur_offset_;
   bool is_filtered_;
-  std::vector<IdType> filtered_ids_;
+  std::shared_ptr<const VertexSet> filtered_ids_;
+  // the id of the last visited offset of the filtered set
+  IdType cached_offset_ = -1;
+  IdType cached_id_ = -1;
+  IdType chunk_size_;
+  std::shared_ptr<const PropertyLayout> layout_;
+  // the properties of the vertex chunk of loaded_chunk_index_
+  std::shared_ptr<const PropertyChunk> chunk_;
+  IdType loaded_chunk_index_ = -1;
+};
+
+/**
+ * @brief A range of consecutive chunks of a collection, the unit of work of
+ * iterating a collection in parallel.
+ */
+struct ChunkRange {
+  /// The chunks [chunk_begin, chunk_end), the vertex chunk indices of
+  /// vertices or the global edge chunk indices of edges
+  IdType chunk_begin = 0;
+  IdType chunk_end = 0;
+  /// The position of the first element of the range in the collection
+  IdType offset = 0;
+  /// The number of elements of the range
+  IdType size = 0;
 };
 
 /**
@@ -330,12 +555,15 @@ class VerticesCollection {
   explicit VerticesCollection(const std::shared_ptr<VertexInfo>& vertex_info,
                               const std::string& prefix,
                               const bool is_filtered = false,
-                              const std::vector<IdType> filtered_ids = {})
+                              std::vector<IdType> filtered_ids = {})
       : vertex_info_(std::move(vertex_info)),
         prefix_(prefix),
         labels_(vertex_info->GetLabels()),
         is_filtered_(is_filtered),
-        filtered_ids_(filtered_ids) {
+        filtered_ids_(std::make_shared<VertexSet>(
+            VertexSet::FromIds(std::move(filtered_ids)))),
+        layout_(std::make_shared<const PropertyLayout>(
+            vertex_info->GetPropertyGroups())) {
     // get the vertex num
     std::string base_dir;
     GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
@@ -350,36 +578,81 @@ class VerticesCollection {
   /** The iterator pointing to the first vertex. */
   VertexIter begin() noexcept {
     return VertexIter(vertex_info_, prefix_, 0, labels_, is_filtered_,
-                      filtered_ids_);
+                      filtered_ids_, layout_);
   }
 
   /** The iterator pointing to the past-the-end element. */
   VertexIter end() noexcept {
     if (is_filtered_)
-      return VertexIter(vertex_info_, prefix_, filtered_ids_.size(), labels_,
-                        is_filtered_, filtered_ids_);
+      return VertexIter(vertex_info_, prefix_, filtered_ids_->Size(), labels_,
+                        is_filtered_, filtered_ids_, layout_);
     return VertexIter(vertex_info_, prefix_, vertex_num_, labels_, is_filtered_,
-                      filtered_ids_);
+                      filtered_ids_, layout_);
   }
 
   /** The iterator pointing to the vertex with specific id. */
   VertexIter find(IdType id) {
-    return VertexIter(vertex_info_, prefix_, id, labels_);
+    return VertexIter(vertex_info_, prefix_, id, labels_, false, nullptr,
+                      layout_);
   }
 
   /** Get the number of vertices in the collection. */
   size_t size() const noexcept {
     if (is_filtered_)
-      return filtered_ids_.size();
+      return filtered_ids_->Size();
     else
       return vertex_num_;
   }
 
+  /**
+   * @brief The set of the vertices of a filtered collection, shared with its
+   * iterators, or nullptr if the collection is not filtered.
+   */
+  std::shared_ptr<const VertexSet> vertexSet() const noexcept {
+    return is_filtered_ ? filtered_ids_ : nullptr;
+  }
+
+  /**
+   * @brief Split the vertices into ranges of consecutive vertex chunks with
+   * about the same number of vertices, to iterate them in parallel.
+   *
+   * @param num_parts The maximum number of ranges.
+   * @return The ranges in the order of the collection, a range of a filtered
+   * collection only counts the vertices of the set.
+   */
+  Result<std::vector<ChunkRange>> partition(int num_parts) const;
+
+  /**
+   * @brief Resolve a property of the vertices into a handle of values of
+   * type T, which is read by VertexIter::get.
+   *
+   * @param name The property name.
+   * @return The handle, or KeyError if there is no such property, TypeError
+   * if the property is not of type T.
+   */
+  template <typename T>
+  Result<PropertyHandle<T>> propertyHandle(const std::string& name) const {
+    return layout_->GetHandle<T>(name);
+  }
+
   /** The vertex id list that satisfies the label filter condition. */
   Result<std::vector<IdType>> filter(
       std::vector<std::string> filter_labels,
       std::vector<IdType>* new_valid_chunk = nullptr);
 
+  /** The vertex id list that satisfies the label predicate. */
+  Result<std::vector<IdType>> filter(
+      const std::shared_ptr<LabelPredicate>& predicate,
+      std::vector<IdType>* new_valid_chunk = nullptr);
+
+  /**
+   * @brief The set of the vertices that satisfy the label predicate, built
+   * from the bitmap of the label filter without listing the ids.
+   */
+  Result<std::shared_ptr<VertexSet>> filterSet(
+      const std::shared_ptr<LabelPredicate>& predicate,
+      std::vector<IdType>* new_valid_chunk = nullptr);
+
   Result<std::vector<IdType>> filter_by_acero(
       std::vector<std::string> filter_labels) const;
 
@@ -387,6 +660,15 @@ class VerticesCollection {
       std::string property_name, std::shared_ptr<Expression> filter_expression,
       std::vector<IdType>* new_valid_chunk = nullptr);
 
+  /**
+   * @brief The set of the vertices whose property satisfies the filter,
+   * built chunk by chunk as the filtered chunks are read.
+   */
+  Result<std::shared_ptr<VertexSet>> filterSet(
+      const std::string& property_name,
+      const std::shared_ptr<Expression>& filter_expression,
+      std::vector<IdType>* new_valid_chunk = nullptr);
+
   /**
    * @brief Query vertices with a specific label
    *
@@ -431,6 +713,21 @@ class VerticesCollection {
       const std::vector<std::string>& filter_labels,
       const std::shared_ptr<GraphInfo>& graph_info, const std::string& type);
 
+  /**
+   * @brief Query vertices by a boolean predicate over their labels, e.g.,
+   * (Person AND NOT Bot) OR Admin
+   *
+   * @param predicate The label predicate, see LabelPredicate
+   * @param graph_info A smart pointer to GraphInfo that contains details about
+   * the graph
+   * @param type The type of vertices to query
+   * @return A VerticesCollection containing all vertices that satisfy the
+   * predicate
+   */
+  static Result<std::shared_ptr<VerticesCollection>> verticesWithMultipleLabels(
+      const std::shared_ptr<LabelPredicate>& predicate,
+      const std::shared_ptr<GraphInfo>& graph_info, const std::string& type);
+
   static Result<std::shared_ptr<VerticesCollection>>
   verticesWithMultipleLabelsbyAcero(
       const std::vector<std::string>& filter_labels,
@@ -456,6 +753,19 @@ class VerticesCollection {
       const std::vector<std::string>& filter_labels,
       const std::shared_ptr<VerticesCollection>& vertices_collection);
 
+  /**
+   * @brief Query vertices by a boolean predicate over their labels within a
+   * given collection
+   *
+   * @param predicate The label predicate, see LabelPredicate
+   * @param vertices_collection The collection of vertices to search within
+   * @return A VerticesCollection containing all vertices from the specified
+   * collection that satisfy the predicate
+   */
+  static Result<std::shared_ptr<VerticesCollection>> verticesWithMultipleLabels(
+      const std::shared_ptr<LabelPredicate>& predicate,
+      const std::shared_ptr<VerticesCollection>& vertices_collection);
+
   /**
    * @brief Construct a VerticesCollection from graph info and vertex label.
    *
@@ -474,11 +784,16 @@ class VerticesCollection {
   }
 
  private:
+  // make the collection the vertices of the set and its chunks
+  void SetFiltered(VertexSet vertex_set);
+
   std::shared_ptr<VertexInfo> vertex_info_;
   std::string prefix_;
   std::vector<std::string> labels_;
   bool is_filtered_;
-  std::vector<IdType> filtered_ids_;
+  std::shared_ptr<const VertexSet> filtered_ids_;
+  // the property layout shared by the iterators
+  std::shared_ptr<const PropertyLayout> layout_;
   std::vector<IdType> valid_chunk_;
   IdType vertex_num_;
 };
@@ -501,31 +816,37 @@ class EdgeIter {
    * @param chunk_end The index of the last chunk.
    * @param index_converter The converter for transforming the edge chunk
    * indices.
+   * @param layout The property layout of the edge type, shared by the
+   * iterators of a collection, made from the edge info if nullptr.
    */
   explicit EdgeIter(const std::shared_ptr<EdgeInfo>& edge_info,
                     const std::string& prefix, AdjListType adj_list_type,
                     IdType global_chunk_index, IdType offset,
                     IdType chunk_begin, IdType chunk_end,
-                    std::shared_ptr<util::IndexConverter> index_converter)
-      : adj_list_reader_(edge_info, adj_list_type, prefix),
+                    std::shared_ptr<util::IndexConverter> index_converter,
+                    std::shared_ptr<const PropertyLayout> layout = nullptr)
+      : cursor_(edge_info, adj_list_type, prefix,
+                edge_info->GetPropertyGroups()),
         global_chunk_index_(global_chunk_index),
         cur_offset_(offset),
         chunk_size_(edge_info->GetChunkSize()),
         src_chunk_size_(edge_info->GetSrcChunkSize()),
         dst_chunk_size_(edge_info->GetDstChunkSize()),
-        num_row_of_chunk_(0),
         chunk_begin_(chunk_begin),
         chunk_end_(chunk_end),
         adj_list_type_(adj_list_type),
-        index_converter_(index_converter) {
+        index_converter_(index_converter),
+        loaded_vertex_chunk_index_(-1),
+        loaded_offset_(0),
+        num_row_of_chunk_(0),
+        src_(nullptr),
+        dst_(nullptr),
+        layout_(layout != nullptr ? std::move(layout)
+                                  : std::make_shared<const PropertyLayout>(
+                                        edge_info->GetPropertyGroups())),
+        properties_loaded_(false) {
     vertex_chunk_index_ =
         index_converter->GlobalChunkIndexToIndexPair(global_chunk_index).first;
-    adj_list_reader_.seek_chunk_index(vertex_chunk_index_);
-    const auto& property_groups = edge_info->GetPropertyGroups();
-    for (const auto& pg : property_groups) {
-      property_readers_.emplace_back(edge_info, pg, adj_list_type, prefix),
-          property_readers_.back().seek_chunk_index(vertex_chunk_index_);
-    }
     if (adj_list_type == AdjListType::ordered_by_source ||
         adj_list_type == AdjListType::ordered_by_dest) {
       offset_reader_ = std::make_shared<AdjListOffsetArrowChunkReader>(
@@ -535,95 +856,106 @@ class EdgeIter {
 
   /** Copy constructor. */
   EdgeIter(const EdgeIter& other)
-      : adj_list_reader_(other.adj_list_reader_),
+      : cursor_(other.cursor_),
         offset_reader_(other.offset_reader_),
-        property_readers_(other.property_readers_),
         global_chunk_index_(other.global_chunk_index_),
         vertex_chunk_index_(other.vertex_chunk_index_),
         cur_offset_(other.cur_offset_),
         chunk_size_(other.chunk_size_),
         src_chunk_size_(other.src_chunk_size_),
         dst_chunk_size_(other.dst_chunk_size_),
-        num_row_of_chunk_(other.num_row_of_chunk_),
         chunk_begin_(other.chunk_begin_),
         chunk_end_(other.chunk_end_),
         adj_list_type_(other.adj_list_type_),
-        index_converter_(other.index_converter_) {}
+        index_converter_(other.index_converter_),
+        loaded_vertex_chunk_index_(other.loaded_vertex_chunk_index_),
+        loaded_offset_(other.loaded_offset_),
+        num_row_of_chunk_(other.num_row_of_chunk_),
+        src_(other.src_),
+        dst_(other.dst_),
+        layout_(other.layout_),
+        chunk_(other.chunk_),
+        properties_loaded_(other.properties_loaded_) {}
 
   /** Construct and return the edge of the current offset. */
-  Edge operator*() {
-    adj_list_reader_.seek(cur_offset_);
-    for (auto& reader : property_readers_) {
-      reader.seek(cur_offset_);
-    }
-    return Edge(adj_list_reader_, property_readers_);
+  Edge operator*() { return Edge(view()); }
+
+  /**
+   * @brief Get the view of the edge of the current offset, which reads the
+   * properties from the loaded chunk without copying them. The view is valid
+   * until the iterator moves to another chunk.
+   */
+  EdgeView view() {
+    GAR_RAISE_ERROR_NOT_OK(load());
+    GAR_RAISE_ERROR_NOT_OK(loadProperties());
+    int64_t row = cur_offset_ - loaded_offset_;
+    return EdgeView(src_[row], dst_[row], chunk_.get(), row);
   }
 
   /** Get the source vertex id for the current edge. */
-  IdType source();
+  IdType source() {
+    GAR_RAISE_ERROR_NOT_OK(load());
+    return src_[cur_offset_ - loaded_offset_];
+  }
 
   /** Get the destination vertex id for the current edge. */
-  IdType destination();
+  IdType destination() {
+    GAR_RAISE_ERROR_NOT_OK(load());
+    return dst_[cur_offset_ - loaded_offset_];
+  }
 
   /** Get the value of a property for the current edge. */
   template <typename T>
   Result<T> property(const std::string& property) noexcept {
-    std::shared_ptr<arrow::ChunkedArray> column(nullptr);
-    for (auto& reader : property_readers_) {
-      reader.seek(cur_offset_);
-      GAR_ASSIGN_OR_RAISE(auto chunk_table, reader.GetChunk());
-      column = util::GetArrowColumnByName(chunk_table, property);
-      if (column != nullptr) {
-        break;
-      }
-    }
-    if (column != nullptr) {
-      auto array = util::GetArrowArrayByChunkIndex(column, 0);
-      GAR_ASSIGN_OR_RAISE(auto data, util::GetArrowArrayData(array));
-      return util::ValueGetter<T>::Value(data, 0);
-    }
-    return Status::KeyError("Property with name ", property,
-                            " does not exist in the edge.");
+    GAR_RETURN_NOT_OK(load());
+    GAR_RETURN_NOT_OK(loadProperties());
+    int64_t row = cur_offset_ - loaded_offset_;
+    return EdgeView(src_[row], dst_[row], chunk_.get(), row)
+        .property<T>(property);
+  }
+
+  /**
+   * @brief Get the value of a resolved property of the current edge, a typed
+   * load from the loaded chunk. The value of a null is unspecified, check a
+   * nullable property with isNull first.
+   *
+   * @param handle The handle from EdgesCollection::propertyHandle.
+   * @return The value, throws if the data of the chunk is not of type T.
+   */
+  template <typename T>
+  T get(const PropertyHandle<T>& handle) {
+    int64_t row;
+    const ColumnView& column = locate(handle, &row);
+    return RowValue<T>::Load(column, row);
+  }
+
+  /** Whether the value of a resolved property of the current edge is null. */
+  template <typename T>
+  bool isNull(const PropertyHandle<T>& handle) {
+    int64_t row;
+    return locate(handle, &row).IsNull(row);
   }
 
   /** The prefix increment operator. */
   EdgeIter& operator++() {
-    if (num_row_of_chunk_ == 0) {
-      adj_list_reader_.seek(cur_offset_);
-      GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                                adj_list_reader_.GetRowNumOfChunk());
+    if (is_end()) {
+      return *this;
     }
-    auto st = adj_list_reader_.seek(++cur_offset_);
-    if (st.ok() && num_row_of_chunk_ != chunk_size_) {
-      // check the row offset is overflow
-      auto row_offset = cur_offset_ % chunk_size_;
-      if (row_offset >= num_row_of_chunk_) {
-        cur_offset_ = (cur_offset_ / chunk_size_ + 1) * chunk_size_;
-        adj_list_reader_.seek(cur_offset_);
-        st =
-            Status::KeyError("The row offset is overflow, move to next chunk.");
-      }
-    }
-    if (st.ok() && num_row_of_chunk_ == chunk_size_ &&
-        cur_offset_ % chunk_size_ == 0) {
-      GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                                adj_list_reader_.GetRowNumOfChunk());
-      ++global_chunk_index_;
+    GAR_RAISE_ERROR_NOT_OK(load());
+    // the common case, the next edge is in the loaded chunk
+    if (++cur_offset_ < loaded_offset_ + num_row_of_chunk_) {
+      return *this;
     }
-    if (st.IsKeyError()) {
-      st = adj_list_reader_.next_chunk();
-      ++global_chunk_index_;
-      ++vertex_chunk_index_;
-      if (!st.IsIndexError()) {
-        GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                                  adj_list_reader_.GetRowNumOfChunk());
-        for (auto& reader : property_readers_) {
-          reader.next_chunk();
-        }
-      }
+    // move to the first edge of the next edge chunk, which is loaded lazily
+    ++global_chunk_index_;
+    if (is_end()) {
       cur_offset_ = 0;
-      adj_list_reader_.seek(cur_offset_);
+      return *this;
     }
+    auto index_pair =
+        index_converter_->GlobalChunkIndexToIndexPair(global_chunk_index_);
+    vertex_chunk_index_ = index_pair.first;
+    cur_offset_ = index_pair.second * chunk_size_;
     return *this;
   }
 
@@ -636,20 +968,26 @@ class EdgeIter {
 
   /** The copy assignment operator. */
   EdgeIter operator=(const EdgeIter& other) {
-    adj_list_reader_ = other.adj_list_reader_;
+    cursor_ = other.cursor_;
     offset_reader_ = other.offset_reader_;
-    property_readers_ = other.property_readers_;
     global_chunk_index_ = other.global_chunk_index_;
     vertex_chunk_index_ = other.vertex_chunk_index_;
     cur_offset_ = other.cur_offset_;
     chunk_size_ = other.chunk_size_;
     src_chunk_size_ = other.src_chunk_size_;
     dst_chunk_size_ = other.dst_chunk_size_;
-    num_row_of_chunk_ = other.num_row_of_chunk_;
     chunk_begin_ = other.chunk_begin_;
     chunk_end_ = other.chunk_end_;
     adj_list_type_ = other.adj_list_type_;
     index_converter_ = other.index_converter_;
+    loaded_vertex_chunk_index_ = other.loaded_vertex_chunk_index_;
+    loaded_offset_ = other.loaded_offset_;
+    num_row_of_chunk_ = other.num_row_of_chunk_;
+    src_ = other.src_;
+    dst_ = other.dst_;
+    layout_ = other.layout_;
+    chunk_ = other.chunk_;
+    properties_loaded_ = other.properties_loaded_;
     return *this;
   }
 
@@ -706,6 +1044,25 @@ class EdgeIter {
   /** Check if the current position is the end. */
   bool is_end() const { return global_chunk_index_ >= chunk_end_; }
 
+  /**
+   * @brief Restrict the iterator to the edge chunks [chunk_begin, chunk_end)
+   * of global indices and point it to the first edge of them. The readers are
+   * kept, so that an iterator is reused for the ranges of a partition.
+   */
+  void seek_range(IdType chunk_begin, IdType chunk_end) {
+    chunk_begin_ = chunk_begin;
+    chunk_end_ = chunk_end;
+    global_chunk_index_ = chunk_begin;
+    if (is_end()) {
+      cur_offset_ = 0;
+      return;
+    }
+    auto index_pair =
+        index_converter_->GlobalChunkIndexToIndexPair(global_chunk_index_);
+    vertex_chunk_index_ = index_pair.first;
+    cur_offset_ = index_pair.second * chunk_size_;
+  }
+
   /** Point to the next edge with the same source, return false if not found. */
   bool next_src() {
     if (is_end())
@@ -786,31 +1143,98 @@ class EdgeIter {
   }
 
  private:
-  // Refresh the readers to point to the current position.
-  void refresh() {
-    adj_list_reader_.seek_chunk_index(vertex_chunk_index_);
-    adj_list_reader_.seek(cur_offset_);
-    for (auto& reader : property_readers_) {
-      reader.seek_chunk_index(vertex_chunk_index_);
+  // Whether the current position is in the edge chunk held by the cursor.
+  bool loaded() const noexcept {
+    return vertex_chunk_index_ == loaded_vertex_chunk_index_ &&
+           cur_offset_ >= loaded_offset_ &&
+           cur_offset_ < loaded_offset_ + num_row_of_chunk_;
+  }
+
+  // Load the edge chunk of the current position if it is not loaded yet.
+  Status load() {
+    if (loaded()) {
+      return Status::OK();
+    }
+    GAR_RETURN_NOT_OK(cursor_.seek_chunk_index(vertex_chunk_index_,
+                                               cur_offset_ / chunk_size_));
+    loaded_vertex_chunk_index_ = vertex_chunk_index_;
+    loaded_offset_ = cursor_.GetChunkIndex() * chunk_size_;
+    num_row_of_chunk_ = cursor_.size();
+    src_ = cursor_.sources();
+    dst_ = cursor_.destinations();
+    chunk_.reset();
+    properties_loaded_ = false;
+    if (!loaded()) {
+      return Status::IndexError("The edge offset ", cur_offset_,
+                                " is out of range of vertex chunk ",
+                                vertex_chunk_index_, ".");
+    }
+    return Status::OK();
+  }
+
+  // Get the column of a handle in the loaded chunk and the row of the
+  // current edge in it, throws if the value can not be loaded as T.
+  template <typename T>
+  const ColumnView& locate(const PropertyHandle<T>& handle, int64_t* row) {
+    if (!loaded() || !properties_loaded_) {
+      GAR_RAISE_ERROR_NOT_OK(load());
+      GAR_RAISE_ERROR_NOT_OK(loadProperties());
+    }
+    *row = cur_offset_ - loaded_offset_;
+    int index = handle.index();
+    if (chunk_ == nullptr) {
+      GAR_RAISE_ERROR_NOT_OK(
+          Status::KeyError("The edge chunk has no property."));
+    }
+    if (!chunk_->HasColumn(index) ||
+        !RowValue<T>::Match(chunk_->column(index)) ||
+        *row >= chunk_->column(index).length) {
+      // report why the value can not be loaded
+      GAR_RAISE_ERROR_NOT_OK(chunk_->GetValue<T>(index, *row));
+    }
+    return chunk_->column(index);
+  }
+
+  // Load the properties of the loaded edge chunk if they are not loaded yet.
+  Status loadProperties() {
+    if (properties_loaded_) {
+      return Status::OK();
     }
-    GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                              adj_list_reader_.GetRowNumOfChunk());
+    GAR_ASSIGN_OR_RAISE(auto table, cursor_.GetProperties());
+    if (table != nullptr) {
+      GAR_ASSIGN_OR_RAISE(chunk_, PropertyChunk::Make(layout_, {table}));
+    }
+    properties_loaded_ = true;
+    return Status::OK();
   }
 
+  // Drop the loaded chunk, the chunk of the current position is loaded on
+  // the next access.
+  void refresh() noexcept { loaded_vertex_chunk_index_ = -1; }
+
  private:
-  AdjListArrowChunkReader adj_list_reader_;
+  EdgeChunkCursor cursor_;
   std::shared_ptr<AdjListOffsetArrowChunkReader> offset_reader_;
-  std::vector<AdjListPropertyArrowChunkReader> property_readers_;
   IdType global_chunk_index_;
   IdType vertex_chunk_index_;
   IdType cur_offset_;
   IdType chunk_size_;
   IdType src_chunk_size_;
   IdType dst_chunk_size_;
-  IdType num_row_of_chunk_;
   IdType chunk_begin_, chunk_end_;
   AdjListType adj_list_type_;
   std::shared_ptr<util::IndexConverter> index_converter_;
+  // the edge chunk held by the cursor, the edges of the chunk are
+  // [loaded_offset_, loaded_offset_ + num_row_of_chunk_) in the vertex chunk
+  IdType loaded_vertex_chunk_index_;
+  IdType loaded_offset_;
+  IdType num_row_of_chunk_;
+  const IdType* src_;
+  const IdType* dst_;
+  std::shared_ptr<const PropertyLayout> layout_;
+  // the properties of the loaded edge chunk, read on the first access
+  std::shared_ptr<const PropertyChunk> chunk_;
+  bool properties_loaded_;
 
   friend class OBSEdgeCollection;
   friend class OBDEdgesCollection;
@@ -829,7 +1253,7 @@ class EdgesCollection {
   virtual EdgeIter begin() {
     if (begin_ == nullptr) {
       EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_begin_, 0,
-                    chunk_begin_, chunk_end_, index_converter_);
+                    chunk_begin_, chunk_end_, index_converter_, layout_);
       begin_ = std::make_shared<EdgeIter>(iter);
     }
     return *begin_;
@@ -839,7 +1263,7 @@ class EdgesCollection {
   virtual EdgeIter end() {
     if (end_ == nullptr) {
       EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_end_, 0,
-                    chunk_begin_, chunk_end_, index_converter_);
+                    chunk_begin_, chunk_end_, index_converter_, layout_);
       end_ = std::make_shared<EdgeIter>(iter);
     }
     return *end_;
@@ -848,6 +1272,35 @@ class EdgesCollection {
   /** Get the number of edges in the collection. */
   virtual size_t size() const noexcept { return edge_num_; }
 
+  /**
+   * @brief Split the edges into ranges of consecutive edge chunks with about
+   * the same number of edges, to iterate them in parallel.
+   *
+   * @param num_parts The maximum number of ranges.
+   * @return The ranges in the order of the collection.
+   */
+  Result<std::vector<ChunkRange>> partition(int num_parts) const;
+
+  /**
+   * @brief Construct an iterator over a range of a partition. Unlike the
+   * copies of begin(), the iterator has readers of its own, so that it is
+   * used by a thread while the others iterate the collection.
+   */
+  EdgeIter rangeBegin(const ChunkRange& range) const;
+
+  /**
+   * @brief Resolve a property of the edges into a handle of values of type
+   * T, which is read by EdgeIter::get.
+   *
+   * @param name The property name.
+   * @return The handle, or KeyError if there is no such property, TypeError
+   * if the property is not of type T.
+   */
+  template <typename T>
+  Result<PropertyHandle<T>> propertyHandle(const std::string& name) const {
+    return layout_->GetHandle<T>(name);
+  }
+
   /**
    * Construct and return the iterator pointing to the first out-going edge of
    * the vertex with specific id after the input iterator.
@@ -902,11 +1355,14 @@ class EdgesCollection {
                            IdType vertex_chunk_end, AdjListType adj_list_type)
       : edge_info_(std::move(edge_info)),
         prefix_(prefix),
-        adj_list_type_(adj_list_type) {
+        adj_list_type_(adj_list_type),
+        layout_(std::make_shared<const PropertyLayout>(
+            edge_info->GetPropertyGroups())) {
     GAR_ASSIGN_OR_RAISE_ERROR(
-        auto vertex_chunk_num,
-        util::GetVertexChunkNum(prefix_, edge_info_, adj_list_type_));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
+        auto count_index,
+        GraphCountIndex::Get(prefix_, edge_info_, adj_list_type_));
+    IdType vertex_chunk_num = count_index->GetVertexChunkNum();
+    std::vector<IdType> edge_chunk_nums = count_index->GetEdgeChunkNums();
     if (vertex_chunk_end == std::numeric_limits<int64_t>::max()) {
       vertex_chunk_end = vertex_chunk_num;
     }
@@ -914,19 +1370,13 @@ class EdgesCollection {
     chunk_end_ = 0;
     edge_num_ = 0;
     for (IdType i = 0; i < vertex_chunk_num; ++i) {
-      GAR_ASSIGN_OR_RAISE_ERROR(
-          edge_chunk_nums[i],
-          util::GetEdgeChunkNum(prefix, edge_info, adj_list_type_, i));
       if (i < vertex_chunk_begin) {
         chunk_begin_ += edge_chunk_nums[i];
         chunk_end_ += edge_chunk_nums[i];
       }
       if (i >= vertex_chunk_begin && i < vertex_chunk_end) {
         chunk_end_ += edge_chunk_nums[i];
-        GAR_ASSIGN_OR_RAISE_ERROR(
-            auto chunk_edge_num_,
-            util::GetEdgeNum(prefix, edge_info, adj_list_type_, i));
-        edge_num_ += chunk_edge_num_;
+        edge_num_ += count_index->GetEdgeNums()[i];
       }
     }
     index_converter_ =
@@ -936,6 +1386,8 @@ class EdgesCollection {
   std::shared_ptr<EdgeInfo> edge_info_;
   std::string prefix_;
   AdjListType adj_list_type_;
+  // the property layout shared by the iterators
+  std::shared_ptr<const PropertyLayout> layout_;
   IdType chunk_begin_, chunk_end_;
   std::shared_ptr<util::IndexConverter> index_converter_;
   std::shared_ptr<EdgeIter> begin_, end_;
@@ -994,20 +1446,20 @@ class OBSEdgeCollection : public EdgesCollection {
     if (begin_global_chunk_index > from.global_chunk_index_) {
       return EdgeIter(edge_info_, prefix_, adj_list_type_,
                       begin_global_chunk_index, begin_offset, chunk_begin_,
-                      chunk_end_, index_converter_);
+                      chunk_end_, index_converter_, layout_);
     } else if (end_global_chunk_index < from.global_chunk_index_) {
       return this->end();
     } else {
       if (begin_offset > from.cur_offset_) {
         return EdgeIter(edge_info_, prefix_, adj_list_type_,
                         begin_global_chunk_index, begin_offset, chunk_begin_,
-                        chunk_end_, index_converter_);
+                        chunk_end_, index_converter_, layout_);
       } else if (end_offset <= from.cur_offset_) {
         return this->end();
       } else {
         return EdgeIter(edge_info_, prefix_, adj_list_type_,
                         from.global_chunk_index_, from.cur_offset_,
-                        chunk_begin_, chunk_end_, index_converter_);
+                        chunk_begin_, chunk_end_, index_converter_, layout_);
       }
     }
     return this->end();
@@ -1025,8 +1477,7 @@ class OBSEdgeCollection : public EdgesCollection {
     EdgeIter iter(from);
     auto end = this->end();
     while (iter != end) {
-      auto edge = *iter;
-      if (edge.destination() == id) {
+      if (iter.destination() == id) {
         break;
       }
       ++iter;
@@ -1069,8 +1520,7 @@ class OBDEdgesCollection : public EdgesCollection {
     EdgeIter iter(from);
     auto end = this->end();
     while (iter != end) {
-      auto edge = *iter;
-      if (edge.source() == id) {
+      if (iter.source() == id) {
         break;
       }
       ++iter;
@@ -1107,20 +1557,20 @@ class OBDEdgesCollection : public EdgesCollection {
     if (begin_global_chunk_index > from.global_chunk_index_) {
       return EdgeIter(edge_info_, prefix_, adj_list_type_,
                       begin_global_chunk_index, begin_offset, chunk_begin_,
-                      chunk_end_, index_converter_);
+                      chunk_end_, index_converter_, layout_);
     } else if (end_global_chunk_index < from.global_chunk_index_) {
       return this->end();
     } else {
       if (begin_offset >= from.cur_offset_) {
         return EdgeIter(edge_info_, prefix_, adj_list_type_,
                         begin_global_chunk_index, begin_offset, chunk_begin_,
-                        chunk_end_, index_converter_);
+                        chunk_end_, index_converter_, layout_);
       } else if (end_offset <= from.cur_offset_) {
         return this->end();
       } else {
         return EdgeIter(edge_info_, prefix_, adj_list_type_,
                         from.global_chunk_index_, from.cur_offset_,
-                        chunk_begin_, chunk_end_, index_converter_);
+                        chunk_begin_, chunk_end_, index_converter_, layout_);
       }
     }
     return this->end();
@@ -1161,8 +1611,7 @@ class UBSEdgesCollection : public EdgesCollection {
     EdgeIter iter(from);
     auto end = this->end();
     while (iter != end) {
-      auto edge = *iter;
-      if (edge.source() == id) {
+      if (iter.source() == id) {
         break;
       }
       ++iter;
@@ -1182,8 +1631,7 @@ class UBSEdgesCollection : public EdgesCollection {
     EdgeIter iter(from);
     auto end = this->end();
     while (iter != end) {
-      auto edge = *iter;
-      if (edge.destination() == id) {
+      if (iter.destination() == id) {
         break;
       }
       ++iter;
@@ -1226,8 +1674,7 @@ class UBDEdgesCollection : public EdgesCollection {
     EdgeIter iter(from);
     auto end = this->end();
     while (iter != end) {
-      auto edge = *iter;
-      if (edge.source() == id) {
+      if (iter.source() == id) {
         break;
       }
       ++iter;
@@ -1247,8 +1694,7 @@ class UBDEdgesCollection : public EdgesCollection {
     EdgeIter iter(from);
     auto end = this->end();
     while (iter != end) {
-      auto edge = *iter;
-      if (edge.destination() == id) {
+      if (iter.destination() == id) {
         break;
       }
       ++iter;
@@ -1256,4 +1702,44 @@ class UBDEdgesCollection : public EdgesCollection {
     return iter;
   }
 };
+
+/**
+ * @brief Visit the vertices of a collection in parallel, a range of its
+ * partition at a time.
+ *
+ * The workers take the ranges one by one until all of them are visited, so
+ * that a worker done early takes over the remaining ranges. Each worker reads
+ * the chunks with readers of its own.
+ *
+ * @param vertices The vertices collection.
+ * @param fn The function called for each range with an iterator pointing to
+ * the first vertex of the range, the number of vertices of the range and the
+ * index of the worker in [0, num_threads). The calls of a worker run one
+ * after another, the calls of different workers run concurrently.
+ * @param num_threads The number of workers, the capacity of the CPU thread
+ * pool of Arrow if it is not positive.
+ * @return The first error returned by fn or thrown during a call, the other
+ * workers stop after their current range.
+ */
+Status ParallelForEachChunk(
+    VerticesCollection& vertices,
+    const std::function<Status(VertexIter& it, IdType count, int worker)>& fn,
+    int num_threads = 0);
+
+/**
+ * @brief Visit the edges of a collection in parallel, a range of its
+ * partition at a time, see the ParallelForEachChunk of vertices.
+ *
+ * @param edges The edges collection.
+ * @param fn The function called for each range with an iterator pointing to
+ * the first edge of the range, which is at the end after the last edge of
+ * the range, the number of edges of the range and the index of the worker.
+ * @param num_threads The number of workers, the capacity of the CPU thread
+ * pool of Arrow if it is not positive.
+ * @return The first error returned by fn or thrown during a call.
+ */
+Status ParallelForEachChunk(
+    EdgesCollection& edges,
+    const std::function<Status(EdgeIter& it, IdType count, int worker)>& fn,
+    int num_threads = 0);
 }  // namespace graphar
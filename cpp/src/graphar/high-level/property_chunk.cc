@@ -0,0 +1,159 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/array/concatenate.h"
+
+#include "graphar/context.h"
+#include "graphar/graph_info.h"
+#include "graphar/high-level/property_chunk.h"
+
+namespace graphar {
+
+namespace {
+// the type of the values of an arrow type, MAX_ID if it is not supported
+Type GetValueType(const arrow::DataType& type) {
+  switch (type.id()) {
+  case arrow::Type::BOOL:
+    return Type::BOOL;
+  case arrow::Type::INT32:
+    return Type::INT32;
+  case arrow::Type::INT64:
+    return Type::INT64;
+  case arrow::Type::FLOAT:
+    return Type::FLOAT;
+  case arrow::Type::DOUBLE:
+    return Type::DOUBLE;
+  case arrow::Type::STRING:
+  case arrow::Type::LARGE_STRING:
+    return Type::STRING;
+  case arrow::Type::DATE32:
+    return Type::DATE;
+  // Date64 of Arrow is used to represent timestamp milliseconds
+  case arrow::Type::TIMESTAMP:
+  case arrow::Type::DATE64:
+    return Type::TIMESTAMP;
+  default:
+    return Type::MAX_ID;
+  }
+}
+
+// point the values of the view to the buffers of an array of values
+void SetValues(const arrow::ArrayData& data, ColumnView* column) {
+  column->type = GetValueType(*data.type);
+  switch (data.type->id()) {
+  case arrow::Type::BOOL:
+    column->values = data.buffers[1] ? data.buffers[1]->data() : nullptr;
+    break;
+  case arrow::Type::STRING:
+    column->offsets = data.GetValues<int32_t>(1);
+    column->values = data.buffers[2] ? data.buffers[2]->data() : nullptr;
+    break;
+  case arrow::Type::LARGE_STRING:
+    column->is_large = true;
+    column->large_offsets = data.GetValues<int64_t>(1);
+    column->values = data.buffers[2] ? data.buffers[2]->data() : nullptr;
+    break;
+  default:
+    if (column->type != Type::MAX_ID) {
+      int byte_width =
+          static_cast<const arrow::FixedWidthType&>(*data.type).bit_width() /
+          8;
+      column->values = data.GetValues<uint8_t>(1, data.offset * byte_width);
+    }
+    break;
+  }
+}
+
+ColumnView MakeColumnView(const arrow::Array& array) {
+  ColumnView column;
+  const auto& data = *array.data();
+  column.length = data.length;
+  column.offset = data.offset;
+  if (array.null_count() > 0 && data.buffers[0]) {
+    column.validity = data.buffers[0]->data();
+  }
+  if (data.type->id() != arrow::Type::LIST) {
+    SetValues(data, &column);
+    return column;
+  }
+  // the values of a list are the elements, addressed by the list offsets
+  column.is_list = true;
+  column.offsets = data.GetValues<int32_t>(1);
+  ColumnView elements;
+  SetValues(*data.child_data[0], &elements);
+  column.type = elements.type;
+  column.is_large = elements.is_large;
+  column.values = elements.values;
+  column.element_offsets = elements.offsets;
+  return column;
+}
+}  // namespace
+
+PropertyLayout::PropertyLayout(const PropertyGroupVector& property_groups) {
+  for (const auto& pg : property_groups) {
+    for (const auto& property : pg->GetProperties()) {
+      indices_.emplace(property.name, static_cast<int>(names_.size()));
+      names_.push_back(property.name);
+      types_.push_back(property.type);
+    }
+  }
+}
+
+Result<std::shared_ptr<const PropertyChunk>> PropertyChunk::Make(
+    std::shared_ptr<const PropertyLayout> layout,
+    const std::vector<std::shared_ptr<arrow::Table>>& tables,
+    const std::shared_ptr<ReadContext>& context) {
+  auto pool = ExecutionContext::OrDefault(context).GetMemoryPool();
+  std::shared_ptr<PropertyChunk> chunk(new PropertyChunk());
+  chunk->arrays_.resize(layout->size());
+  chunk->columns_.resize(layout->size());
+  for (const auto& table : tables) {
+    if (table == nullptr) {
+      continue;
+    }
+    chunk->num_rows_ = table->num_rows();
+    for (int i = 0; i < table->num_columns(); ++i) {
+      int index = layout->GetIndex(table->field(i)->name());
+      if (index < 0 || chunk->arrays_[index] != nullptr) {
+        continue;
+      }
+      auto column = table->column(i);
+      std::shared_ptr<arrow::Array> array;
+      if (column->num_chunks() == 1) {
+        array = column->chunk(0);
+      } else if (column->num_chunks() == 0) {
+        GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+            array, arrow::MakeEmptyArray(column->type()));
+      } else {
+        // combine the chunks so that a row is addressed in one array
+        GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+            array, arrow::Concatenate(column->chunks(), pool));
+      }
+      chunk->columns_[index] = MakeColumnView(*array);
+      chunk->arrays_[index] = std::move(array);
+    }
+  }
+  chunk->layout_ = std::move(layout);
+  return std::shared_ptr<const PropertyChunk>(std::move(chunk));
+}
+
+}  // namespace graphar
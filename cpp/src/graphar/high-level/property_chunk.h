@@ -0,0 +1,388 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+#include "graphar/types.h"
+#include "graphar/util.h"
+
+// forward declarations
+namespace arrow {
+class Array;
+class Table;
+}  // namespace arrow
+
+namespace graphar {
+
+/**
+ * @brief The raw buffers of a property column of a loaded chunk, read
+ * without going through arrow.
+ */
+struct ColumnView {
+  /// the type of the values, or of the elements of a list
+  Type type = Type::MAX_ID;
+  bool is_list = false;
+  /// whether the string offsets are 64-bit
+  bool is_large = false;
+  /// nullptr if no value is null
+  const uint8_t* validity = nullptr;
+  /// the fixed-width values, the boolean bits or the string data, of the
+  /// elements for a list
+  const uint8_t* values = nullptr;
+  /// the string offsets, or the list offsets
+  const int32_t* offsets = nullptr;
+  const int64_t* large_offsets = nullptr;
+  /// the string offsets of the elements of a list of strings
+  const int32_t* element_offsets = nullptr;
+  /// the bit offset of the validity and the boolean values
+  int64_t offset = 0;
+  int64_t length = 0;
+
+  /** @brief Whether the value of a row is null. */
+  bool IsNull(int64_t row) const noexcept {
+    return validity != nullptr &&
+           !((validity[(offset + row) >> 3] >> ((offset + row) & 7)) & 1);
+  }
+};
+
+/**
+ * @brief How a C++ type is loaded from a column, specialized for each type
+ * property<T> of a row view supports.
+ *
+ * Match() tells whether the column holds values of the type and Load()
+ * reads the value of a row, which must be in range and not null.
+ */
+template <typename T>
+struct RowValue;
+
+template <typename T, Type type_id>
+struct FixedWidthRowValue {
+  static constexpr Type type = type_id;
+  static constexpr bool is_list = false;
+  static bool Match(const ColumnView& column) noexcept {
+    return column.type == type_id && !column.is_list;
+  }
+  static T Load(const ColumnView& column, int64_t row) noexcept {
+    return reinterpret_cast<const T*>(column.values)[row];
+  }
+};
+
+template <>
+struct RowValue<int32_t> : FixedWidthRowValue<int32_t, Type::INT32> {};
+template <>
+struct RowValue<int64_t> : FixedWidthRowValue<int64_t, Type::INT64> {};
+template <>
+struct RowValue<float> : FixedWidthRowValue<float, Type::FLOAT> {};
+template <>
+struct RowValue<double> : FixedWidthRowValue<double, Type::DOUBLE> {};
+
+template <>
+struct RowValue<bool> {
+  static constexpr Type type = Type::BOOL;
+  static constexpr bool is_list = false;
+  static bool Match(const ColumnView& column) noexcept {
+    return column.type == Type::BOOL && !column.is_list;
+  }
+  static bool Load(const ColumnView& column, int64_t row) noexcept {
+    int64_t bit = column.offset + row;
+    return (column.values[bit >> 3] >> (bit & 7)) & 1;
+  }
+};
+
+template <>
+struct RowValue<Date> {
+  static constexpr Type type = Type::DATE;
+  static constexpr bool is_list = false;
+  static bool Match(const ColumnView& column) noexcept {
+    return column.type == Type::DATE && !column.is_list;
+  }
+  static Date Load(const ColumnView& column, int64_t row) noexcept {
+    return Date(reinterpret_cast<const Date::c_type*>(column.values)[row]);
+  }
+};
+
+template <>
+struct RowValue<Timestamp> {
+  static constexpr Type type = Type::TIMESTAMP;
+  static constexpr bool is_list = false;
+  static bool Match(const ColumnView& column) noexcept {
+    return column.type == Type::TIMESTAMP && !column.is_list;
+  }
+  static Timestamp Load(const ColumnView& column, int64_t row) noexcept {
+    return Timestamp(
+        reinterpret_cast<const Timestamp::c_type*>(column.values)[row]);
+  }
+};
+
+template <>
+struct RowValue<std::string_view> {
+  static constexpr Type type = Type::STRING;
+  static constexpr bool is_list = false;
+  static bool Match(const ColumnView& column) noexcept {
+    return column.type == Type::STRING && !column.is_list;
+  }
+  static std::string_view Load(const ColumnView& column,
+                               int64_t row) noexcept {
+    int64_t begin, end;
+    if (column.is_large) {
+      begin = column.large_offsets[row];
+      end = column.large_offsets[row + 1];
+    } else {
+      begin = column.offsets[row];
+      end = column.offsets[row + 1];
+    }
+    return std::string_view(
+        reinterpret_cast<const char*>(column.values) + begin, end - begin);
+  }
+};
+
+template <>
+struct RowValue<std::string> {
+  static constexpr Type type = Type::STRING;
+  static constexpr bool is_list = false;
+  static bool Match(const ColumnView& column) noexcept {
+    return RowValue<std::string_view>::Match(column);
+  }
+  static std::string Load(const ColumnView& column, int64_t row) {
+    return std::string(RowValue<std::string_view>::Load(column, row));
+  }
+};
+
+template <typename T, Type type_id>
+struct ListRowValue {
+  static constexpr Type type = type_id;
+  static constexpr bool is_list = true;
+  static bool Match(const ColumnView& column) noexcept {
+    return column.type == type_id && column.is_list;
+  }
+  static Array<T> Load(const ColumnView& column, int64_t row) noexcept {
+    int32_t begin = column.offsets[row];
+    return Array<T>(reinterpret_cast<const T*>(column.values) + begin,
+                    column.offsets[row + 1] - begin);
+  }
+};
+
+template <>
+struct RowValue<Int32Array> : ListRowValue<int32_t, Type::INT32> {};
+template <>
+struct RowValue<Int64Array> : ListRowValue<int64_t, Type::INT64> {};
+template <>
+struct RowValue<FloatArray> : ListRowValue<float, Type::FLOAT> {};
+template <>
+struct RowValue<DoubleArray> : ListRowValue<double, Type::DOUBLE> {};
+
+template <>
+struct RowValue<StringArray> {
+  static constexpr Type type = Type::STRING;
+  static constexpr bool is_list = true;
+  static bool Match(const ColumnView& column) noexcept {
+    // StringArray addresses the strings by 32-bit offsets
+    return column.type == Type::STRING && column.is_list && !column.is_large;
+  }
+  static StringArray Load(const ColumnView& column, int64_t row) noexcept {
+    int32_t begin = column.offsets[row];
+    return StringArray(column.element_offsets + begin, column.values,
+                       column.offsets[row + 1] - begin);
+  }
+};
+
+/**
+ * @brief A property of a vertex or edge type resolved to its index in the
+ * layout of the type, with its type checked against T once.
+ *
+ * A handle is got from VerticesCollection::propertyHandle or
+ * EdgesCollection::propertyHandle and read by get() of their iterators,
+ * which is a typed load from the column of the loaded chunk without looking
+ * up the property by its name.
+ */
+template <typename T>
+class PropertyHandle {
+ public:
+  using ValueType = T;
+
+  /** @brief Get the index of the property in the layout. */
+  int index() const noexcept { return index_; }
+
+ private:
+  explicit PropertyHandle(int index) noexcept : index_(index) {}
+
+  int index_;
+
+  friend class PropertyLayout;
+};
+
+/**
+ * @brief The properties of a vertex or edge type in a fixed order, so that a
+ * property is resolved by its name once and then addressed by its index in
+ * every chunk of the type.
+ */
+class PropertyLayout {
+ public:
+  /**
+   * @brief Initialize the layout with the properties of the groups in order.
+   *
+   * @param property_groups The property groups of the vertex or edge type.
+   */
+  explicit PropertyLayout(const PropertyGroupVector& property_groups);
+
+  /** @brief Get the number of properties. */
+  int size() const noexcept { return static_cast<int>(names_.size()); }
+
+  /** @brief Get the index of a property, or -1 if there is no such one. */
+  int GetIndex(const std::string& name) const {
+    auto it = indices_.find(name);
+    return it == indices_.end() ? -1 : it->second;
+  }
+
+  /** @brief Get the name of the property of an index. */
+  const std::string& GetName(int index) const { return names_[index]; }
+
+  /** @brief Get the data type of the property of an index. */
+  const std::shared_ptr<DataType>& GetType(int index) const {
+    return types_[index];
+  }
+
+  /**
+   * @brief Resolve a property into a handle of values of type T.
+   *
+   * @param name The property name.
+   * @return The handle, or KeyError if there is no such property, TypeError
+   * if the property is not of type T.
+   */
+  template <typename T>
+  Result<PropertyHandle<T>> GetHandle(const std::string& name) const {
+    int index = GetIndex(name);
+    if (index < 0) {
+      return Status::KeyError("Property with name ", name,
+                              " does not exist.");
+    }
+    const auto& type = types_[index];
+    if (type == nullptr) {
+      return Status::TypeError("The property ", name, " has no data type.");
+    }
+    bool is_list = type->id() == Type::LIST;
+    const auto& value_type = is_list ? type->value_type() : type;
+    if (is_list != RowValue<T>::is_list || value_type == nullptr ||
+        value_type->id() != RowValue<T>::type) {
+      return Status::TypeError("The property ", name, " is of type ",
+                               type->ToTypeName(),
+                               ", which does not match the handle.");
+    }
+    return PropertyHandle<T>(index);
+  }
+
+ private:
+  std::vector<std::string> names_;
+  std::vector<std::shared_ptr<DataType>> types_;
+  std::unordered_map<std::string, int> indices_;
+};
+
+/**
+ * @brief The property columns of a loaded vertex or edge chunk in the order
+ * of a layout, each combined into one array, so that a property of a row is
+ * a typed load from the buffers of its column.
+ */
+class PropertyChunk {
+ public:
+  /**
+   * @brief Make the chunk from the tables of the property groups.
+   *
+   * @param layout The layout of the properties of the vertex or edge type.
+   * @param tables The tables of the property groups of the chunk, of the
+   * same number of rows. A property absent from the tables is not loaded.
+   * @param context The read context of the tables, whose memory pool holds
+   * the combined columns, nullptr for the default one.
+   */
+  static Result<std::shared_ptr<const PropertyChunk>> Make(
+      std::shared_ptr<const PropertyLayout> layout,
+      const std::vector<std::shared_ptr<arrow::Table>>& tables,
+      const std::shared_ptr<ReadContext>& context = nullptr);
+
+  /** @brief Get the layout of the chunk. */
+  const PropertyLayout& layout() const noexcept { return *layout_; }
+
+  /** @brief Get the number of rows of the chunk. */
+  int64_t num_rows() const noexcept { return num_rows_; }
+
+  /** @brief Whether the property of an index is loaded. */
+  bool HasColumn(int index) const noexcept {
+    return index >= 0 && index < static_cast<int>(arrays_.size()) &&
+           arrays_[index] != nullptr;
+  }
+
+  /** @brief Get the raw view of the column of a loaded property. */
+  const ColumnView& column(int index) const noexcept {
+    return columns_[index];
+  }
+
+  /** @brief Get the arrow array of the column of a loaded property. */
+  const std::shared_ptr<arrow::Array>& array(int index) const noexcept {
+    return arrays_[index];
+  }
+
+  /**
+   * @brief Get the value of a property of a row.
+   *
+   * @param index The index of the property in the layout.
+   * @param row The row in the chunk.
+   * @return The value, or KeyError if the property is not loaded, TypeError
+   * if it is not of type T or null, IndexError if the row is out of range.
+   */
+  template <typename T>
+  Result<T> GetValue(int index, int64_t row) const {
+    if (!HasColumn(index)) {
+      return Status::KeyError("The property of index ", index,
+                              " is not loaded.");
+    }
+    const ColumnView& column = columns_[index];
+    if (!RowValue<T>::Match(column)) {
+      return Status::TypeError("The property ", layout_->GetName(index),
+                               " is not of the requested type.");
+    }
+    if (row < 0 || row >= column.length) {
+      return Status::IndexError("The row ", row, " is out of range [0, ",
+                                column.length, ").");
+    }
+    if (column.IsNull(row)) {
+      return Status::TypeError("The value of the ", layout_->GetName(index),
+                               " is null.");
+    }
+    return RowValue<T>::Load(column, row);
+  }
+
+ private:
+  PropertyChunk() = default;
+
+  std::shared_ptr<const PropertyLayout> layout_;
+  // the arrays hold the buffers the views point to
+  std::vector<std::shared_ptr<arrow::Array>> arrays_;
+  std::vector<ColumnView> columns_;
+  int64_t num_rows_ = 0;
+};
+
+}  // namespace graphar
@@ -18,6 +18,7 @@
  */
 
 #include "graphar/high-level/vertices_builder.h"
+#include "graphar/context.h"
 #include "graphar/convert_to_arrow_type.h"
 #include "graphar/graph_info.h"
 
@@ -128,12 +129,18 @@ Status VerticesBuilder::validate(const Vertex& v, IdType index,
   return Status::OK();
 }
 
+arrow::MemoryPool* VerticesBuilder::getMemoryPool() const {
+  return ExecutionContext::OrDefault(
+             writer_options_ ? writer_options_->getContext() : nullptr)
+      .GetMemoryPool();
+}
+
 template <Type type>
 Status VerticesBuilder::tryToAppend(
     const std::string& property_name,
     std::shared_ptr<arrow::Array>& array) {  // NOLINT
   using CType = typename TypeToArrowType<type>::CType;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  arrow::MemoryPool* pool = getMemoryPool();
   typename TypeToArrowType<type>::BuilderType builder(pool);
   for (auto& v : vertices_) {
     if (v.Empty() || !v.ContainProperty(property_name)) {
@@ -152,7 +159,7 @@ Status VerticesBuilder::tryToAppend<Type::TIMESTAMP>(
     const std::string& property_name,
     std::shared_ptr<arrow::Array>& array) {  // NOLINT
   using CType = typename TypeToArrowType<Type::TIMESTAMP>::CType::c_type;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  arrow::MemoryPool* pool = getMemoryPool();
   typename TypeToArrowType<Type::TIMESTAMP>::BuilderType builder(
       arrow::timestamp(arrow::TimeUnit::MILLI), pool);
   for (auto& v : vertices_) {
@@ -172,7 +179,7 @@ Status VerticesBuilder::tryToAppend<Type::DATE>(
     const std::string& property_name,
     std::shared_ptr<arrow::Array>& array) {  // NOLINT
   using CType = typename TypeToArrowType<Type::DATE>::CType::c_type;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  arrow::MemoryPool* pool = getMemoryPool();
   typename TypeToArrowType<Type::DATE>::BuilderType builder(pool);
   for (auto& v : vertices_) {
     if (v.Empty() || !v.ContainProperty(property_name)) {
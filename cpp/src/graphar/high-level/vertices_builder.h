@@ -35,6 +35,7 @@
 // forward declaration
 namespace arrow {
 class Array;
+class MemoryPool;
 class Table;
 }  // namespace arrow
 
@@ -391,6 +392,12 @@ class VerticesBuilder {
    */
   Result<std::shared_ptr<arrow::Table>> convertToTable();
 
+  /**
+   * @brief Get the memory pool of the context of the writer options, or the
+   * default memory pool if there is none.
+   */
+  arrow::MemoryPool* getMemoryPool() const;
+
  private:
   std::shared_ptr<VertexInfo> vertex_info_;
   std::string prefix_;
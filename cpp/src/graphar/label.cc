@@ -19,95 +19,689 @@
 
 #include "graphar/label.h"
 
-#include <cassert>
+#include <algorithm>
 #include <cstring>
-#include <fstream>
-#include <iostream>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 
-/// Read a parquet file by ParquetReader & get valid indices
-/// The first column_num labels are concerned.
-int read_parquet_file_and_get_valid_indices(
-    const char* parquet_filename, const int row_num, const int tot_label_num,
-    const int tested_label_num, std::vector<int> tested_label_ids,
-    const std::function<bool(bool*, int)>& IsValid, int chunk_idx,
-    int chunk_size, std::vector<int>* indices, uint64_t* bitmap,
-    const QUERY_TYPE query_type) {
-  // Create a ParquetReader instance
-  std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
-      parquet::ParquetFileReader::OpenFile(
-          parquet_filename + std::to_string(chunk_idx), false);
-
-  // Get the File MetaData
-  std::shared_ptr<parquet::FileMetaData> file_metadata =
-      parquet_reader->metadata();
-  int row_group_count = file_metadata->num_row_groups();
-  int num_columns = file_metadata->num_columns();
-
-  // Initialize the column row counts
-  std::vector<int> col_row_counts(num_columns, 0);
-  bool** value = new bool*[num_columns];
-  for (int i = 0; i < num_columns; i++) {
-    value[i] = new bool[row_num];
-  }
-
-  // Iterate over all the RowGroups in the file
-  for (int rg = 0; rg < row_group_count; ++rg) {
-    // Get the RowGroup Reader
-    std::shared_ptr<parquet::RowGroupReader> row_group_reader =
-        parquet_reader->RowGroup(rg);
-
-    int64_t values_read = 0;
-    int64_t rows_read = 0;
-    std::shared_ptr<parquet::ColumnReader> column_reader;
-
-    ARROW_UNUSED(rows_read);  // prevent warning in release build
-
-    // Read the label columns
-    for (int k = 0; k < tested_label_num; k++) {
-      int col_id = tested_label_ids[k];
-      // Get the Column Reader for the Bool column
-      column_reader = row_group_reader->Column(col_id);
-      parquet::BoolReader* bool_reader =
-          static_cast<parquet::BoolReader*>(column_reader.get());
-      // Read all the rows in the column
-      while (bool_reader->HasNext()) {
-        // Read BATCH_SIZE values at a time. The number of rows read is
-        // returned. values_read contains the number of non-null rows
-
-        rows_read = bool_reader->ReadBatch(BATCH_SIZE, nullptr, nullptr,
-                                           value[k] + col_row_counts[col_id],
-                                           &values_read);
-
-        // There are no NULL values in the rows written
-        col_row_counts[col_id] += rows_read;
+#include "arrow/api.h"
+#include "arrow/io/caching.h"
+#include "arrow/io/interfaces.h"
+#include "arrow/util/bit_util.h"
+#include "arrow/util/bitmap_ops.h"
+#include "parquet/arrow/reader.h"
+#include "parquet/metadata.h"
+#include "parquet/properties.h"
+#include "parquet/statistics.h"
+
+#include "graphar/context.h"
+#include "graphar/filesystem.h"
+#include "graphar/label_summary.h"
+#include "graphar/result.h"
+#include "graphar/status.h"
+
+namespace graphar {
+
+namespace {
+// copy a boolean column into the bitmap from the bit `offset`, a null value is
+// not set
+Status CopyLabelColumn(const std::shared_ptr<arrow::ChunkedArray>& column,
+                       uint8_t* out, int64_t offset) {
+  if (column->type()->id() != arrow::Type::BOOL) {
+    return Status::TypeError("The label column is of type ",
+                             column->type()->ToString(), ", but bool is ",
+                             "expected.");
+  }
+  for (const auto& chunk : column->chunks()) {
+    auto array = std::static_pointer_cast<arrow::BooleanArray>(chunk);
+    if (array->null_count() == 0) {
+      arrow::internal::CopyBitmap(array->values()->data(), array->offset(),
+                                  array->length(), out, offset);
+    } else {
+      arrow::internal::BitmapAnd(array->values()->data(), array->offset(),
+                                 array->null_bitmap_data(), array->offset(),
+                                 array->length(), offset, out);
+    }
+    offset += array->length();
+  }
+  return Status::OK();
+}
+
+// the value of all the rows of a bool column chunk if the statistics show it
+// is constant, a null value is taken as false. nullopt if the column chunk
+// has to be read.
+std::optional<bool> GetConstantValue(
+    const parquet::ColumnChunkMetaData& column_chunk) {
+  auto statistics = column_chunk.statistics();
+  if (statistics == nullptr ||
+      statistics->physical_type() != parquet::Type::BOOLEAN) {
+    return std::nullopt;
+  }
+  if (statistics->HasNullCount() &&
+      statistics->null_count() == column_chunk.num_values()) {
+    return false;
+  }
+  if (!statistics->HasMinMax()) {
+    return std::nullopt;
+  }
+  auto bool_statistics =
+      std::static_pointer_cast<parquet::BoolStatistics>(statistics);
+  if (!bool_statistics->max()) {
+    return false;
+  }
+  if (bool_statistics->min() && statistics->HasNullCount() &&
+      statistics->null_count() == 0) {
+    return true;
+  }
+  return std::nullopt;
+}
+
+// read the label columns of a parquet label chunk into bitmaps. The footer
+// statistics of every column chunk are checked first, a column chunk of one
+// value is not read, and the other column chunks are fetched with ranged
+// reads of only their bytes.
+Result<std::vector<std::vector<uint64_t>>> ReadParquetLabelBitmaps(
+    const std::shared_ptr<FileSystem>& fs, const std::string& path,
+    const std::vector<int>& columns, IdType row_num) {
+  GAR_ASSIGN_OR_RAISE(auto input, fs->OpenInputFile(path));
+  parquet::ArrowReaderProperties arrow_properties;
+  arrow_properties.set_pre_buffer(true);
+  arrow_properties.set_cache_options(arrow::io::CacheOptions::LazyDefaults());
+  parquet::arrow::FileReaderBuilder builder;
+  RETURN_NOT_ARROW_OK(builder.Open(input));
+  builder.properties(arrow_properties);
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto reader, builder.Build());
+  auto metadata = reader->parquet_reader()->metadata();
+  if (metadata->num_rows() != row_num) {
+    return Status::Invalid("The label chunk ", path, " has ",
+                           metadata->num_rows(), " rows, but ", row_num,
+                           " are expected.");
+  }
+  for (int column : columns) {
+    if (column >= metadata->num_columns()) {
+      return Status::IndexError("The label column ", column,
+                                " is out of range of the label chunk ", path);
+    }
+  }
+
+  std::vector<std::vector<uint64_t>> bitmaps(
+      columns.size(), std::vector<uint64_t>(BitmapWords(row_num), 0));
+  int64_t offset = 0;
+  for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+    auto row_group = metadata->RowGroup(rg);
+    int64_t rg_rows = row_group->num_rows();
+    std::vector<int> read_columns;
+    std::vector<size_t> read_slots;
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto value = GetConstantValue(*row_group->ColumnChunk(columns[i]));
+      if (!value.has_value()) {
+        read_columns.push_back(columns[i]);
+        read_slots.push_back(i);
+      } else if (value.value()) {
+        arrow::bit_util::SetBitsTo(
+            reinterpret_cast<uint8_t*>(bitmaps[i].data()), offset, rg_rows,
+            true);
+      }
+    }
+    if (!read_columns.empty()) {
+      std::shared_ptr<arrow::Table> table;
+      RETURN_NOT_ARROW_OK(reader->ReadRowGroup(rg, read_columns, &table));
+      for (size_t j = 0; j < read_slots.size(); ++j) {
+        GAR_RETURN_NOT_OK(CopyLabelColumn(
+            table->column(static_cast<int>(j)),
+            reinterpret_cast<uint8_t*>(bitmaps[read_slots[j]].data()),
+            offset));
       }
     }
+    offset += rg_rows;
+  }
+  return bitmaps;
+}
+
+// read the label columns of a label chunk into bitmaps
+Result<std::vector<std::vector<uint64_t>>> ReadLabelBitmaps(
+    const std::shared_ptr<FileSystem>& fs, const std::string& path,
+    FileType file_type, const std::vector<int>& columns, IdType row_num) {
+  if (file_type == FileType::PARQUET) {
+    return ReadParquetLabelBitmaps(fs, path, columns, row_num);
+  }
+  GAR_ASSIGN_OR_RAISE(auto table,
+                      fs->ReadFileToTable(path, file_type, columns));
+  if (table->num_rows() != row_num) {
+    return Status::Invalid("The label chunk ", path, " has ",
+                           table->num_rows(), " rows, but ", row_num,
+                           " are expected.");
+  }
+  std::vector<std::vector<uint64_t>> bitmaps(columns.size());
+  for (size_t i = 0; i < columns.size(); ++i) {
+    auto column = table->column(static_cast<int>(i));
+    GAR_ASSIGN_OR_RAISE(bitmaps[i], LabelColumnToBitmap(column));
+  }
+  return bitmaps;
+}
+
+// combine the bitmaps of the tested label columns
+std::vector<uint64_t> CombineLabelBitmaps(
+    std::vector<std::vector<uint64_t>> bitmaps, int64_t length,
+    LabelCombine combine) {
+  int64_t num_words = BitmapWords(length);
+  std::vector<uint64_t> result = std::move(bitmaps[0]);
+  for (size_t i = 1; i < bitmaps.size(); ++i) {
+    if (combine == LabelCombine::AND) {
+      BitmapAnd(result.data(), bitmaps[i].data(), num_words, result.data());
+    } else {
+      BitmapOr(result.data(), bitmaps[i].data(), num_words, result.data());
+    }
+  }
+  if (combine == LabelCombine::NOT) {
+    BitmapNot(result.data(), length, result.data());
+  }
+  return result;
+}
+
+// append the ids of the set bits of a chunk bitmap
+void AppendIndices(const std::vector<uint64_t>& bitmap, IdType offset,
+                   std::vector<IdType>* indices) {
+  for (size_t i = 0; i < bitmap.size(); ++i) {
+    uint64_t word = bitmap[i];
+    while (word != 0) {
+      int bit = arrow::bit_util::CountTrailingZeros(word);
+      indices->push_back(offset + static_cast<IdType>(i * 64 + bit));
+      word &= word - 1;
+    }
+  }
+}
+
+using ChunkEvaluator = std::function<Result<std::vector<uint64_t>>(
+    std::vector<std::vector<uint64_t>>, int64_t)>;
+
+// read and evaluate a label chunk
+Result<std::vector<uint64_t>> EvaluateLabelChunkFile(
+    const std::shared_ptr<FileSystem>& fs, const std::string& path,
+    FileType file_type, const std::vector<int>& columns,
+    const ChunkEvaluator& evaluate, IdType row_num) {
+  std::vector<std::vector<uint64_t>> bitmaps;
+  // a predicate that tests no label of the vertex type reads nothing
+  if (!columns.empty()) {
+    GAR_ASSIGN_OR_RAISE(
+        bitmaps, ReadLabelBitmaps(fs, path, file_type, columns, row_num));
   }
-  const int kTotLabelNum = tot_label_num;
-  bool state[kTotLabelNum];
-  int count = 0;
-  int offset = chunk_idx * chunk_size;
-  for (int i = 0; i < row_num; i++) {
-    for (int j = 0; j < tested_label_num; j++) {
-      state[j] = value[j][i];
+  return evaluate(std::move(bitmaps), row_num);
+}
+
+// what is known of a chunk before it is read, from its label summary
+using ChunkMatcher = std::function<LabelMatch(IdType, IdType)>;
+
+// read the bitmaps of the columns of the label chunks and evaluate them
+// concurrently, the bitmaps are passed in the order of the columns. A chunk
+// the matcher finds NONE or ALL of is not read.
+Result<LabelFilterResult> FilterLabelChunksWith(
+    const std::shared_ptr<FileSystem>& fs,
+    const std::string& label_chunk_prefix, FileType file_type,
+    IdType vertex_num, IdType chunk_size,
+    const std::vector<IdType>& chunk_indices, const std::vector<int>& columns,
+    const ChunkEvaluator& evaluate, const ChunkMatcher& match,
+    QUERY_TYPE query_type) {
+  std::vector<std::vector<uint64_t>> bitmaps(chunk_indices.size());
+  // the chunks that have to be read, and their row numbers
+  std::vector<size_t> slots;
+  std::vector<IdType> row_nums;
+  for (size_t i = 0; i < chunk_indices.size(); ++i) {
+    IdType chunk_index = chunk_indices[i];
+    IdType row_num =
+        std::min(chunk_size, vertex_num - chunk_index * chunk_size);
+    if (chunk_index < 0 || row_num <= 0) {
+      return Status::IndexError("The chunk index ", chunk_index,
+                                " is out of range for vertex num ",
+                                vertex_num, ".");
+    }
+    LabelMatch chunk_match =
+        match ? match(chunk_index, row_num) : LabelMatch::SOME;
+    if (chunk_match == LabelMatch::NONE) {
+      continue;
     }
-    if (IsValid(state, tested_label_num)) {
-      count++;
-      if (query_type == QUERY_TYPE::INDEX)
+    if (chunk_match == LabelMatch::ALL) {
+      bitmaps[i].assign(BitmapWords(row_num), 0);
+      BitmapNot(bitmaps[i].data(), row_num, bitmaps[i].data());
+      continue;
+    }
+    slots.push_back(i);
+    row_nums.push_back(row_num);
+  }
+  // the chunks are independent, read and evaluate them concurrently on the
+  // load executor, which waits for the file reads on the IO executor
+  GAR_RETURN_NOT_OK(ParallelLoad(
+      *ExecutionContext::Default(), static_cast<int64_t>(slots.size()),
+      [&](int64_t i) -> Status {
+        size_t slot = slots[i];
+        std::string path =
+            label_chunk_prefix + std::to_string(chunk_indices[slot]);
+        GAR_ASSIGN_OR_RAISE(bitmaps[slot],
+                            EvaluateLabelChunkFile(fs, path, file_type,
+                                                   columns, evaluate,
+                                                   row_nums[i]));
+        return Status::OK();
+      }));
 
-        indices->push_back(i + offset);
-      else if (query_type == QUERY_TYPE::BITMAP)
-        SetBitmap(bitmap, i);
+  LabelFilterResult result;
+  std::vector<int64_t> counts(bitmaps.size());
+  for (size_t i = 0; i < bitmaps.size(); ++i) {
+    counts[i] = BitmapCount(bitmaps[i].data(), bitmaps[i].size());
+    result.count += counts[i];
+    if (counts[i] != 0) {
+      result.valid_chunks.push_back(chunk_indices[i]);
     }
   }
+  result.type = query_type;
+  if (query_type == QUERY_TYPE::ADAPTIVE) {
+    // an index takes 64 bits and the bitmap one bit per vertex
+    result.type = result.count * 64 < vertex_num ? QUERY_TYPE::INDEX
+                                                 : QUERY_TYPE::BITMAP;
+  }
+  if (result.type == QUERY_TYPE::INDEX) {
+    result.indices.reserve(result.count);
+    for (size_t i = 0; i < bitmaps.size(); ++i) {
+      if (counts[i] != 0) {
+        AppendIndices(bitmaps[i], chunk_indices[i] * chunk_size,
+                      &result.indices);
+      }
+    }
+  } else if (result.type == QUERY_TYPE::BITMAP) {
+    result.bitmap.assign(BitmapWords(vertex_num), 0);
+    auto out = reinterpret_cast<uint8_t*>(result.bitmap.data());
+    for (size_t i = 0; i < bitmaps.size(); ++i) {
+      if (counts[i] == 0) {
+        continue;
+      }
+      IdType offset = chunk_indices[i] * chunk_size;
+      IdType row_num = std::min(chunk_size, vertex_num - offset);
+      if (offset % 64 == 0) {
+        std::memcpy(result.bitmap.data() + offset / 64, bitmaps[i].data(),
+                    bitmaps[i].size() * sizeof(uint64_t));
+      } else {
+        arrow::internal::CopyBitmap(
+            reinterpret_cast<const uint8_t*>(bitmaps[i].data()), 0, row_num,
+            out, offset);
+      }
+    }
+  }
+  return result;
+}
+
+// check that a NOT predicate has exactly one non-null operand
+Status ValidateNot(const std::shared_ptr<LabelPredicate>& predicate) {
+  const auto& operands = predicate->GetOperands();
+  if (operands.size() != 1 || operands[0] == nullptr) {
+    return Status::Invalid("NOT of a label predicate takes one operand.");
+  }
+  return Status::OK();
+}
+}  // namespace
+
+void BitmapAnd(const uint64_t* left, const uint64_t* right, int64_t num_words,
+               uint64_t* out) {
+  for (int64_t i = 0; i < num_words; ++i) {
+    out[i] = left[i] & right[i];
+  }
+}
+
+void BitmapOr(const uint64_t* left, const uint64_t* right, int64_t num_words,
+              uint64_t* out) {
+  for (int64_t i = 0; i < num_words; ++i) {
+    out[i] = left[i] | right[i];
+  }
+}
+
+void BitmapAndNot(const uint64_t* left, const uint64_t* right,
+                  int64_t num_words, uint64_t* out) {
+  for (int64_t i = 0; i < num_words; ++i) {
+    out[i] = left[i] & ~right[i];
+  }
+}
 
-  // destroy the allocated space
-  for (int i = 0; i < num_columns; i++) {
-    delete[] value[i];
+void BitmapNot(const uint64_t* bitmap, int64_t length, uint64_t* out) {
+  int64_t num_words = BitmapWords(length);
+  for (int64_t i = 0; i < num_words; ++i) {
+    out[i] = ~bitmap[i];
+  }
+  if (length % 64 != 0) {
+    out[num_words - 1] &= (1ULL << (length % 64)) - 1;
   }
-  delete[] value;
+}
 
+int64_t BitmapCount(const uint64_t* bitmap, int64_t num_words) {
+  int64_t count = 0;
+  for (int64_t i = 0; i < num_words; ++i) {
+    count += arrow::bit_util::PopCount(bitmap[i]);
+  }
   return count;
 }
+
+Result<std::vector<uint64_t>> LabelColumnToBitmap(
+    const std::shared_ptr<arrow::ChunkedArray>& column) {
+  std::vector<uint64_t> bitmap(BitmapWords(column->length()), 0);
+  GAR_RETURN_NOT_OK(
+      CopyLabelColumn(column, reinterpret_cast<uint8_t*>(bitmap.data()), 0));
+  return bitmap;
+}
+
+Result<std::vector<uint64_t>> EvaluateLabelChunk(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::vector<int>& label_columns, LabelCombine combine) {
+  if (label_columns.empty()) {
+    return Status::Invalid("No label is tested by the label filter.");
+  }
+  std::vector<std::vector<uint64_t>> bitmaps(label_columns.size());
+  for (size_t i = 0; i < label_columns.size(); ++i) {
+    int col = label_columns[i];
+    if (col < 0 || col >= table->num_columns()) {
+      return Status::IndexError("The label column ", col,
+                                " is out of range of the label chunk.");
+    }
+    GAR_ASSIGN_OR_RAISE(bitmaps[i], LabelColumnToBitmap(table->column(col)));
+  }
+  return CombineLabelBitmaps(std::move(bitmaps), table->num_rows(), combine);
+}
+
+std::shared_ptr<LabelPredicate> LabelPredicate::Label(
+    const std::string& label) {
+  return std::make_shared<LabelPredicate>(
+      Op::LABEL, label, std::vector<std::shared_ptr<LabelPredicate>>{});
+}
+
+std::shared_ptr<LabelPredicate> LabelPredicate::And(
+    const std::shared_ptr<LabelPredicate>& lhs,
+    const std::shared_ptr<LabelPredicate>& rhs) {
+  return std::make_shared<LabelPredicate>(
+      Op::AND, "", std::vector<std::shared_ptr<LabelPredicate>>{lhs, rhs});
+}
+
+std::shared_ptr<LabelPredicate> LabelPredicate::Or(
+    const std::shared_ptr<LabelPredicate>& lhs,
+    const std::shared_ptr<LabelPredicate>& rhs) {
+  return std::make_shared<LabelPredicate>(
+      Op::OR, "", std::vector<std::shared_ptr<LabelPredicate>>{lhs, rhs});
+}
+
+std::shared_ptr<LabelPredicate> LabelPredicate::Not(
+    const std::shared_ptr<LabelPredicate>& operand) {
+  return std::make_shared<LabelPredicate>(
+      Op::NOT, "", std::vector<std::shared_ptr<LabelPredicate>>{operand});
+}
+
+std::shared_ptr<LabelPredicate> LabelPredicate::AllOf(
+    const std::vector<std::string>& labels) {
+  std::shared_ptr<LabelPredicate> predicate;
+  for (const auto& label : labels) {
+    predicate = predicate ? And(predicate, Label(label)) : Label(label);
+  }
+  return predicate;
+}
+
+std::shared_ptr<LabelPredicate> LabelPredicate::AnyOf(
+    const std::vector<std::string>& labels) {
+  std::shared_ptr<LabelPredicate> predicate;
+  for (const auto& label : labels) {
+    predicate = predicate ? Or(predicate, Label(label)) : Label(label);
+  }
+  return predicate;
+}
+
+std::vector<std::string> LabelPredicate::GetLabels() const {
+  std::vector<std::string> labels;
+  if (op_ == Op::LABEL) {
+    labels.push_back(label_);
+    return labels;
+  }
+  for (const auto& operand : operands_) {
+    if (operand == nullptr) {
+      // an invalid predicate, rejected when it is compiled
+      continue;
+    }
+    for (auto& label : operand->GetLabels()) {
+      if (std::find(labels.begin(), labels.end(), label) == labels.end()) {
+        labels.push_back(std::move(label));
+      }
+    }
+  }
+  return labels;
+}
+
+std::string LabelPredicate::ToString() const {
+  switch (op_) {
+  case Op::LABEL:
+    return label_;
+  case Op::NOT:
+    return "NOT " + operands_[0]->ToString();
+  case Op::AND:
+    return "(" + operands_[0]->ToString() + " AND " +
+           operands_[1]->ToString() + ")";
+  case Op::OR:
+    return "(" + operands_[0]->ToString() + " OR " +
+           operands_[1]->ToString() + ")";
+  }
+  return "";
+}
+
+Result<CompiledLabelPredicate> CompiledLabelPredicate::Compile(
+    const std::shared_ptr<LabelPredicate>& predicate,
+    const std::vector<std::string>& labels) {
+  if (predicate == nullptr) {
+    return Status::Invalid("The label predicate is null.");
+  }
+  CompiledLabelPredicate compiled;
+  std::set<int> columns;
+  for (const auto& label : predicate->GetLabels()) {
+    auto it = std::find(labels.begin(), labels.end(), label);
+    if (it != labels.end()) {
+      columns.insert(static_cast<int>(std::distance(labels.begin(), it)));
+    }
+  }
+  compiled.label_columns_.assign(columns.begin(), columns.end());
+  GAR_RETURN_NOT_OK(compiled.Emit(predicate, labels));
+  return compiled;
+}
+
+Status CompiledLabelPredicate::Emit(
+    const std::shared_ptr<LabelPredicate>& predicate,
+    const std::vector<std::string>& labels) {
+  const auto& operands = predicate->GetOperands();
+  switch (predicate->GetOp()) {
+  case LabelPredicate::Op::LABEL: {
+    auto it = std::find(labels.begin(), labels.end(), predicate->GetLabel());
+    if (it == labels.end()) {
+      program_.push_back({Code::EMPTY, -1});
+      return Status::OK();
+    }
+    int column = static_cast<int>(std::distance(labels.begin(), it));
+    auto slot = std::lower_bound(label_columns_.begin(), label_columns_.end(),
+                                 column) -
+                label_columns_.begin();
+    program_.push_back({Code::LOAD, static_cast<int>(slot)});
+    return Status::OK();
+  }
+  case LabelPredicate::Op::NOT:
+    GAR_RETURN_NOT_OK(ValidateNot(predicate));
+    GAR_RETURN_NOT_OK(Emit(operands[0], labels));
+    program_.push_back({Code::NOT, -1});
+    return Status::OK();
+  case LabelPredicate::Op::AND:
+  case LabelPredicate::Op::OR: {
+    if (operands.size() != 2 || operands[0] == nullptr ||
+        operands[1] == nullptr) {
+      return Status::Invalid("AND and OR of label predicates take two ",
+                             "operands.");
+    }
+    GAR_RETURN_NOT_OK(Emit(operands[0], labels));
+    if (predicate->GetOp() == LabelPredicate::Op::AND &&
+        operands[1]->GetOp() == LabelPredicate::Op::NOT) {
+      // x AND NOT y in one pass, without negating y
+      GAR_RETURN_NOT_OK(ValidateNot(operands[1]));
+      GAR_RETURN_NOT_OK(Emit(operands[1]->GetOperands()[0], labels));
+      program_.push_back({Code::AND_NOT, -1});
+      return Status::OK();
+    }
+    GAR_RETURN_NOT_OK(Emit(operands[1], labels));
+    program_.push_back(
+        {predicate->GetOp() == LabelPredicate::Op::AND ? Code::AND : Code::OR,
+         -1});
+    return Status::OK();
+  }
+  }
+  return Status::Invalid("Unknown label predicate operator.");
+}
+
+Result<std::vector<uint64_t>> CompiledLabelPredicate::Evaluate(
+    const std::shared_ptr<arrow::Table>& table) const {
+  if (table->num_columns() != static_cast<int>(label_columns_.size())) {
+    return Status::Invalid("The label chunk has ", table->num_columns(),
+                           " columns, but the predicate reads ",
+                           label_columns_.size(), ".");
+  }
+  std::vector<std::vector<uint64_t>> columns(label_columns_.size());
+  for (int i = 0; i < table->num_columns(); ++i) {
+    GAR_ASSIGN_OR_RAISE(columns[i], LabelColumnToBitmap(table->column(i)));
+  }
+  return Evaluate(columns, table->num_rows());
+}
+
+Result<std::vector<uint64_t>> CompiledLabelPredicate::Evaluate(
+    const std::vector<std::vector<uint64_t>>& columns, int64_t length) const {
+  if (columns.size() != label_columns_.size()) {
+    return Status::Invalid("The predicate reads ", label_columns_.size(),
+                           " label columns, but got ", columns.size(), ".");
+  }
+  int64_t num_words = BitmapWords(length);
+  // the operands are on the top of the stack, the result replaces the left
+  std::vector<std::vector<uint64_t>> stack;
+  for (const auto& instruction : program_) {
+    switch (instruction.code) {
+    case Code::LOAD:
+      stack.push_back(columns[instruction.slot]);
+      break;
+    case Code::EMPTY:
+      stack.emplace_back(num_words, 0);
+      break;
+    case Code::NOT:
+      BitmapNot(stack.back().data(), length, stack.back().data());
+      break;
+    default: {
+      auto& left = stack[stack.size() - 2];
+      const auto& right = stack.back();
+      if (instruction.code == Code::AND) {
+        BitmapAnd(left.data(), right.data(), num_words, left.data());
+      } else if (instruction.code == Code::OR) {
+        BitmapOr(left.data(), right.data(), num_words, left.data());
+      } else {
+        BitmapAndNot(left.data(), right.data(), num_words, left.data());
+      }
+      stack.pop_back();
+      break;
+    }
+    }
+  }
+  return std::move(stack.back());
+}
+
+namespace {
+LabelMatch NotMatch(LabelMatch match) {
+  if (match == LabelMatch::SOME) {
+    return match;
+  }
+  return match == LabelMatch::ALL ? LabelMatch::NONE : LabelMatch::ALL;
+}
+
+LabelMatch AndMatch(LabelMatch left, LabelMatch right) {
+  if (left == LabelMatch::NONE || right == LabelMatch::NONE) {
+    return LabelMatch::NONE;
+  }
+  return left == LabelMatch::ALL && right == LabelMatch::ALL
+             ? LabelMatch::ALL
+             : LabelMatch::SOME;
+}
+}  // namespace
+
+LabelMatch CompiledLabelPredicate::Match(
+    const std::vector<LabelMatch>& columns) const {
+  if (columns.size() != label_columns_.size()) {
+    return LabelMatch::SOME;
+  }
+  std::vector<LabelMatch> stack;
+  for (const auto& instruction : program_) {
+    switch (instruction.code) {
+    case Code::LOAD:
+      stack.push_back(columns[instruction.slot]);
+      break;
+    case Code::EMPTY:
+      stack.push_back(LabelMatch::NONE);
+      break;
+    case Code::NOT:
+      stack.back() = NotMatch(stack.back());
+      break;
+    default: {
+      LabelMatch right = stack.back();
+      stack.pop_back();
+      LabelMatch& left = stack.back();
+      if (instruction.code == Code::AND) {
+        left = AndMatch(left, right);
+      } else if (instruction.code == Code::OR) {
+        // a OR b == NOT (NOT a AND NOT b)
+        left = NotMatch(AndMatch(NotMatch(left), NotMatch(right)));
+      } else {
+        left = AndMatch(left, NotMatch(right));
+      }
+      break;
+    }
+    }
+  }
+  return stack.back();
+}
+
+Result<LabelFilterResult> FilterLabelChunks(
+    const std::shared_ptr<FileSystem>& fs,
+    const std::string& label_chunk_prefix, FileType file_type,
+    IdType vertex_num, IdType chunk_size,
+    const std::vector<IdType>& chunk_indices,
+    const std::vector<int>& label_columns, LabelCombine combine,
+    QUERY_TYPE query_type) {
+  if (label_columns.empty()) {
+    return Status::Invalid("No label is tested by the label filter.");
+  }
+  // read each tested label column once
+  std::set<int> column_set(label_columns.begin(), label_columns.end());
+  std::vector<int> columns(column_set.begin(), column_set.end());
+  auto evaluate = [combine](std::vector<std::vector<uint64_t>> bitmaps,
+                            int64_t length) -> Result<std::vector<uint64_t>> {
+    return CombineLabelBitmaps(std::move(bitmaps), length, combine);
+  };
+  return FilterLabelChunksWith(fs, label_chunk_prefix, file_type, vertex_num,
+                               chunk_size, chunk_indices, columns, evaluate,
+                               nullptr, query_type);
+}
+
+Result<LabelFilterResult> FilterLabelChunks(
+    const std::shared_ptr<FileSystem>& fs,
+    const std::string& label_chunk_prefix, FileType file_type,
+    IdType vertex_num, IdType chunk_size,
+    const std::vector<IdType>& chunk_indices,
+    const CompiledLabelPredicate& predicate, QUERY_TYPE query_type,
+    const std::shared_ptr<const LabelSummary>& summary) {
+  auto evaluate = [predicate](std::vector<std::vector<uint64_t>> bitmaps,
+                              int64_t length) {
+    return predicate.Evaluate(bitmaps, length);
+  };
+  ChunkMatcher match;
+  if (summary != nullptr) {
+    match = [&summary, &predicate](IdType chunk_index, IdType row_num) {
+      return summary->Match(chunk_index, row_num, predicate);
+    };
+  }
+  return FilterLabelChunksWith(fs, label_chunk_prefix, file_type, vertex_num,
+                               chunk_size, chunk_indices,
+                               predicate.GetLabelColumns(), evaluate, match,
+                               query_type);
+}
+
+}  // namespace graphar
@@ -20,22 +20,19 @@
 #ifndef CPP_SRC_GRAPHAR_LABEL_H_
 #define CPP_SRC_GRAPHAR_LABEL_H_
 
-#include <arrow/io/file.h>
-#include <arrow/util/logging.h>
-#include <parquet/api/reader.h>
-#include <parquet/api/writer.h>
-#include <parquet/properties.h>
-
-#include <iostream>
-#include <set>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
-using parquet::ConvertedType;
-using parquet::Encoding;
-using parquet::Repetition;
-using parquet::Type;
-using parquet::schema::GroupNode;
-using parquet::schema::PrimitiveNode;
+#include "graphar/fwd.h"
+
+// forward declaration
+namespace arrow {
+class ChunkedArray;
+class Table;
+}  // namespace arrow
 
 constexpr int BATCH_SIZE = 1024;  // the batch size
 
@@ -48,15 +45,268 @@ enum QUERY_TYPE {
 };
 
 /// Set bit
-static inline void SetBitmap(uint64_t* bitmap, const int index) {
+static inline void SetBitmap(uint64_t* bitmap, const int64_t index) {
   bitmap[index >> 6] |= (1ULL << (index & 63));
 }
 
-int read_parquet_file_and_get_valid_indices(
-    const char* parquet_filename, const int row_num, const int tot_label_num,
-    const int tested_label_num, std::vector<int> tested_label_ids,
-    const std::function<bool(bool*, int)>& IsValid, int chunk_idx,
-    int chunk_size, std::vector<int>* indices = nullptr,
-    uint64_t* bitmap = nullptr, const QUERY_TYPE query_type = COUNT);
+namespace graphar {
+
+/// How the tested label columns of a label filter are combined
+enum class LabelCombine : char {
+  AND = 0,  // the vertex has all the tested labels
+  OR = 1,   // the vertex has any of the tested labels
+  NOT = 2   // the vertex has none of the tested labels
+};
+
+/// The valid vertices of a label filter
+struct LabelFilterResult {
+  /// COUNT, INDEX or BITMAP, the form the valid vertices are returned in
+  QUERY_TYPE type = QUERY_TYPE::COUNT;
+  /// The number of valid vertices
+  int64_t count = 0;
+  /// The internal ids of the valid vertices in ascending order, for INDEX
+  std::vector<IdType> indices;
+  /// Bit i is set if the vertex with internal id i is valid, for BITMAP
+  std::vector<uint64_t> bitmap;
+  /// The filtered chunks that have valid vertices in ascending order
+  std::vector<IdType> valid_chunks;
+};
+
+/// What the vertices of a chunk are known to satisfy without reading it
+enum class LabelMatch : char {
+  NONE = 0,  // no vertex of the chunk satisfies the test
+  ALL = 1,   // every vertex of the chunk satisfies the test
+  SOME = 2   // unknown, the chunk has to be read
+};
+
+/// The number of 64-bit words of a bitmap of `length` bits
+static inline int64_t BitmapWords(int64_t length) { return (length + 63) / 64; }
+
+/// out = left & right, word at a time, `out` may alias an input
+void BitmapAnd(const uint64_t* left, const uint64_t* right, int64_t num_words,
+               uint64_t* out);
+
+/// out = left | right, word at a time, `out` may alias an input
+void BitmapOr(const uint64_t* left, const uint64_t* right, int64_t num_words,
+              uint64_t* out);
+
+/// out = left & ~right, word at a time, `out` may alias an input
+void BitmapAndNot(const uint64_t* left, const uint64_t* right,
+                  int64_t num_words, uint64_t* out);
+
+/// out = ~bitmap over the first `length` bits, the bits past them are cleared
+void BitmapNot(const uint64_t* bitmap, int64_t length, uint64_t* out);
+
+/// The number of set bits of a bitmap
+int64_t BitmapCount(const uint64_t* bitmap, int64_t num_words);
+
+/**
+ * @brief Copy a boolean column into a word-aligned bitmap of its rows, a null
+ * value is read as false.
+ *
+ * @param column The boolean column.
+ * @return The bitmap, or TypeError if the column is not boolean.
+ */
+Result<std::vector<uint64_t>> LabelColumnToBitmap(
+    const std::shared_ptr<arrow::ChunkedArray>& column);
+
+/**
+ * @brief Evaluate a label filter over the rows of a label chunk, combining
+ * the bitmaps of the tested label columns a word at a time.
+ *
+ * @param table The label chunk.
+ * @param label_columns The indices of the tested label columns in the table.
+ * @param combine How the tested labels are combined.
+ * @return The bitmap of the valid rows of the chunk.
+ */
+Result<std::vector<uint64_t>> EvaluateLabelChunk(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::vector<int>& label_columns, LabelCombine combine);
+
+/**
+ * @brief Filter the vertices of a vertex type by its label chunks. The chunks
+ * are read with only the tested label columns and evaluated in parallel on
+ * the load executor of the default context (see ParallelLoad).
+ *
+ * A parquet label chunk is read through the file system with ranged reads:
+ * the footer statistics of the tested columns are checked first, a row group
+ * where a label is all false or all true is not read, and only the column
+ * chunks of the other row groups are fetched, so that a filter over a remote
+ * file system (e.g., S3) transfers the tested columns at most.
+ *
+ * @param fs The file system of the label chunks.
+ * @param label_chunk_prefix The path prefix of the label chunks in the file
+ * system, the chunk index is appended to it.
+ * @param file_type The file type of the label chunks.
+ * @param vertex_num The number of vertices of the vertex type.
+ * @param chunk_size The vertex chunk size.
+ * @param chunk_indices The indices of the chunks to filter in ascending order,
+ * the vertices of the other chunks are not valid.
+ * @param label_columns The indices of the tested labels.
+ * @param combine How the tested labels are combined.
+ * @param query_type COUNT, INDEX or BITMAP, or ADAPTIVE to return the indices
+ * if they are smaller than the bitmap, otherwise the bitmap.
+ */
+Result<LabelFilterResult> FilterLabelChunks(
+    const std::shared_ptr<FileSystem>& fs,
+    const std::string& label_chunk_prefix, FileType file_type,
+    IdType vertex_num, IdType chunk_size,
+    const std::vector<IdType>& chunk_indices,
+    const std::vector<int>& label_columns, LabelCombine combine,
+    QUERY_TYPE query_type = QUERY_TYPE::ADAPTIVE);
+
+/**
+ * @brief A boolean predicate over the labels of a vertex, a tree of AND, OR
+ * and NOT over label tests, e.g.,
+ * Or(And(Label("Person"), Not(Label("Bot"))), Label("Admin")).
+ */
+class LabelPredicate {
+ public:
+  enum class Op : char { LABEL = 0, AND = 1, OR = 2, NOT = 3 };
+
+  /** @brief The vertex has the label. */
+  static std::shared_ptr<LabelPredicate> Label(const std::string& label);
+
+  /** @brief Both predicates hold. */
+  static std::shared_ptr<LabelPredicate> And(
+      const std::shared_ptr<LabelPredicate>& lhs,
+      const std::shared_ptr<LabelPredicate>& rhs);
+
+  /** @brief Any of the predicates holds. */
+  static std::shared_ptr<LabelPredicate> Or(
+      const std::shared_ptr<LabelPredicate>& lhs,
+      const std::shared_ptr<LabelPredicate>& rhs);
+
+  /** @brief The predicate does not hold. */
+  static std::shared_ptr<LabelPredicate> Not(
+      const std::shared_ptr<LabelPredicate>& operand);
+
+  /** @brief The vertex has all the labels, which must not be empty. */
+  static std::shared_ptr<LabelPredicate> AllOf(
+      const std::vector<std::string>& labels);
+
+  /** @brief The vertex has any of the labels, which must not be empty. */
+  static std::shared_ptr<LabelPredicate> AnyOf(
+      const std::vector<std::string>& labels);
+
+  Op GetOp() const { return op_; }
+
+  /** @brief The tested label, for LABEL. */
+  const std::string& GetLabel() const { return label_; }
+
+  /** @brief The operands, one for NOT and two for AND and OR. */
+  const std::vector<std::shared_ptr<LabelPredicate>>& GetOperands() const {
+    return operands_;
+  }
+
+  /** @brief The labels tested by the predicate, each once. */
+  std::vector<std::string> GetLabels() const;
+
+  std::string ToString() const;
+
+  LabelPredicate(Op op, std::string label,
+                 std::vector<std::shared_ptr<LabelPredicate>> operands)
+      : op_(op), label_(std::move(label)), operands_(std::move(operands)) {}
+
+ private:
+  Op op_;
+  std::string label_;
+  std::vector<std::shared_ptr<LabelPredicate>> operands_;
+};
+
+/**
+ * @brief A LabelPredicate compiled against the labels of a vertex type into
+ * a postfix program over the bitmaps of the label columns, which the label
+ * kernel runs a word at a time without visiting the rows.
+ */
+class CompiledLabelPredicate {
+ public:
+  /**
+   * @brief Compile a predicate. A label the vertex type doesn't have is
+   * never set.
+   *
+   * @param predicate The predicate.
+   * @param labels The labels of the vertex type, in the order of the columns
+   * of the label chunks.
+   */
+  static Result<CompiledLabelPredicate> Compile(
+      const std::shared_ptr<LabelPredicate>& predicate,
+      const std::vector<std::string>& labels);
+
+  /**
+   * @brief The indices of the label columns the predicate reads, in
+   * ascending order.
+   */
+  const std::vector<int>& GetLabelColumns() const { return label_columns_; }
+
+  /**
+   * @brief Evaluate the predicate over a label chunk.
+   *
+   * @param table The label chunk with the columns of GetLabelColumns() in
+   * order.
+   * @return The bitmap of the rows that satisfy the predicate.
+   */
+  Result<std::vector<uint64_t>> Evaluate(
+      const std::shared_ptr<arrow::Table>& table) const;
+
+  /**
+   * @brief Evaluate the predicate over the bitmaps of a label chunk.
+   *
+   * @param columns The bitmaps of the columns of GetLabelColumns() in order.
+   * @param length The number of rows of the chunk.
+   * @return The bitmap of the rows that satisfy the predicate.
+   */
+  Result<std::vector<uint64_t>> Evaluate(
+      const std::vector<std::vector<uint64_t>>& columns,
+      int64_t length) const;
+
+  /**
+   * @brief Evaluate the predicate over what is known of the label columns of
+   * a chunk, e.g., from its label summary.
+   *
+   * @param columns The match of each column of GetLabelColumns() in order.
+   * @return NONE or ALL if it follows from the columns, otherwise SOME.
+   */
+  LabelMatch Match(const std::vector<LabelMatch>& columns) const;
+
+ private:
+  enum class Code : char {
+    LOAD = 0,   // push the bitmap of a column
+    EMPTY = 1,  // push an empty bitmap
+    AND = 2,
+    OR = 3,
+    AND_NOT = 4,  // the right operand of an AND is negated
+    NOT = 5
+  };
+  struct Instruction {
+    Code code;
+    int slot;
+  };
+
+  Status Emit(const std::shared_ptr<LabelPredicate>& predicate,
+              const std::vector<std::string>& labels);
+
+  std::vector<Instruction> program_;
+  std::vector<int> label_columns_;
+};
+
+/**
+ * @brief Filter the vertices of a vertex type by a compiled label predicate,
+ * see FilterLabelChunks above.
+ *
+ * @param summary The label summary of the vertex type, or nullptr. A chunk
+ * the summary shows to have no valid vertex is skipped, and a chunk of only
+ * valid vertices is taken whole, neither is read.
+ */
+Result<LabelFilterResult> FilterLabelChunks(
+    const std::shared_ptr<FileSystem>& fs,
+    const std::string& label_chunk_prefix, FileType file_type,
+    IdType vertex_num, IdType chunk_size,
+    const std::vector<IdType>& chunk_indices,
+    const CompiledLabelPredicate& predicate,
+    QUERY_TYPE query_type = QUERY_TYPE::ADAPTIVE,
+    const std::shared_ptr<const LabelSummary>& summary = nullptr);
+
+}  // namespace graphar
 
 #endif  // CPP_SRC_GRAPHAR_LABEL_H_
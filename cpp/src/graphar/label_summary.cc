@@ -0,0 +1,378 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "arrow/api.h"
+
+#include "graphar/filesystem.h"
+#include "graphar/general_params.h"
+#include "graphar/graph_info.h"
+#include "graphar/label_summary.h"
+#include "graphar/types.h"
+
+namespace graphar {
+
+namespace {
+std::mutex label_summary_registry_mutex;
+std::unordered_map<std::string, std::shared_ptr<const LabelSummary>>
+    label_summary_registry;
+
+std::string GetRegistryKey(const std::string& prefix,
+                           const std::shared_ptr<VertexInfo>& vertex_info) {
+  return prefix + vertex_info->GetPrefix();
+}
+
+// the columns of a row of the summary before the label counts
+constexpr size_t kVertexNumIndex = 0;
+constexpr size_t kLabelCountsIndex = 1;
+
+// the rows of the summary by chunk index, of the vertex count and the count
+// of each label
+using SummaryRows = std::map<IdType, std::vector<IdType>>;
+
+std::vector<std::string> GetSummaryColumns(
+    const std::vector<std::string>& labels) {
+  std::vector<std::string> columns = {GeneralParams::kChunkIndexCol,
+                                      GeneralParams::kVertexNumCol};
+  columns.insert(columns.end(), labels.begin(), labels.end());
+  return columns;
+}
+
+// read the rows of a summary table, a table that lacks a column of the labels
+// has no rows
+SummaryRows ReadSummaryRows(const std::shared_ptr<arrow::Table>& table,
+                            const std::vector<std::string>& labels) {
+  auto maybe_table = table->CombineChunks();
+  if (!maybe_table.ok()) {
+    return {};
+  }
+  auto combined = maybe_table.ValueUnsafe();
+  std::vector<const int64_t*> columns;
+  for (const auto& name : GetSummaryColumns(labels)) {
+    auto column = combined->GetColumnByName(name);
+    if (column == nullptr || column->type()->id() != arrow::Type::INT64 ||
+        column->null_count() != 0 || column->num_chunks() != 1) {
+      return {};
+    }
+    columns.push_back(
+        std::static_pointer_cast<arrow::Int64Array>(column->chunk(0))
+            ->raw_values());
+  }
+  SummaryRows rows;
+  for (int64_t i = 0; i < combined->num_rows(); ++i) {
+    std::vector<IdType> row(columns.size() - 1);
+    for (size_t j = 1; j < columns.size(); ++j) {
+      row[j - 1] = columns[j][i];
+    }
+    rows[columns[0][i]] = std::move(row);
+  }
+  return rows;
+}
+
+Result<std::shared_ptr<arrow::Table>> MakeSummaryTable(
+    const SummaryRows& rows, const std::vector<std::string>& labels) {
+  auto names = GetSummaryColumns(labels);
+  std::vector<arrow::Int64Builder> builders(names.size());
+  for (const auto& row : rows) {
+    auto status = builders[0].Append(row.first);
+    RETURN_NOT_ARROW_OK(status);
+    for (size_t j = 1; j < names.size(); ++j) {
+      status = builders[j].Append(row.second[j - 1]);
+      RETURN_NOT_ARROW_OK(status);
+    }
+  }
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> arrays;
+  for (size_t j = 0; j < names.size(); ++j) {
+    fields.push_back(arrow::field(names[j], arrow::int64(), false));
+    std::shared_ptr<arrow::Array> array;
+    auto status = builders[j].Finish(&array);
+    RETURN_NOT_ARROW_OK(status);
+    arrays.push_back(std::move(array));
+  }
+  return arrow::Table::Make(arrow::schema(fields), arrays);
+}
+
+// the generation of the summary, 0 if there is none, e.g., written by an
+// older writer, or if it fails to be read
+int64_t ReadGeneration(const std::shared_ptr<FileSystem>& fs,
+                       const std::string& prefix,
+                       const std::shared_ptr<VertexInfo>& vertex_info) {
+  auto maybe_generation = fs->ReadFileToValue<IdType>(
+      prefix + LabelSummary::GetGenerationPath(vertex_info));
+  return maybe_generation.has_error() ? 0 : maybe_generation.value();
+}
+
+// the generation of the summary for a writer, which fails unless the
+// generation is read or does not exist
+Result<int64_t> ReadGenerationToWrite(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info) {
+  std::string path = prefix + LabelSummary::GetGenerationPath(vertex_info);
+  auto maybe_generation = fs->ReadFileToValue<IdType>(path);
+  if (maybe_generation.has_value()) {
+    return maybe_generation.value();
+  }
+  GAR_ASSIGN_OR_RAISE(auto exists, fs->FileExists(path));
+  if (exists) {
+    return maybe_generation.status();
+  }
+  return 0;
+}
+
+// write the rows of the summary, then its generation, so that a reader that
+// sees the generation loads the rows
+Status WriteSummary(const std::shared_ptr<FileSystem>& fs,
+                    const std::string& prefix,
+                    const std::shared_ptr<VertexInfo>& vertex_info,
+                    const SummaryRows& rows, int64_t generation,
+                    const std::shared_ptr<WriterOptions>& options) {
+  GAR_ASSIGN_OR_RAISE(auto summary,
+                      MakeSummaryTable(rows, vertex_info->GetLabels()));
+  GAR_RETURN_NOT_OK(
+      fs->WriteTableToFile(summary, FileType::PARQUET,
+                           prefix + LabelSummary::GetSummaryPath(vertex_info),
+                           options));
+  return fs->WriteValueToFile<IdType>(
+      generation, prefix + LabelSummary::GetGenerationPath(vertex_info));
+}
+
+// load the summary of a generation
+std::shared_ptr<const LabelSummary> LoadSummary(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info, IdType vertex_num,
+    int64_t generation) {
+  const auto& labels = vertex_info->GetLabels();
+  IdType chunk_size = vertex_info->GetChunkSize();
+  IdType chunk_num = (vertex_num + chunk_size - 1) / chunk_size;
+  std::vector<IdType> vertex_nums(chunk_num, -1);
+  std::vector<std::vector<IdType>> label_counts(chunk_num);
+  // a vertex type without a summary, e.g., written by an older writer, has
+  // every chunk read by the filter
+  SummaryRows rows;
+  if (generation > 0) {
+    auto maybe_table = fs->ReadFileToTable(
+        prefix + LabelSummary::GetSummaryPath(vertex_info), FileType::PARQUET);
+    if (!maybe_table.has_error()) {
+      rows = ReadSummaryRows(maybe_table.value(), labels);
+    }
+  }
+  for (auto& row : rows) {
+    IdType i = row.first;
+    if (i < 0 || i >= chunk_num) {
+      continue;
+    }
+    vertex_nums[i] = row.second[kVertexNumIndex];
+    label_counts[i].assign(row.second.begin() + kLabelCountsIndex,
+                           row.second.end());
+  }
+  return std::make_shared<const LabelSummary>(labels, std::move(vertex_nums),
+                                              std::move(label_counts),
+                                              generation);
+}
+}  // namespace
+
+LabelSummary::LabelSummary(std::vector<std::string> labels,
+                           std::vector<IdType> vertex_nums,
+                           std::vector<std::vector<IdType>> label_counts,
+                           int64_t generation)
+    : labels_(std::move(labels)),
+      vertex_nums_(std::move(vertex_nums)),
+      label_counts_(std::move(label_counts)),
+      generation_(generation) {}
+
+bool LabelSummary::HasChunk(IdType chunk_index) const {
+  return chunk_index >= 0 && chunk_index < GetChunkNum() &&
+         vertex_nums_[chunk_index] >= 0;
+}
+
+Result<IdType> LabelSummary::GetLabelCount(IdType chunk_index,
+                                           const std::string& label) const {
+  if (!HasChunk(chunk_index)) {
+    return Status::KeyError("The chunk ", chunk_index,
+                            " has no label summary.");
+  }
+  auto it = std::find(labels_.begin(), labels_.end(), label);
+  if (it == labels_.end()) {
+    return Status::KeyError("The vertex type has no label ", label, ".");
+  }
+  return label_counts_[chunk_index][std::distance(labels_.begin(), it)];
+}
+
+LabelMatch LabelSummary::Match(IdType chunk_index, IdType row_num,
+                               const CompiledLabelPredicate& predicate) const {
+  if (!HasChunk(chunk_index) || vertex_nums_[chunk_index] != row_num) {
+    return LabelMatch::SOME;
+  }
+  const auto& counts = label_counts_[chunk_index];
+  const auto& label_columns = predicate.GetLabelColumns();
+  std::vector<LabelMatch> columns(label_columns.size());
+  for (size_t i = 0; i < label_columns.size(); ++i) {
+    if (label_columns[i] >= static_cast<int>(counts.size())) {
+      return LabelMatch::SOME;
+    }
+    IdType count = counts[label_columns[i]];
+    columns[i] = count == 0         ? LabelMatch::NONE
+                 : count == row_num ? LabelMatch::ALL
+                                    : LabelMatch::SOME;
+  }
+  return predicate.Match(columns);
+}
+
+Result<std::vector<IdType>> LabelSummary::CountLabels(
+    const std::shared_ptr<arrow::Table>& label_table) {
+  std::vector<IdType> counts;
+  for (int i = 0; i < label_table->num_columns(); ++i) {
+    auto column = label_table->column(i);
+    if (column->type()->id() != arrow::Type::BOOL) {
+      return Status::TypeError("The label column ",
+                               label_table->field(i)->name(), " is of type ",
+                               column->type()->ToString(), ", but bool is ",
+                               "expected.");
+    }
+    IdType count = 0;
+    for (const auto& chunk : column->chunks()) {
+      count += std::static_pointer_cast<arrow::BooleanArray>(chunk)
+                   ->true_count();
+    }
+    counts.push_back(count);
+  }
+  return counts;
+}
+
+std::string LabelSummary::GetSummaryPath(
+    const std::shared_ptr<VertexInfo>& vertex_info) {
+  return vertex_info->GetPrefix() + "labels/summary";
+}
+
+std::string LabelSummary::GetGenerationPath(
+    const std::shared_ptr<VertexInfo>& vertex_info) {
+  return vertex_info->GetPrefix() + "labels/generation";
+}
+
+Status LabelSummary::Write(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info,
+    const std::vector<IdType>& chunk_indices,
+    const std::vector<std::shared_ptr<arrow::Table>>& label_tables,
+    const std::shared_ptr<WriterOptions>& options) {
+  const auto& labels = vertex_info->GetLabels();
+  GAR_ASSIGN_OR_RAISE(auto generation,
+                      ReadGenerationToWrite(fs, prefix, vertex_info));
+  // keep the rows of the chunks that are not written, the rows of a summary
+  // without a generation may be stale
+  SummaryRows rows;
+  if (generation > 0) {
+    auto maybe_table = fs->ReadFileToTable(
+        prefix + GetSummaryPath(vertex_info), FileType::PARQUET);
+    if (!maybe_table.has_error()) {
+      rows = ReadSummaryRows(maybe_table.value(), labels);
+    }
+  }
+  for (size_t i = 0; i < chunk_indices.size(); ++i) {
+    const auto& label_table = label_tables[i];
+    std::vector<IdType> row(kLabelCountsIndex);
+    row[kVertexNumIndex] = label_table->num_rows();
+    // the label columns are in the order of the labels
+    GAR_ASSIGN_OR_RAISE(auto counts, CountLabels(label_table));
+    if (counts.size() != labels.size()) {
+      return Status::Invalid("The label chunk ", chunk_indices[i], " has ",
+                             counts.size(), " columns, but the vertex type ",
+                             "has ", labels.size(), " labels.");
+    }
+    row.insert(row.end(), counts.begin(), counts.end());
+    rows[chunk_indices[i]] = std::move(row);
+  }
+  return WriteSummary(fs, prefix, vertex_info, rows, generation + 1, options);
+}
+
+Status LabelSummary::Remove(const std::shared_ptr<FileSystem>& fs,
+                            const std::string& prefix,
+                            const std::shared_ptr<VertexInfo>& vertex_info,
+                            const std::vector<IdType>& chunk_indices,
+                            const std::shared_ptr<WriterOptions>& options) {
+  GAR_ASSIGN_OR_RAISE(auto generation,
+                      ReadGenerationToWrite(fs, prefix, vertex_info));
+  if (generation == 0) {
+    // the rows of a summary without a generation are not used
+    return Status::OK();
+  }
+  // the rows have to be read, otherwise a stale row would be kept
+  GAR_ASSIGN_OR_RAISE(auto table,
+                      fs->ReadFileToTable(prefix + GetSummaryPath(vertex_info),
+                                          FileType::PARQUET));
+  auto rows = ReadSummaryRows(table, vertex_info->GetLabels());
+  size_t num_rows = rows.size();
+  for (IdType chunk_index : chunk_indices) {
+    rows.erase(chunk_index);
+  }
+  if (rows.size() == num_rows) {
+    return Status::OK();
+  }
+  return WriteSummary(fs, prefix, vertex_info, rows, generation + 1, options);
+}
+
+Result<std::shared_ptr<const LabelSummary>> LabelSummary::Load(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info, IdType vertex_num) {
+  return LoadSummary(fs, prefix, vertex_info, vertex_num,
+                     ReadGeneration(fs, prefix, vertex_info));
+}
+
+Result<std::shared_ptr<const LabelSummary>> LabelSummary::Get(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info, IdType vertex_num) {
+  auto key = GetRegistryKey(prefix, vertex_info);
+  // the registered summary is valid as long as its generation is the latest,
+  // which is the only file read if it is
+  int64_t generation = ReadGeneration(fs, prefix, vertex_info);
+  IdType chunk_size = vertex_info->GetChunkSize();
+  IdType chunk_num = (vertex_num + chunk_size - 1) / chunk_size;
+  {
+    std::lock_guard<std::mutex> lock(label_summary_registry_mutex);
+    auto it = label_summary_registry.find(key);
+    if (it != label_summary_registry.end() &&
+        it->second->generation_ == generation &&
+        it->second->GetChunkNum() == chunk_num) {
+      return it->second;
+    }
+  }
+  auto summary = LoadSummary(fs, prefix, vertex_info, vertex_num, generation);
+  std::lock_guard<std::mutex> lock(label_summary_registry_mutex);
+  label_summary_registry[key] = summary;
+  return summary;
+}
+
+void LabelSummary::Invalidate(const std::string& prefix,
+                              const std::shared_ptr<VertexInfo>& vertex_info) {
+  std::lock_guard<std::mutex> lock(label_summary_registry_mutex);
+  label_summary_registry.erase(GetRegistryKey(prefix, vertex_info));
+}
+
+void LabelSummary::Clear() {
+  std::lock_guard<std::mutex> lock(label_summary_registry_mutex);
+  label_summary_registry.clear();
+}
+
+}  // namespace graphar
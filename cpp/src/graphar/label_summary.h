@@ -0,0 +1,222 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graphar/filesystem.h"
+#include "graphar/fwd.h"
+#include "graphar/label.h"
+#include "graphar/result.h"
+
+// forward declaration
+namespace arrow {
+class Table;
+}  // namespace arrow
+
+namespace graphar {
+
+/**
+ * @brief The number of vertices of each label in each chunk of a vertex
+ * type.
+ *
+ * The summary of a vertex type is one table next to its label chunks,
+ * written by VertexPropertyWriter::WriteLabelTable, with a row per chunk of
+ * the vertex count and a count column per label. A label filter checks the
+ * summary first and reads only the label chunks where the tested labels are
+ * neither absent nor on every vertex, so that a query of a rare label touches
+ * only the chunks that have it. A chunk without a row is always read.
+ *
+ * The row of a label chunk is removed from the summary before the chunk is
+ * rewritten and added back after, so the summary on the file system always
+ * matches the label chunks. Every write of the summary bumps a generation
+ * number stored in a small file beside it, and the registered summary is
+ * reused as long as the generation is unchanged, so that a query reads one
+ * small file to validate it.
+ */
+class LabelSummary {
+ public:
+  /**
+   * @brief Initialize the LabelSummary with the counts.
+   *
+   * @param labels The labels of the vertex type.
+   * @param vertex_nums The number of vertices of each chunk, -1 if the chunk
+   * has no summary.
+   * @param label_counts The number of vertices of each label of each chunk,
+   * in the order of the labels, empty if the chunk has no summary.
+   * @param generation The generation of the summary, 0 if there is none.
+   */
+  LabelSummary(std::vector<std::string> labels,
+               std::vector<IdType> vertex_nums,
+               std::vector<std::vector<IdType>> label_counts,
+               int64_t generation = 0);
+
+  /** @brief Get the number of chunks. */
+  IdType GetChunkNum() const {
+    return static_cast<IdType>(vertex_nums_.size());
+  }
+
+  /** @brief Get the generation of the summary, 0 if there is none. */
+  int64_t GetGeneration() const { return generation_; }
+
+  /** @brief Whether the chunk has a summary. */
+  bool HasChunk(IdType chunk_index) const;
+
+  /**
+   * @brief Get the number of vertices of a label in a chunk.
+   *
+   * @param chunk_index The index of the chunk.
+   * @param label The label.
+   * @return The count, or KeyError if the chunk has no summary or the vertex
+   * type has no such label.
+   */
+  Result<IdType> GetLabelCount(IdType chunk_index,
+                               const std::string& label) const;
+
+  /**
+   * @brief Evaluate a predicate over the summary of a chunk.
+   *
+   * @param chunk_index The index of the chunk.
+   * @param row_num The number of vertices of the chunk, a summary of another
+   * vertex count is stale and not used.
+   * @param predicate The predicate compiled against the labels of the
+   * vertex type.
+   * @return NONE or ALL if it follows from the counts, otherwise SOME.
+   */
+  LabelMatch Match(IdType chunk_index, IdType row_num,
+                   const CompiledLabelPredicate& predicate) const;
+
+  /**
+   * @brief Count the vertices of each label of a label chunk.
+   *
+   * @param label_table The label chunk, a boolean column per label.
+   * @return The count of each column of the label chunk.
+   */
+  static Result<std::vector<IdType>> CountLabels(
+      const std::shared_ptr<arrow::Table>& label_table);
+
+  /**
+   * @brief Get the path of the summary of a vertex type relative to the graph
+   * prefix.
+   *
+   * @param vertex_info The vertex info that describes the vertex type.
+   */
+  static std::string GetSummaryPath(
+      const std::shared_ptr<VertexInfo>& vertex_info);
+
+  /**
+   * @brief Get the path of the generation of the summary of a vertex type
+   * relative to the graph prefix.
+   *
+   * @param vertex_info The vertex info that describes the vertex type.
+   */
+  static std::string GetGenerationPath(
+      const std::shared_ptr<VertexInfo>& vertex_info);
+
+  /**
+   * @brief Write the summary of written label chunks, keeping the rows of the
+   * other chunks in the summary, and bump the generation. The label chunks
+   * have to be written before.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param vertex_info The vertex info that describes the vertex type.
+   * @param chunk_indices The indices of the label chunks.
+   * @param label_tables The label chunks, a boolean column per label.
+   * @param options The options to write the summary with.
+   */
+  static Status Write(
+      const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+      const std::shared_ptr<VertexInfo>& vertex_info,
+      const std::vector<IdType>& chunk_indices,
+      const std::vector<std::shared_ptr<arrow::Table>>& label_tables,
+      const std::shared_ptr<WriterOptions>& options);
+
+  /**
+   * @brief Remove the rows of label chunks that are about to be rewritten
+   * from the summary, and bump the generation.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param vertex_info The vertex info that describes the vertex type.
+   * @param chunk_indices The indices of the label chunks.
+   * @param options The options to write the summary with.
+   */
+  static Status Remove(const std::shared_ptr<FileSystem>& fs,
+                       const std::string& prefix,
+                       const std::shared_ptr<VertexInfo>& vertex_info,
+                       const std::vector<IdType>& chunk_indices,
+                       const std::shared_ptr<WriterOptions>& options);
+
+  /**
+   * @brief Load the summary of a vertex type. A chunk without a row has no
+   * summary.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param vertex_info The vertex info that describes the vertex type.
+   * @param vertex_num The number of vertices of the vertex type.
+   */
+  static Result<std::shared_ptr<const LabelSummary>> Load(
+      const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+      const std::shared_ptr<VertexInfo>& vertex_info, IdType vertex_num);
+
+  /**
+   * @brief Get the summary of a vertex type from the process-wide registry,
+   * loading it on the first call or once its generation changes.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param vertex_info The vertex info that describes the vertex type.
+   * @param vertex_num The number of vertices of the vertex type.
+   */
+  static Result<std::shared_ptr<const LabelSummary>> Get(
+      const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+      const std::shared_ptr<VertexInfo>& vertex_info, IdType vertex_num);
+
+  /**
+   * @brief Drop the registered summary of a vertex type, e.g., after its
+   * label chunks are rewritten.
+   *
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param vertex_info The vertex info that describes the vertex type.
+   */
+  static void Invalidate(const std::string& prefix,
+                         const std::shared_ptr<VertexInfo>& vertex_info);
+
+  /** @brief Drop all the registered summaries. */
+  static void Clear();
+
+ private:
+  std::vector<std::string> labels_;
+  std::vector<IdType> vertex_nums_;
+  std::vector<std::vector<IdType>> label_counts_;
+  int64_t generation_;
+};
+
+}  // namespace graphar
@@ -0,0 +1,243 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <unordered_map>
+#include <utility>
+
+#include "arrow/api.h"
+
+#include "graphar/filesystem.h"
+#include "graphar/graph_info.h"
+#include "graphar/offset_index.h"
+#include "graphar/parallel_load.h"
+#include "graphar/reader_util.h"
+#include "graphar/types.h"
+
+namespace graphar {
+
+namespace {
+std::mutex offset_index_registry_mutex;
+std::unordered_map<std::string, std::shared_ptr<OffsetIndex>>
+    offset_index_registry;
+
+Result<std::string> GetRegistryKey(const std::string& prefix,
+                                   const std::shared_ptr<EdgeInfo>& edge_info,
+                                   AdjListType adj_list_type) {
+  GAR_ASSIGN_OR_RAISE(auto offset_path_prefix,
+                      edge_info->GetOffsetPathPrefix(adj_list_type));
+  return prefix + offset_path_prefix;
+}
+
+// read the offset chunk of a vertex chunk into a contiguous int64 array
+Result<std::shared_ptr<arrow::Int64Array>> LoadOffsetChunk(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type,
+    IdType vertex_chunk_index) {
+  GAR_ASSIGN_OR_RAISE(auto offset_file_path,
+                      edge_info->GetAdjListOffsetFilePath(vertex_chunk_index,
+                                                          adj_list_type));
+  auto file_type = edge_info->GetAdjacentList(adj_list_type)->GetFileType();
+  GAR_ASSIGN_OR_RAISE(
+      auto table, fs->ReadFileToTable(prefix + offset_file_path, file_type));
+  if (table->num_columns() == 0 ||
+      table->column(0)->type()->id() != arrow::Type::INT64) {
+    return Status::TypeError("The offset chunk ", vertex_chunk_index,
+                             " of edge ", edge_info->GetEdgeType(),
+                             " is not an int64 column.");
+  }
+  auto column = table->column(0);
+  std::shared_ptr<arrow::Array> array;
+  if (column->num_chunks() == 1) {
+    array = column->chunk(0);
+  } else {
+    // flatten the chunks into one contiguous buffer
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        array, arrow::Concatenate(column->chunks(),
+                                  arrow::default_memory_pool()));
+  }
+  return std::static_pointer_cast<arrow::Int64Array>(array);
+}
+}  // namespace
+
+OffsetIndex::OffsetIndex(const std::shared_ptr<FileSystem>& fs,
+                         const std::string& prefix,
+                         const std::shared_ptr<EdgeInfo>& edge_info,
+                         AdjListType adj_list_type, IdType vertex_chunk_num)
+    : fs_(fs),
+      prefix_(prefix),
+      edge_info_(edge_info),
+      adj_list_type_(adj_list_type),
+      vertex_chunk_size_(adj_list_type == AdjListType::ordered_by_source
+                             ? edge_info->GetSrcChunkSize()
+                             : edge_info->GetDstChunkSize()),
+      vertex_chunk_num_(vertex_chunk_num),
+      chunks_(vertex_chunk_num) {}
+
+Result<std::shared_ptr<OffsetIndex>> OffsetIndex::Make(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type) {
+  if (adj_list_type != AdjListType::ordered_by_source &&
+      adj_list_type != AdjListType::ordered_by_dest) {
+    return Status::Invalid(
+        "The adj list type has to be ordered_by_source or ordered_by_dest, but "
+        "got ",
+        std::string(AdjListTypeToString(adj_list_type)));
+  }
+  if (!edge_info->HasAdjacentListType(adj_list_type)) {
+    return Status::KeyError(
+        "The adjacent list type ", AdjListTypeToString(adj_list_type),
+        " doesn't exist in edge ", edge_info->GetEdgeType(), ".");
+  }
+  GAR_ASSIGN_OR_RAISE(auto vertex_chunk_num,
+                      util::GetVertexChunkNum(fs, prefix, edge_info,
+                                              adj_list_type));
+  return std::make_shared<OffsetIndex>(fs, prefix, edge_info, adj_list_type,
+                                       vertex_chunk_num);
+}
+
+Result<std::shared_ptr<OffsetIndex>> OffsetIndex::Get(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type) {
+  GAR_ASSIGN_OR_RAISE(auto key,
+                      GetRegistryKey(prefix, edge_info, adj_list_type));
+  {
+    std::lock_guard<std::mutex> lock(offset_index_registry_mutex);
+    auto it = offset_index_registry.find(key);
+    if (it != offset_index_registry.end()) {
+      return it->second;
+    }
+  }
+  GAR_ASSIGN_OR_RAISE(auto index, Make(fs, prefix, edge_info, adj_list_type));
+  std::lock_guard<std::mutex> lock(offset_index_registry_mutex);
+  return offset_index_registry.emplace(key, index).first->second;
+}
+
+Result<std::shared_ptr<OffsetIndex>> OffsetIndex::Get(
+    const std::string& prefix, const std::shared_ptr<EdgeInfo>& edge_info,
+    AdjListType adj_list_type) {
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  return Get(fs, out_prefix, edge_info, adj_list_type);
+}
+
+void OffsetIndex::Invalidate(const std::string& prefix,
+                             const std::shared_ptr<EdgeInfo>& edge_info,
+                             AdjListType adj_list_type) {
+  auto maybe_key = GetRegistryKey(prefix, edge_info, adj_list_type);
+  if (maybe_key.has_error()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(offset_index_registry_mutex);
+  offset_index_registry.erase(maybe_key.value());
+}
+
+void OffsetIndex::Clear() {
+  std::lock_guard<std::mutex> lock(offset_index_registry_mutex);
+  offset_index_registry.clear();
+}
+
+Result<OffsetIndex::range_t> OffsetIndex::GetRange(IdType vid) {
+  if (vid < 0 || vid / vertex_chunk_size_ >= vertex_chunk_num_) {
+    return Status::IndexError("Internal vertex id ", vid,
+                              " is out of range [0,",
+                              vertex_chunk_num_ * vertex_chunk_size_,
+                              ") of edge ", edge_info_->GetEdgeType(),
+                              " of adj list type ",
+                              AdjListTypeToString(adj_list_type_), ".");
+  }
+  IdType vertex_chunk_index = vid / vertex_chunk_size_;
+  IdType offset_in_chunk = vid % vertex_chunk_size_;
+  const arrow::Int64Array* offsets =
+      chunks_[vertex_chunk_index].array.load(std::memory_order_acquire);
+  if (offsets == nullptr) {
+    // the loaded chunk is owned by the index, the pointer stays valid
+    GAR_ASSIGN_OR_RAISE(auto loaded, GetOffsetChunk(vertex_chunk_index));
+    offsets = loaded.get();
+  }
+  if (offset_in_chunk + 1 >= offsets->length()) {
+    return Status::IndexError("Internal vertex id ", vid,
+                              " is out of range of the offset chunk ",
+                              vertex_chunk_index, " of edge ",
+                              edge_info_->GetEdgeType(), ".");
+  }
+  const int64_t* values = offsets->raw_values();
+  return std::make_pair(static_cast<IdType>(values[offset_in_chunk]),
+                        static_cast<IdType>(values[offset_in_chunk + 1]));
+}
+
+Result<std::shared_ptr<arrow::Int64Array>> OffsetIndex::GetOffsetChunk(
+    IdType vertex_chunk_index) {
+  if (vertex_chunk_index < 0 || vertex_chunk_index >= vertex_chunk_num_) {
+    return Status::IndexError("vertex chunk index ", vertex_chunk_index,
+                              " is out-of-bounds for vertex chunk num ",
+                              vertex_chunk_num_, ".");
+  }
+  auto& chunk = chunks_[vertex_chunk_index];
+  if (chunk.array.load(std::memory_order_acquire) != nullptr) {
+    return chunk.owner;
+  }
+  // load without holding the lock, a concurrent load of the same chunk
+  // produces the same array and the first one is published
+  GAR_ASSIGN_OR_RAISE(auto offsets,
+                      LoadOffsetChunk(fs_, prefix_, edge_info_, adj_list_type_,
+                                      vertex_chunk_index));
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (chunk.array.load(std::memory_order_relaxed) == nullptr) {
+    chunk.owner = std::move(offsets);
+    chunk.array.store(chunk.owner.get(), std::memory_order_release);
+  }
+  return chunk.owner;
+}
+
+Status OffsetIndex::LoadAll() {
+  std::vector<IdType> chunk_indices;
+  for (IdType i = 0; i < vertex_chunk_num_; ++i) {
+    if (!IsLoaded(i)) {
+      chunk_indices.push_back(i);
+    }
+  }
+  // the loads wait for the file reads on the IO thread pool, so they run on
+  // the load thread pool
+  return ParallelLoad(GetLoadThreadPool(),
+                      static_cast<int64_t>(chunk_indices.size()),
+                      [&](int64_t i) -> Status {
+                        return GetOffsetChunk(chunk_indices[i]).status();
+                      });
+}
+
+bool OffsetIndex::IsLoaded(IdType vertex_chunk_index) const {
+  if (vertex_chunk_index < 0 || vertex_chunk_index >= vertex_chunk_num_) {
+    return false;
+  }
+  return chunks_[vertex_chunk_index].array.load(std::memory_order_acquire) !=
+         nullptr;
+}
+
+int64_t OffsetIndex::GetMemoryUsage() const {
+  int64_t size = 0;
+  for (const auto& chunk : chunks_) {
+    const auto* array = chunk.array.load(std::memory_order_acquire);
+    if (array != nullptr) {
+      size += array->length() * static_cast<int64_t>(sizeof(int64_t));
+    }
+  }
+  return size;
+}
+
+}  // namespace graphar
@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "graphar/fwd.h"
+#include "graphar/result.h"
+
+// forward declaration
+namespace arrow {
+class Int64Array;
+}  // namespace arrow
+
+namespace graphar {
+
+/**
+ * @brief The offset arrays of an ordered adjacency list pinned in memory.
+ *
+ * The offset chunk of a vertex chunk is decoded once into a flat int64 array
+ * and kept, so that the edge range [begin, end) of a vertex is two memory
+ * reads instead of opening and decoding the offset chunk file. The chunks are
+ * loaded lazily on first access, or all at once by LoadAll(). A chunk is
+ * published once and never replaced, so the lookups of loaded chunks take no
+ * lock.
+ */
+class OffsetIndex {
+ public:
+  using range_t = std::pair<IdType, IdType>;
+
+  /**
+   * @brief Initialize the OffsetIndex without loading any offset chunk.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type, ordered_by_source or
+   * ordered_by_dest.
+   * @param vertex_chunk_num The number of vertex chunks.
+   */
+  OffsetIndex(const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+              const std::shared_ptr<EdgeInfo>& edge_info,
+              AdjListType adj_list_type, IdType vertex_chunk_num);
+
+  /**
+   * @brief Create an OffsetIndex of an ordered adjacency list.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type, ordered_by_source or
+   * ordered_by_dest.
+   */
+  static Result<std::shared_ptr<OffsetIndex>> Make(
+      const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+      const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type);
+
+  /**
+   * @brief Get the index of an ordered adjacency list from the process-wide
+   * registry, creating it on the first call.
+   *
+   * @param fs The file system of the graph.
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type, ordered_by_source or
+   * ordered_by_dest.
+   */
+  static Result<std::shared_ptr<OffsetIndex>> Get(
+      const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+      const std::shared_ptr<EdgeInfo>& edge_info, AdjListType adj_list_type);
+
+  /**
+   * @brief Get the index of an ordered adjacency list from the process-wide
+   * registry, creating it on the first call.
+   *
+   * @param prefix The absolute prefix or URI of the graph.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type, ordered_by_source or
+   * ordered_by_dest.
+   */
+  static Result<std::shared_ptr<OffsetIndex>> Get(
+      const std::string& prefix, const std::shared_ptr<EdgeInfo>& edge_info,
+      AdjListType adj_list_type);
+
+  /**
+   * @brief Drop the registered index of an adjacency list, e.g., after its
+   * offset chunks are rewritten.
+   *
+   * @param prefix The path prefix of the graph resolved by
+   * FileSystemFromUriOrPath.
+   * @param edge_info The edge info that describes the edge type.
+   * @param adj_list_type The adj list type.
+   */
+  static void Invalidate(const std::string& prefix,
+                         const std::shared_ptr<EdgeInfo>& edge_info,
+                         AdjListType adj_list_type);
+
+  /** @brief Drop all the registered indices. */
+  static void Clear();
+
+  /**
+   * @brief Get the edge offset range [begin, end) of a vertex, loading its
+   * offset chunk if it is not loaded yet.
+   *
+   * @param vid The internal id of the vertex.
+   * @return The offset range, or IndexError if the id is out of range.
+   */
+  Result<range_t> GetRange(IdType vid);
+
+  /**
+   * @brief Get the whole offset array of a vertex chunk, loading it if it is
+   * not loaded yet. The array has one more entry than the vertex chunk.
+   *
+   * @param vertex_chunk_index The index of the vertex chunk.
+   */
+  Result<std::shared_ptr<arrow::Int64Array>> GetOffsetChunk(
+      IdType vertex_chunk_index);
+
+  /** @brief Load all the offset chunks in parallel on the load thread pool. */
+  Status LoadAll();
+
+  /** @brief Whether the offset chunk of a vertex chunk is loaded. */
+  bool IsLoaded(IdType vertex_chunk_index) const;
+
+  /** @brief Get the total size in bytes of the loaded offset arrays. */
+  int64_t GetMemoryUsage() const;
+
+  /** @brief Get the vertex chunk size of the adjacency list. */
+  IdType GetVertexChunkSize() const { return vertex_chunk_size_; }
+
+  /** @brief Get the number of vertex chunks. */
+  IdType GetVertexChunkNum() const { return vertex_chunk_num_; }
+
+ private:
+  std::shared_ptr<FileSystem> fs_;
+  std::string prefix_;
+  std::shared_ptr<EdgeInfo> edge_info_;
+  AdjListType adj_list_type_;
+  IdType vertex_chunk_size_;
+  IdType vertex_chunk_num_;
+
+  // an offset chunk, `array` is set once `owner` is set and is read without
+  // the lock
+  struct LoadedChunk {
+    std::atomic<const arrow::Int64Array*> array{nullptr};
+    std::shared_ptr<arrow::Int64Array> owner;
+  };
+
+  // serializes the publication of the chunks
+  std::mutex mutex_;
+  std::vector<LoadedChunk> chunks_;
+};
+
+}  // namespace graphar
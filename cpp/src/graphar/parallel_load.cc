@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/util/future.h"
+#include "arrow/util/thread_pool.h"
+
+#include "graphar/parallel_load.h"
+#include "graphar/status.h"
+
+namespace graphar {
+
+arrow::internal::Executor* GetLoadThreadPool() {
+  static std::shared_ptr<arrow::internal::ThreadPool> pool =
+      arrow::internal::ThreadPool::MakeEternal(
+          arrow::GetCpuThreadPoolCapacity())
+          .ValueOrDie();
+  return pool.get();
+}
+
+Status ParallelLoad(arrow::internal::Executor* executor, int64_t num_loads,
+                    const std::function<Status(int64_t index)>& load) {
+  if (num_loads == 1 || executor->OwnsThisThread()) {
+    for (int64_t i = 0; i < num_loads; ++i) {
+      GAR_RETURN_NOT_OK(load(i));
+    }
+    return Status::OK();
+  }
+  std::vector<arrow::Future<>> futures;
+  futures.reserve(num_loads);
+  std::mutex mutex;
+  Status status = Status::OK();
+  for (int64_t i = 0; i < num_loads; ++i) {
+    auto maybe_future = executor->Submit([&, i]() {
+      auto load_status = load(i);
+      if (!load_status.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (status.ok()) {
+          status = load_status;
+        }
+      }
+    });
+    if (!maybe_future.ok()) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (status.ok()) {
+        status = Status::ArrowError(maybe_future.status().ToString());
+      }
+      break;
+    }
+    futures.push_back(std::move(maybe_future).ValueUnsafe());
+  }
+  // the loads refer to the locals, wait for all of them before returning
+  for (auto& future : futures) {
+    future.Wait();
+  }
+  return status;
+}
+
+}  // namespace graphar
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "graphar/fwd.h"
+
+// forward declaration
+namespace arrow::internal {
+class Executor;
+}  // namespace arrow::internal
+
+namespace graphar {
+
+/**
+ * @brief Get the thread pool of graphar for the parallel chunk loads.
+ *
+ * A load waits for its file reads, which are scheduled on the arrow IO
+ * thread pool, so the loads run on a pool of their own. Loads queued on the
+ * IO thread pool would hold the threads that their reads need.
+ */
+arrow::internal::Executor* GetLoadThreadPool();
+
+/**
+ * @brief Run loads in parallel on an executor and wait for all of them.
+ *
+ * The loads run one after another on the calling thread if it is a thread of
+ * the executor, so that a load may start loads of its own.
+ *
+ * @param executor The executor of the loads, e.g., GetLoadThreadPool(). It
+ * can not be the executor that the loads wait on for their file reads.
+ * @param num_loads The number of loads.
+ * @param load The load of an index in [0, num_loads).
+ * @return The error of the first failed load, or OK.
+ */
+Status ParallelLoad(arrow::internal::Executor* executor, int64_t num_loads,
+                    const std::function<Status(int64_t index)>& load);
+
+}  // namespace graphar
@@ -28,7 +28,9 @@
 
 #include "graphar/expression.h"
 #include "graphar/filesystem.h"
+#include "graphar/graph_count_index.h"
 #include "graphar/graph_info.h"
+#include "graphar/offset_index.h"
 #include "graphar/reader_util.h"
 #include "graphar/types.h"
 
@@ -72,7 +74,6 @@ Status CheckFilterOptions(
  * @brief parse the vertex id to related adj list offset
  *
  * @param edge_info edge info
- * @param vertex_chunk_size vertex chunk size
  * @param prefix prefix of the payload files
  * @param adj_list_type adj list type to find the offset
  * @param vid vertex id
@@ -82,38 +83,20 @@ Status CheckFilterOptions(
 Result<std::pair<IdType, IdType>> GetAdjListOffsetOfVertex(
     const std::shared_ptr<EdgeInfo>& edge_info, const std::string& prefix,
     AdjListType adj_list_type, IdType vid) noexcept {
-  // get the adj list offset of id
-  IdType vertex_chunk_size;
-  if (adj_list_type == AdjListType::ordered_by_source) {
-    vertex_chunk_size = edge_info->GetSrcChunkSize();
-  } else if (adj_list_type == AdjListType::ordered_by_dest) {
-    vertex_chunk_size = edge_info->GetDstChunkSize();
-  } else {
-    return Status::Invalid(
-        "The adj list type has to be ordered_by_source or ordered_by_dest, but "
-        "got ",
-        std::string(AdjListTypeToString(adj_list_type)));
-  }
-
-  IdType offset_chunk_index = vid / vertex_chunk_size;
-  IdType offset_in_file = vid % vertex_chunk_size;
-  GAR_ASSIGN_OR_RAISE(
-      auto offset_file_path,
-      edge_info->GetAdjListOffsetFilePath(offset_chunk_index, adj_list_type));
   std::string out_prefix;
   GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
-  auto adjacent_list = edge_info->GetAdjacentList(adj_list_type);
-  if (adjacent_list == nullptr) {
-    return Status::Invalid("The adjacent list is not set for adj list type ",
-                           std::string(AdjListTypeToString(adj_list_type)));
-  }
-  auto file_type = adjacent_list->GetFileType();
-  std::string path = out_prefix + offset_file_path;
-  GAR_ASSIGN_OR_RAISE(auto table, fs->ReadFileToTable(path, file_type));
-  auto array = std::static_pointer_cast<arrow::Int64Array>(
-      table->column(0)->Slice(offset_in_file, 2)->chunk(0));
-  return std::make_pair(static_cast<IdType>(array->Value(0)),
-                        static_cast<IdType>(array->Value(1)));
+  return GetAdjListOffsetOfVertex(edge_info, fs, out_prefix, adj_list_type,
+                                  vid);
+}
+
+Result<std::pair<IdType, IdType>> GetAdjListOffsetOfVertex(
+    const std::shared_ptr<EdgeInfo>& edge_info,
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    AdjListType adj_list_type, IdType vid) noexcept {
+  // the offset chunks are pinned by the offset index after the first read
+  GAR_ASSIGN_OR_RAISE(auto offset_index,
+                      OffsetIndex::Get(fs, prefix, edge_info, adj_list_type));
+  return offset_index->GetRange(vid);
 }
 
 Result<IdType> GetVertexChunkNum(
@@ -121,11 +104,13 @@ Result<IdType> GetVertexChunkNum(
     const std::shared_ptr<VertexInfo>& vertex_info) noexcept {
   std::string out_prefix;
   GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
-  GAR_ASSIGN_OR_RAISE(auto vertex_num_file_suffix,
-                      vertex_info->GetVerticesNumFilePath());
-  std::string vertex_num_file_path = out_prefix + vertex_num_file_suffix;
-  GAR_ASSIGN_OR_RAISE(auto vertex_num,
-                      fs->ReadFileToValue<IdType>(vertex_num_file_path));
+  return GetVertexChunkNum(fs, out_prefix, vertex_info);
+}
+
+Result<IdType> GetVertexChunkNum(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info) noexcept {
+  GAR_ASSIGN_OR_RAISE(auto vertex_num, GetVertexNum(fs, prefix, vertex_info));
   return (vertex_num + vertex_info->GetChunkSize() - 1) /
          vertex_info->GetChunkSize();
 }
@@ -135,9 +120,15 @@ Result<IdType> GetVertexNum(
     const std::shared_ptr<VertexInfo>& vertex_info) noexcept {
   std::string out_prefix;
   GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  return GetVertexNum(fs, out_prefix, vertex_info);
+}
+
+Result<IdType> GetVertexNum(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info) noexcept {
   GAR_ASSIGN_OR_RAISE(auto vertex_num_file_suffix,
                       vertex_info->GetVerticesNumFilePath());
-  std::string vertex_num_file_path = out_prefix + vertex_num_file_suffix;
+  std::string vertex_num_file_path = prefix + vertex_num_file_suffix;
   GAR_ASSIGN_OR_RAISE(auto vertex_num,
                       fs->ReadFileToValue<IdType>(vertex_num_file_path));
   return vertex_num;
@@ -148,11 +139,15 @@ Result<IdType> GetVertexChunkNum(const std::string& prefix,
                                  AdjListType adj_list_type) noexcept {
   std::string out_prefix;
   GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
-  GAR_ASSIGN_OR_RAISE(auto vertex_num_file_suffix,
-                      edge_info->GetVerticesNumFilePath(adj_list_type));
-  std::string vertex_num_file_path = out_prefix + vertex_num_file_suffix;
+  return GetVertexChunkNum(fs, out_prefix, edge_info, adj_list_type);
+}
+
+Result<IdType> GetVertexChunkNum(const std::shared_ptr<FileSystem>& fs,
+                                 const std::string& prefix,
+                                 const std::shared_ptr<EdgeInfo>& edge_info,
+                                 AdjListType adj_list_type) noexcept {
   GAR_ASSIGN_OR_RAISE(auto vertex_num,
-                      fs->ReadFileToValue<IdType>(vertex_num_file_path));
+                      GetVertexNum(fs, prefix, edge_info, adj_list_type));
   IdType chunk_size;
   if (adj_list_type == AdjListType::ordered_by_source ||
       adj_list_type == AdjListType::unordered_by_source) {
@@ -168,9 +163,16 @@ Result<IdType> GetVertexNum(const std::string& prefix,
                             AdjListType adj_list_type) noexcept {
   std::string out_prefix;
   GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  return GetVertexNum(fs, out_prefix, edge_info, adj_list_type);
+}
+
+Result<IdType> GetVertexNum(const std::shared_ptr<FileSystem>& fs,
+                            const std::string& prefix,
+                            const std::shared_ptr<EdgeInfo>& edge_info,
+                            AdjListType adj_list_type) noexcept {
   GAR_ASSIGN_OR_RAISE(auto vertex_num_file_suffix,
                       edge_info->GetVerticesNumFilePath(adj_list_type));
-  std::string vertex_num_file_path = out_prefix + vertex_num_file_suffix;
+  std::string vertex_num_file_path = prefix + vertex_num_file_suffix;
   GAR_ASSIGN_OR_RAISE(auto vertex_num,
                       fs->ReadFileToValue<IdType>(vertex_num_file_path));
   return vertex_num;
@@ -182,12 +184,18 @@ Result<IdType> GetEdgeChunkNum(const std::string& prefix,
                                IdType vertex_chunk_index) noexcept {
   std::string out_prefix;
   GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
-  GAR_ASSIGN_OR_RAISE(
-      auto edge_num_file_suffix,
-      edge_info->GetEdgesNumFilePath(vertex_chunk_index, adj_list_type));
-  std::string edge_num_file_path = out_prefix + edge_num_file_suffix;
-  GAR_ASSIGN_OR_RAISE(auto edge_num,
-                      fs->ReadFileToValue<IdType>(edge_num_file_path));
+  return GetEdgeChunkNum(fs, out_prefix, edge_info, adj_list_type,
+                         vertex_chunk_index);
+}
+
+Result<IdType> GetEdgeChunkNum(const std::shared_ptr<FileSystem>& fs,
+                               const std::string& prefix,
+                               const std::shared_ptr<EdgeInfo>& edge_info,
+                               AdjListType adj_list_type,
+                               IdType vertex_chunk_index) noexcept {
+  GAR_ASSIGN_OR_RAISE(auto edge_num, GetEdgeNum(fs, prefix, edge_info,
+                                                adj_list_type,
+                                                vertex_chunk_index));
   return (edge_num + edge_info->GetChunkSize() - 1) / edge_info->GetChunkSize();
 }
 
@@ -197,13 +205,37 @@ Result<IdType> GetEdgeNum(const std::string& prefix,
                           IdType vertex_chunk_index) noexcept {
   std::string out_prefix;
   GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  return GetEdgeNum(fs, out_prefix, edge_info, adj_list_type,
+                    vertex_chunk_index);
+}
+
+Result<IdType> GetEdgeNum(const std::shared_ptr<FileSystem>& fs,
+                          const std::string& prefix,
+                          const std::shared_ptr<EdgeInfo>& edge_info,
+                          AdjListType adj_list_type,
+                          IdType vertex_chunk_index) noexcept {
+  // serve from the count index if it is already loaded
+  auto count_index = GraphCountIndex::Lookup(prefix, edge_info, adj_list_type);
+  if (count_index != nullptr) {
+    return count_index->GetEdgeNum(vertex_chunk_index);
+  }
   GAR_ASSIGN_OR_RAISE(
       auto edge_num_file_suffix,
       edge_info->GetEdgesNumFilePath(vertex_chunk_index, adj_list_type));
-  std::string edge_num_file_path = out_prefix + edge_num_file_suffix;
-  GAR_ASSIGN_OR_RAISE(auto edge_num,
-                      fs->ReadFileToValue<IdType>(edge_num_file_path));
-  return edge_num;
+  std::string edge_num_file_path = prefix + edge_num_file_suffix;
+  auto maybe_edge_num = fs->ReadFileToValue<IdType>(edge_num_file_path);
+  if (maybe_edge_num.has_value()) {
+    return maybe_edge_num.value();
+  }
+  // the count file may be absent if the counts are only in the manifest, any
+  // other error of the read is returned
+  GAR_ASSIGN_OR_RAISE(auto exists, fs->FileExists(edge_num_file_path));
+  if (exists) {
+    return maybe_edge_num.status();
+  }
+  GAR_ASSIGN_OR_RAISE(count_index, GraphCountIndex::Get(fs, prefix, edge_info,
+                                                        adj_list_type));
+  return count_index->GetEdgeNum(vertex_chunk_index);
 }
 
 }  // namespace graphar::util
@@ -32,6 +32,13 @@ struct FilterOptions {
   Filter filter = nullptr;
   // The columns to include in the table. Select all columns by default.
   ColumnNames columns = std::nullopt;
+  // Whether to widen the string and binary columns to large_utf8 and
+  // large_binary as the property types do. The 32-bit offsets are kept
+  // otherwise, which skips a pass over every string column, the columns can
+  // not be accessed as large types then.
+  bool large_string_offsets = true;
+  // The memory pool and executor to read with, the default ones if nullptr.
+  std::shared_ptr<ReadContext> context = nullptr;
 
   FilterOptions() {}
   FilterOptions(Filter filter, ColumnNames columns)
@@ -72,4 +79,44 @@ Result<IdType> GetEdgeNum(const std::string& prefix,
                           AdjListType adj_list_type,
                           IdType vertex_chunk_index) noexcept;
 
+/**
+ * The overloads below take a FileSystem that is already resolved from the
+ * prefix (e.g., the one a reader holds), where `prefix` is the path returned
+ * by FileSystemFromUriOrPath, so that the URI is not resolved again per call.
+ */
+Result<std::pair<IdType, IdType>> GetAdjListOffsetOfVertex(
+    const std::shared_ptr<EdgeInfo>& edge_info,
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    AdjListType adj_list_type, IdType vid) noexcept;
+
+Result<IdType> GetVertexChunkNum(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info) noexcept;
+
+Result<IdType> GetVertexNum(
+    const std::shared_ptr<FileSystem>& fs, const std::string& prefix,
+    const std::shared_ptr<VertexInfo>& vertex_info) noexcept;
+
+Result<IdType> GetVertexChunkNum(const std::shared_ptr<FileSystem>& fs,
+                                 const std::string& prefix,
+                                 const std::shared_ptr<EdgeInfo>& edge_info,
+                                 AdjListType adj_list_type) noexcept;
+
+Result<IdType> GetVertexNum(const std::shared_ptr<FileSystem>& fs,
+                            const std::string& prefix,
+                            const std::shared_ptr<EdgeInfo>& edge_info,
+                            AdjListType adj_list_type) noexcept;
+
+Result<IdType> GetEdgeChunkNum(const std::shared_ptr<FileSystem>& fs,
+                               const std::string& prefix,
+                               const std::shared_ptr<EdgeInfo>& edge_info,
+                               AdjListType adj_list_type,
+                               IdType vertex_chunk_index) noexcept;
+
+Result<IdType> GetEdgeNum(const std::shared_ptr<FileSystem>& fs,
+                          const std::string& prefix,
+                          const std::shared_ptr<EdgeInfo>& edge_info,
+                          AdjListType adj_list_type,
+                          IdType vertex_chunk_index) noexcept;
+
 }  // namespace graphar::util
@@ -225,7 +225,8 @@ static inline FileType StringToFileType(const std::string& str) {
       {"csv", FileType::CSV},
       {"json", FileType::JSON},
       {"parquet", FileType::PARQUET},
-      {"orc", FileType::ORC}};
+      {"orc", FileType::ORC},
+      {"ipc", FileType::IPC}};
   try {
     return str2file_type.at(str.c_str());
   } catch (const std::exception& e) {
@@ -238,7 +239,8 @@ static inline const char* FileTypeToString(FileType file_type) {
       {FileType::CSV, "csv"},
       {FileType::JSON, "json"},
       {FileType::PARQUET, "parquet"},
-      {FileType::ORC, "orc"}};
+      {FileType::ORC, "orc"},
+      {FileType::IPC, "ipc"}};
   return file_type2string.at(file_type);
 }
 
@@ -17,8 +17,10 @@
  * under the License.
  */
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arrow/api.h"
 
@@ -95,6 +97,69 @@ Result<const void*> GetArrowArrayData(
   }
 }
 
+namespace {
+std::shared_ptr<arrow::DataType> GetLargeStringType(
+    const std::shared_ptr<arrow::DataType>& type) {
+  switch (type->id()) {
+  case arrow::Type::STRING:
+    return arrow::large_utf8();
+  case arrow::Type::BINARY:
+    return arrow::large_binary();
+  default:
+    return nullptr;
+  }
+}
+}  // namespace
+
+Result<std::shared_ptr<arrow::Array>> WidenStringOffsets(
+    const std::shared_ptr<arrow::Array>& array, arrow::MemoryPool* pool) {
+  auto type = GetLargeStringType(array->type());
+  if (type == nullptr) {
+    return Status::TypeError("Can not widen the offsets of array of type ",
+                             array->type()->ToString());
+  }
+  auto data = array->data()->Copy();
+  // the offsets are widened up to the end of the slice and the slice offset
+  // is kept, since the validity bitmap is addressed by it
+  const int64_t num_offsets = data->offset + data->length + 1;
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto buffer, arrow::AllocateBuffer(num_offsets * sizeof(int64_t), pool));
+  auto* out = reinterpret_cast<int64_t*>(buffer->mutable_data());
+  if (data->buffers[1] == nullptr) {
+    // an empty array may have no offsets
+    std::fill(out, out + num_offsets, 0);
+  } else {
+    // a plain sign-extending loop, which the compiler vectorizes
+    const auto* in = data->buffers[1]->data_as<int32_t>();
+    for (int64_t i = 0; i < num_offsets; ++i) {
+      out[i] = in[i];
+    }
+  }
+  // the widened offsets of valid offsets are valid, skip the validation
+  data->type = type;
+  data->buffers[1] = std::move(buffer);
+  return arrow::MakeArray(data);
+}
+
+Result<std::shared_ptr<arrow::ChunkedArray>> WidenStringOffsets(
+    const std::shared_ptr<arrow::ChunkedArray>& chunked_array,
+    arrow::MemoryPool* pool) {
+  auto type = GetLargeStringType(chunked_array->type());
+  if (type == nullptr) {
+    return Status::TypeError("Can not widen the offsets of array of type ",
+                             chunked_array->type()->ToString());
+  }
+  std::vector<std::shared_ptr<arrow::Array>> chunks;
+  chunks.reserve(chunked_array->num_chunks());
+  for (const auto& chunk : chunked_array->chunks()) {
+    GAR_ASSIGN_OR_RAISE(auto widened, WidenStringOffsets(chunk, pool));
+    chunks.push_back(std::move(widened));
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto out, arrow::ChunkedArray::Make(std::move(chunks), type));
+  return out;
+}
+
 std::string ValueGetter<std::string>::Value(const void* data, int64_t offset) {
   return std::string(
       reinterpret_cast<const arrow::LargeStringArray*>(data)->GetView(offset));
@@ -34,6 +34,7 @@ namespace arrow {
 class Table;
 class ChunkedArray;
 class Array;
+class MemoryPool;
 }  // namespace arrow
 
 namespace graphar {
@@ -229,6 +230,26 @@ std::shared_ptr<arrow::Array> GetArrowArrayByChunkIndex(
 Result<const void*> GetArrowArrayData(
     std::shared_ptr<arrow::Array> const& array);
 
+/**
+ * @brief Widen a utf8 or binary array to large_utf8 or large_binary. Only the
+ * offsets are rewritten, the value and validity buffers are shared.
+ *
+ * @param array The utf8 or binary array.
+ * @param pool The memory pool of the offsets, the default pool if nullptr.
+ * @return The array of the large type, or TypeError for other types.
+ */
+Result<std::shared_ptr<arrow::Array>> WidenStringOffsets(
+    const std::shared_ptr<arrow::Array>& array,
+    arrow::MemoryPool* pool = nullptr);
+
+/**
+ * @brief Widen every chunk of a utf8 or binary chunked array to large_utf8 or
+ * large_binary, see WidenStringOffsets(array).
+ */
+Result<std::shared_ptr<arrow::ChunkedArray>> WidenStringOffsets(
+    const std::shared_ptr<arrow::ChunkedArray>& chunked_array,
+    arrow::MemoryPool* pool = nullptr);
+
 static inline std::string ConcatStringWithDelimiter(
     const std::vector<std::string>& str_vec, const std::string& delimiter) {
   return std::accumulate(
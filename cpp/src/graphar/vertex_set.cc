@@ -0,0 +1,513 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "arrow/util/bit_util.h"
+
+#include "graphar/vertex_set.h"
+
+namespace graphar {
+
+namespace {
+constexpr int kBlockBits = 16;
+constexpr IdType kBlockSize = IdType(1) << kBlockBits;
+constexpr IdType kBlockMask = kBlockSize - 1;
+constexpr int64_t kBlockWords = kBlockSize / 64;
+// an array of more ids takes more space than the bitmap of the block
+constexpr IdType kMaxArraySize = 4096;
+
+IdType CountBits(const std::vector<uint64_t>& bitmap) {
+  IdType count = 0;
+  for (uint64_t word : bitmap) {
+    count += arrow::bit_util::PopCount(word);
+  }
+  return count;
+}
+
+// the position of the rank-th set bit of a word
+int SelectInWord(uint64_t word, IdType rank) {
+  for (IdType i = 0; i < rank; ++i) {
+    word &= word - 1;
+  }
+  return arrow::bit_util::CountTrailingZeros(word);
+}
+}  // namespace
+
+VertexSet::Container VertexSet::ToArray(IdType key,
+                                        const std::vector<uint64_t>& bitmap,
+                                        IdType cardinality) {
+  Container container;
+  container.key = key;
+  container.cardinality = cardinality;
+  container.array.reserve(cardinality);
+  for (int64_t i = 0; i < static_cast<int64_t>(bitmap.size()); ++i) {
+    uint64_t word = bitmap[i];
+    while (word != 0) {
+      int bit = arrow::bit_util::CountTrailingZeros(word);
+      container.array.push_back(static_cast<uint16_t>(i * 64 + bit));
+      word &= word - 1;
+    }
+  }
+  return container;
+}
+
+std::vector<uint64_t> VertexSet::ToBitmap(const Container& container) {
+  if (container.IsBitmap()) {
+    return container.bitmap;
+  }
+  std::vector<uint64_t> bitmap(kBlockWords, 0);
+  for (uint16_t low : container.array) {
+    bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+  }
+  return bitmap;
+}
+
+VertexSet::Container VertexSet::MakeContainer(IdType key,
+                                              std::vector<uint64_t> bitmap) {
+  IdType cardinality = CountBits(bitmap);
+  if (cardinality <= kMaxArraySize) {
+    return ToArray(key, bitmap, cardinality);
+  }
+  Container container;
+  container.key = key;
+  container.cardinality = cardinality;
+  container.bitmap = std::move(bitmap);
+  return container;
+}
+
+VertexSet::Container VertexSet::IntersectContainers(const Container& lhs,
+                                                    const Container& rhs) {
+  Container container;
+  container.key = lhs.key;
+  if (!lhs.IsBitmap() && !rhs.IsBitmap()) {
+    std::set_intersection(lhs.array.begin(), lhs.array.end(),
+                          rhs.array.begin(), rhs.array.end(),
+                          std::back_inserter(container.array));
+  } else if (!lhs.IsBitmap() || !rhs.IsBitmap()) {
+    // probe the bitmap with the array
+    const auto& array = lhs.IsBitmap() ? rhs.array : lhs.array;
+    const auto& bitmap = lhs.IsBitmap() ? lhs.bitmap : rhs.bitmap;
+    for (uint16_t low : array) {
+      if ((bitmap[low >> 6] >> (low & 63)) & 1) {
+        container.array.push_back(low);
+      }
+    }
+  } else {
+    std::vector<uint64_t> bitmap(kBlockWords);
+    for (int64_t i = 0; i < kBlockWords; ++i) {
+      bitmap[i] = lhs.bitmap[i] & rhs.bitmap[i];
+    }
+    return MakeContainer(lhs.key, std::move(bitmap));
+  }
+  container.cardinality = static_cast<IdType>(container.array.size());
+  return container;
+}
+
+VertexSet::Container VertexSet::UnionContainers(const Container& lhs,
+                                                const Container& rhs) {
+  if (!lhs.IsBitmap() && !rhs.IsBitmap() &&
+      lhs.cardinality + rhs.cardinality <= kMaxArraySize) {
+    Container container;
+    container.key = lhs.key;
+    std::set_union(lhs.array.begin(), lhs.array.end(), rhs.array.begin(),
+                   rhs.array.end(), std::back_inserter(container.array));
+    container.cardinality = static_cast<IdType>(container.array.size());
+    return container;
+  }
+  auto bitmap = ToBitmap(lhs);
+  if (rhs.IsBitmap()) {
+    for (int64_t i = 0; i < kBlockWords; ++i) {
+      bitmap[i] |= rhs.bitmap[i];
+    }
+  } else {
+    for (uint16_t low : rhs.array) {
+      bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+  }
+  return MakeContainer(lhs.key, std::move(bitmap));
+}
+
+VertexSet::Container VertexSet::DifferenceContainers(const Container& lhs,
+                                                     const Container& rhs) {
+  if (!lhs.IsBitmap()) {
+    Container container;
+    container.key = lhs.key;
+    if (!rhs.IsBitmap()) {
+      std::set_difference(lhs.array.begin(), lhs.array.end(),
+                          rhs.array.begin(), rhs.array.end(),
+                          std::back_inserter(container.array));
+    } else {
+      for (uint16_t low : lhs.array) {
+        if (!((rhs.bitmap[low >> 6] >> (low & 63)) & 1)) {
+          container.array.push_back(low);
+        }
+      }
+    }
+    container.cardinality = static_cast<IdType>(container.array.size());
+    return container;
+  }
+  auto bitmap = lhs.bitmap;
+  if (rhs.IsBitmap()) {
+    for (int64_t i = 0; i < kBlockWords; ++i) {
+      bitmap[i] &= ~rhs.bitmap[i];
+    }
+  } else {
+    for (uint16_t low : rhs.array) {
+      bitmap[low >> 6] &= ~(uint64_t(1) << (low & 63));
+    }
+  }
+  return MakeContainer(lhs.key, std::move(bitmap));
+}
+
+void VertexSet::Append(Container container) {
+  if (container.cardinality == 0) {
+    return;
+  }
+  ranks_.push_back(size_);
+  size_ += container.cardinality;
+  containers_.push_back(std::move(container));
+}
+
+void VertexSet::AddedTo(size_t index) {
+  // only the ranks of the later containers change, none if the ids are
+  // added in ascending order
+  for (size_t i = index + 1; i < ranks_.size(); ++i) {
+    ++ranks_[i];
+  }
+  ++size_;
+}
+
+VertexSet VertexSet::FromIds(std::vector<IdType> ids) {
+  if (!std::is_sorted(ids.begin(), ids.end())) {
+    std::sort(ids.begin(), ids.end());
+  }
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  VertexSet set;
+  size_t begin = 0;
+  while (begin < ids.size()) {
+    IdType key = ids[begin] >> kBlockBits;
+    size_t end = begin;
+    while (end < ids.size() && (ids[end] >> kBlockBits) == key) {
+      ++end;
+    }
+    Container container;
+    container.key = key;
+    container.cardinality = static_cast<IdType>(end - begin);
+    if (container.cardinality <= kMaxArraySize) {
+      container.array.reserve(container.cardinality);
+      for (size_t i = begin; i < end; ++i) {
+        container.array.push_back(static_cast<uint16_t>(ids[i] & kBlockMask));
+      }
+    } else {
+      container.bitmap.assign(kBlockWords, 0);
+      for (size_t i = begin; i < end; ++i) {
+        IdType low = ids[i] & kBlockMask;
+        container.bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+      }
+    }
+    set.Append(std::move(container));
+    begin = end;
+  }
+  return set;
+}
+
+VertexSet VertexSet::FromBitmap(const uint64_t* bitmap, IdType length) {
+  VertexSet set;
+  int64_t num_words = (length + 63) / 64;
+  for (int64_t first = 0; first < num_words; first += kBlockWords) {
+    int64_t last = std::min(first + kBlockWords, num_words);
+    std::vector<uint64_t> block(kBlockWords, 0);
+    std::copy(bitmap + first, bitmap + last, block.begin());
+    if (last == num_words && length % 64 != 0) {
+      // clear the bits past the length
+      block[last - first - 1] &= (uint64_t(1) << (length % 64)) - 1;
+    }
+    set.Append(MakeContainer(first / kBlockWords, std::move(block)));
+  }
+  return set;
+}
+
+VertexSet VertexSet::FromRange(IdType begin, IdType end) {
+  VertexSet set;
+  for (IdType key = begin >> kBlockBits; begin < end; ++key) {
+    IdType block_end = std::min(end, (key + 1) << kBlockBits);
+    std::vector<uint64_t> block(kBlockWords, 0);
+    arrow::bit_util::SetBitsTo(reinterpret_cast<uint8_t*>(block.data()),
+                               begin & kBlockMask, block_end - begin, true);
+    set.Append(MakeContainer(key, std::move(block)));
+    begin = block_end;
+  }
+  return set;
+}
+
+VertexSet VertexSet::Intersect(const VertexSet& lhs, const VertexSet& rhs) {
+  VertexSet set;
+  size_t i = 0, j = 0;
+  while (i < lhs.containers_.size() && j < rhs.containers_.size()) {
+    IdType lkey = lhs.containers_[i].key, rkey = rhs.containers_[j].key;
+    if (lkey < rkey) {
+      ++i;
+    } else if (rkey < lkey) {
+      ++j;
+    } else {
+      set.Append(IntersectContainers(lhs.containers_[i++],
+                                     rhs.containers_[j++]));
+    }
+  }
+  return set;
+}
+
+VertexSet VertexSet::Union(const VertexSet& lhs, const VertexSet& rhs) {
+  VertexSet set;
+  size_t i = 0, j = 0;
+  while (i < lhs.containers_.size() || j < rhs.containers_.size()) {
+    if (j == rhs.containers_.size() ||
+        (i < lhs.containers_.size() &&
+         lhs.containers_[i].key < rhs.containers_[j].key)) {
+      set.Append(lhs.containers_[i++]);
+    } else if (i == lhs.containers_.size() ||
+               rhs.containers_[j].key < lhs.containers_[i].key) {
+      set.Append(rhs.containers_[j++]);
+    } else {
+      set.Append(UnionContainers(lhs.containers_[i++], rhs.containers_[j++]));
+    }
+  }
+  return set;
+}
+
+VertexSet VertexSet::Difference(const VertexSet& lhs, const VertexSet& rhs) {
+  VertexSet set;
+  size_t j = 0;
+  for (const auto& container : lhs.containers_) {
+    while (j < rhs.containers_.size() &&
+           rhs.containers_[j].key < container.key) {
+      ++j;
+    }
+    if (j < rhs.containers_.size() && rhs.containers_[j].key == container.key) {
+      set.Append(DifferenceContainers(container, rhs.containers_[j]));
+    } else {
+      set.Append(container);
+    }
+  }
+  return set;
+}
+
+void VertexSet::Add(IdType id) {
+  IdType key = id >> kBlockBits;
+  uint16_t low = static_cast<uint16_t>(id & kBlockMask);
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& container, IdType k) { return container.key < k; });
+  size_t index = it - containers_.begin();
+  if (it == containers_.end() || it->key != key) {
+    Container container;
+    container.key = key;
+    container.cardinality = 1;
+    container.array.push_back(low);
+    containers_.insert(it, std::move(container));
+    ranks_.insert(ranks_.begin() + index,
+                  index < ranks_.size() ? ranks_[index] : size_);
+    AddedTo(index);
+    return;
+  }
+  if (it->IsBitmap()) {
+    uint64_t& word = it->bitmap[low >> 6];
+    uint64_t mask = uint64_t(1) << (low & 63);
+    if (word & mask) {
+      return;
+    }
+    word |= mask;
+  } else {
+    auto pos = std::lower_bound(it->array.begin(), it->array.end(), low);
+    if (pos != it->array.end() && *pos == low) {
+      return;
+    }
+    it->array.insert(pos, low);
+    if (static_cast<IdType>(it->array.size()) > kMaxArraySize) {
+      it->bitmap = ToBitmap(*it);
+      it->array.clear();
+      it->array.shrink_to_fit();
+    }
+  }
+  ++it->cardinality;
+  AddedTo(index);
+}
+
+bool VertexSet::Contains(IdType id) const {
+  IdType key = id >> kBlockBits;
+  uint16_t low = static_cast<uint16_t>(id & kBlockMask);
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& container, IdType k) { return container.key < k; });
+  if (id < 0 || it == containers_.end() || it->key != key) {
+    return false;
+  }
+  if (it->IsBitmap()) {
+    return (it->bitmap[low >> 6] >> (low & 63)) & 1;
+  }
+  return std::binary_search(it->array.begin(), it->array.end(), low);
+}
+
+IdType VertexSet::Select(IdType rank) const {
+  if (rank < 0 || rank >= size_) {
+    return -1;
+  }
+  size_t i = std::upper_bound(ranks_.begin(), ranks_.end(), rank) -
+             ranks_.begin() - 1;
+  const auto& container = containers_[i];
+  IdType local = rank - ranks_[i];
+  IdType base = container.key << kBlockBits;
+  if (!container.IsBitmap()) {
+    return base + container.array[local];
+  }
+  for (int64_t w = 0; w < kBlockWords; ++w) {
+    IdType count = arrow::bit_util::PopCount(container.bitmap[w]);
+    if (local < count) {
+      return base + w * 64 + SelectInWord(container.bitmap[w], local);
+    }
+    local -= count;
+  }
+  return -1;
+}
+
+IdType VertexSet::Rank(IdType id) const {
+  if (id <= 0) {
+    return 0;
+  }
+  IdType key = id >> kBlockBits;
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& container, IdType k) { return container.key < k; });
+  if (it == containers_.end()) {
+    return size_;
+  }
+  IdType rank = ranks_[it - containers_.begin()];
+  if (it->key != key) {
+    return rank;
+  }
+  IdType low = id & kBlockMask;
+  if (!it->IsBitmap()) {
+    return rank + (std::lower_bound(it->array.begin(), it->array.end(), low) -
+                   it->array.begin());
+  }
+  for (int64_t w = 0; w < (low >> 6); ++w) {
+    rank += arrow::bit_util::PopCount(it->bitmap[w]);
+  }
+  if (low & 63) {
+    rank += arrow::bit_util::PopCount(it->bitmap[low >> 6] &
+                                      ((uint64_t(1) << (low & 63)) - 1));
+  }
+  return rank;
+}
+
+IdType VertexSet::Next(IdType id) const {
+  IdType target = std::max<IdType>(id + 1, 0);
+  IdType key = target >> kBlockBits;
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& container, IdType k) { return container.key < k; });
+  for (; it != containers_.end(); ++it) {
+    // the first member of a later block is its smallest one
+    IdType low = it->key == key ? (target & kBlockMask) : 0;
+    IdType base = it->key << kBlockBits;
+    if (!it->IsBitmap()) {
+      auto pos = std::lower_bound(it->array.begin(), it->array.end(), low);
+      if (pos != it->array.end()) {
+        return base + *pos;
+      }
+      continue;
+    }
+    int64_t w = low >> 6;
+    uint64_t word = it->bitmap[w] & (~uint64_t(0) << (low & 63));
+    while (true) {
+      if (word != 0) {
+        return base + w * 64 + arrow::bit_util::CountTrailingZeros(word);
+      }
+      if (++w == kBlockWords) {
+        break;
+      }
+      word = it->bitmap[w];
+    }
+  }
+  return -1;
+}
+
+void VertexSet::ForEach(const std::function<void(IdType)>& visit) const {
+  for (const auto& container : containers_) {
+    IdType base = container.key << kBlockBits;
+    if (!container.IsBitmap()) {
+      for (uint16_t low : container.array) {
+        visit(base + low);
+      }
+      continue;
+    }
+    for (int64_t w = 0; w < kBlockWords; ++w) {
+      uint64_t word = container.bitmap[w];
+      while (word != 0) {
+        visit(base + w * 64 + arrow::bit_util::CountTrailingZeros(word));
+        word &= word - 1;
+      }
+    }
+  }
+}
+
+std::vector<IdType> VertexSet::ToVector() const {
+  std::vector<IdType> ids;
+  ids.reserve(size_);
+  ForEach([&ids](IdType id) { ids.push_back(id); });
+  return ids;
+}
+
+int64_t VertexSet::GetMemoryUsage() const {
+  int64_t size = static_cast<int64_t>(
+      containers_.capacity() * sizeof(Container) +
+      ranks_.capacity() * sizeof(IdType));
+  for (const auto& container : containers_) {
+    size += container.array.capacity() * sizeof(uint16_t) +
+            container.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return size;
+}
+
+bool VertexSet::operator==(const VertexSet& rhs) const {
+  if (size_ != rhs.size_ || containers_.size() != rhs.containers_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < containers_.size(); ++i) {
+    const auto& lc = containers_[i];
+    const auto& rc = rhs.containers_[i];
+    if (lc.key != rc.key || lc.cardinality != rc.cardinality) {
+      return false;
+    }
+    // a container of the same ids may be kept in either form
+    if (lc.IsBitmap() == rc.IsBitmap()) {
+      if (lc.array != rc.array || lc.bitmap != rc.bitmap) {
+        return false;
+      }
+    } else if (ToBitmap(lc) != ToBitmap(rc)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace graphar
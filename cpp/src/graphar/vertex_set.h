@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "graphar/fwd.h"
+
+namespace graphar {
+
+/**
+ * @brief A compressed set of internal vertex ids.
+ *
+ * The ids are split into blocks of 2^16 by their high bits, in the manner of
+ * a roaring bitmap. A block of at most 4096 ids is kept as a sorted array of
+ * the 16-bit low halves, a denser block as a bitmap of 8KB, and an empty
+ * block is not kept. A set takes at most about 2 bytes per member and 1 bit
+ * per id of its range, and the intersection, union and difference of two
+ * sets are computed block by block without expanding them to ids.
+ */
+class VertexSet {
+ public:
+  VertexSet() = default;
+
+  /**
+   * @brief Make a set from ids in any order, a repeated id is added once.
+   */
+  static VertexSet FromIds(std::vector<IdType> ids);
+
+  /**
+   * @brief Make a set from a bitmap, bit i is set if id i is a member.
+   *
+   * @param bitmap The bitmap words.
+   * @param length The number of bits of the bitmap.
+   */
+  static VertexSet FromBitmap(const uint64_t* bitmap, IdType length);
+
+  /** @brief Make the set of the ids in [begin, end). */
+  static VertexSet FromRange(IdType begin, IdType end);
+
+  /** @brief The ids of both sets. */
+  static VertexSet Intersect(const VertexSet& lhs, const VertexSet& rhs);
+
+  /** @brief The ids of any of the sets. */
+  static VertexSet Union(const VertexSet& lhs, const VertexSet& rhs);
+
+  /** @brief The ids of lhs that are not in rhs. */
+  static VertexSet Difference(const VertexSet& lhs, const VertexSet& rhs);
+
+  /** @brief Add an id to the set. */
+  void Add(IdType id);
+
+  /** @brief Whether the id is a member of the set. */
+  bool Contains(IdType id) const;
+
+  /** @brief The number of ids of the set. */
+  IdType Size() const { return size_; }
+
+  /** @brief Whether the set is empty. */
+  bool Empty() const { return size_ == 0; }
+
+  /**
+   * @brief Get the id of a rank, the smallest id has rank 0.
+   *
+   * @return The id, or -1 if the rank is out of range.
+   */
+  IdType Select(IdType rank) const;
+
+  /** @brief Get the number of members smaller than an id. */
+  IdType Rank(IdType id) const;
+
+  /**
+   * @brief Get the smallest member larger than an id.
+   *
+   * @return The member, or -1 if there is none.
+   */
+  IdType Next(IdType id) const;
+
+  /** @brief Visit the ids of the set in ascending order. */
+  void ForEach(const std::function<void(IdType)>& visit) const;
+
+  /** @brief The ids of the set in ascending order. */
+  std::vector<IdType> ToVector() const;
+
+  /** @brief Get the size in bytes of the set. */
+  int64_t GetMemoryUsage() const;
+
+  bool operator==(const VertexSet& rhs) const;
+  bool operator!=(const VertexSet& rhs) const { return !(*this == rhs); }
+
+ private:
+  /// The ids of a block of 2^16 ids, as the sorted low halves or a bitmap
+  struct Container {
+    IdType key = 0;  // the id >> 16 of the block
+    IdType cardinality = 0;
+    std::vector<uint16_t> array;   // if the block has at most 4096 ids
+    std::vector<uint64_t> bitmap;  // of 1024 words, otherwise
+
+    bool IsBitmap() const { return !bitmap.empty(); }
+  };
+
+  static Container ToArray(IdType key, const std::vector<uint64_t>& bitmap,
+                           IdType cardinality);
+  static std::vector<uint64_t> ToBitmap(const Container& container);
+  static Container MakeContainer(IdType key, std::vector<uint64_t> bitmap);
+  static Container IntersectContainers(const Container& lhs,
+                                       const Container& rhs);
+  static Container UnionContainers(const Container& lhs,
+                                   const Container& rhs);
+  static Container DifferenceContainers(const Container& lhs,
+                                        const Container& rhs);
+
+  // append a non-empty container of a key larger than the last one
+  void Append(Container container);
+  // update the ranks and the size after an id is added to a container
+  void AddedTo(size_t index);
+
+  std::vector<Container> containers_;
+  // the number of ids in the containers before each container
+  std::vector<IdType> ranks_;
+  IdType size_ = 0;
+};
+
+}  // namespace graphar
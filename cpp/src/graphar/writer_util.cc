@@ -17,6 +17,9 @@
  * under the License.
  */
 
+#include "arrow/util/compression.h"
+
+#include "graphar/result.h"
 #include "graphar/writer_util.h"
 namespace graphar {
 arrow::csv::WriteOptions WriterOptions::getCsvOption() const {
@@ -126,4 +129,33 @@ arrow::adapters::orc::WriteOptions WriterOptions::getOrcOption() const {
   return writer_options;
 }
 #endif
+
+Result<arrow::ipc::IpcWriteOptions> WriterOptions::getIpcOption() const {
+  auto write_options = arrow::ipc::IpcWriteOptions::Defaults();
+  if (!ipcOption_) {
+    return write_options;
+  }
+  write_options.use_threads = ipcOption_->use_threads;
+  switch (ipcOption_->compression) {
+  case arrow::Compression::UNCOMPRESSED:
+    break;
+  case arrow::Compression::LZ4_FRAME:
+  case arrow::Compression::ZSTD: {
+    int level = ipcOption_->compression_level;
+    if (level == std::numeric_limits<int>::min()) {
+      level = arrow::util::kUseDefaultCompressionLevel;
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        write_options.codec,
+        arrow::util::Codec::Create(ipcOption_->compression, level));
+    break;
+  }
+  default:
+    return Status::Invalid("Unsupported compression for IPC files: ",
+                           arrow::util::Codec::GetCodecAsString(
+                               ipcOption_->compression),
+                           ", only LZ4_FRAME and ZSTD are supported.");
+  }
+  return write_options;
+}
 }  // namespace graphar
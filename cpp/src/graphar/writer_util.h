@@ -33,21 +33,25 @@
 #include "arrow/csv/api.h"
 #include "arrow/dataset/api.h"
 #include "arrow/filesystem/api.h"
+#include "arrow/ipc/options.h"
 #include "parquet/arrow/writer.h"
 
+#include "graphar/fwd.h"
+
 namespace graphar {
 /**
  * @class WriterOptions
  * @brief Provides configuration options for different file format writers (CSV,
- * Parquet, ORC) in GraphAr. A WriterOptions instance can simultaneously contain
- * options for all three formats (CSV, Parquet, ORC). The actual file format
- * used for writing is determined by the FileType specified in the graph_Info.
+ * Parquet, ORC, IPC) in GraphAr. A WriterOptions instance can simultaneously
+ * contain options for all the formats. The actual file format used for
+ * writing is determined by the FileType specified in the graph_Info.
  *
  * The configuration parameters and their default values are aligned with those
  * in Arrow.
  *
- * CSVOptionBuilder, ParquetOptionBuilder, and ORCOptionBuilder are used to
- * construct format-specific options for CSV, Parquet, and ORC, respectively.
+ * CSVOptionBuilder, ParquetOptionBuilder, ORCOptionBuilder and
+ * IPCOptionBuilder are used to construct format-specific options for CSV,
+ * Parquet, ORC and IPC, respectively.
  * An existing WriterOptions instance can be passed to a builder’s constructor
  * to incrementally add or combine options across different formats.
  * Example:
@@ -140,6 +144,18 @@ class WriterOptions {
     double bloom_filter_fpp = 0.05;
 #endif
   };
+  /**
+   * @class IPCOption
+   * @brief Configuration options for IPC (Feather V2) Writer. The buffers are
+   * left uncompressed by default, so that the files are read without
+   * decoding, LZ4_FRAME and ZSTD trade this for smaller files.
+   */
+  class IPCOption {
+   public:
+    arrow::Compression::type compression = arrow::Compression::UNCOMPRESSED;
+    int compression_level = std::numeric_limits<int>::min();
+    bool use_threads = true;
+  };
 
  public:
   // Builder for CSVOption
@@ -340,6 +356,39 @@ class WriterOptions {
     std::shared_ptr<ParquetOption> option_;
   };
 
+  // Builder for IPCOption
+  class IPCOptionBuilder {
+   public:
+    IPCOptionBuilder() : option_(std::make_shared<IPCOption>()) {}
+    explicit IPCOptionBuilder(std::shared_ptr<WriterOptions> wopt)
+        : writerOptions_(wopt),
+          option_(wopt && wopt->ipcOption_ ? wopt->ipcOption_
+                                           : std::make_shared<IPCOption>()) {}
+    IPCOptionBuilder& compression(arrow::Compression::type comp) {
+      option_->compression = comp;
+      return *this;
+    }
+    IPCOptionBuilder& compression_level(int level) {
+      option_->compression_level = level;
+      return *this;
+    }
+    IPCOptionBuilder& use_threads(bool use) {
+      option_->use_threads = use;
+      return *this;
+    }
+    std::shared_ptr<WriterOptions> build() {
+      if (!writerOptions_) {
+        writerOptions_ = std::make_shared<WriterOptions>();
+      }
+      writerOptions_->setIpcOption(option_);
+      return writerOptions_;
+    }
+
+   private:
+    std::shared_ptr<WriterOptions> writerOptions_;
+    std::shared_ptr<IPCOption> option_;
+  };
+
   // Builder for ORCOption
   class ORCOptionBuilder {
    public:
@@ -425,6 +474,18 @@ class WriterOptions {
   void setOrcOption(std::shared_ptr<ORCOption> orc_option) {
     orcOption_ = orc_option;
   }
+  void setIpcOption(std::shared_ptr<IPCOption> ipc_option) {
+    ipcOption_ = ipc_option;
+  }
+  /**
+   * @brief Set the memory pool and executor to write and build with, the
+   * default ones are used if it is not set.
+   */
+  void setContext(std::shared_ptr<WriteContext> context) {
+    context_ = context;
+  }
+  /** @brief Get the context to write with, nullptr if it is not set. */
+  const std::shared_ptr<WriteContext>& getContext() const { return context_; }
   arrow::csv::WriteOptions getCsvOption() const;
   std::shared_ptr<parquet::WriterProperties> getParquetWriterProperties() const;
   std::shared_ptr<parquet::ArrowWriterProperties> getArrowWriterProperties()
@@ -432,11 +493,18 @@ class WriterOptions {
 #ifdef ARROW_ORC
   arrow::adapters::orc::WriteOptions getOrcOption() const;
 #endif
+  /**
+   * @brief Get the options of the IPC file writer, or Invalid if the
+   * compression is not supported by the IPC format.
+   */
+  Result<arrow::ipc::IpcWriteOptions> getIpcOption() const;
 
  private:
   std::shared_ptr<CSVOption> csvOption_;
   std::shared_ptr<ParquetOption> parquetOption_;
   std::shared_ptr<ORCOption> orcOption_;
+  std::shared_ptr<IPCOption> ipcOption_;
+  std::shared_ptr<WriteContext> context_;
 };
 
 /**
@@ -0,0 +1,216 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+#include "./util.h"
+#include "graphar/analytics/algorithms.h"
+#include "graphar/api/arrow_reader.h"
+#include "graphar/api/arrow_writer.h"
+#include "graphar/api/high_level_writer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace graphar {
+TEST_CASE_METHOD(GlobalFixture, "Analytics") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto out_edges = CSRGraph::Make(graph_info, "person", "knows", "person",
+                                  AdjListType::ordered_by_source)
+                       .value();
+  auto in_edges = CSRGraph::Make(graph_info, "person", "knows", "person",
+                                 AdjListType::ordered_by_dest)
+                      .value();
+  IdType vertex_num = out_edges->GetVertexNum();
+  REQUIRE(vertex_num > 0);
+
+  // the hops of a serial breadth-first search
+  IdType source = 0;
+  std::vector<IdType> expected(vertex_num, -1);
+  std::queue<IdType> queue;
+  expected[source] = 0;
+  queue.push(source);
+  while (!queue.empty()) {
+    IdType u = queue.front();
+    queue.pop();
+    for (IdType j = out_edges->offsets()[u]; j < out_edges->offsets()[u + 1];
+         ++j) {
+      IdType v = out_edges->neighbors()[j];
+      if (expected[v] == -1) {
+        expected[v] = expected[u] + 1;
+        queue.push(v);
+      }
+    }
+  }
+
+  SECTION("BreadthFirstSearch") {
+    for (auto in : {in_edges.get(), static_cast<const CSRGraph*>(nullptr)}) {
+      auto maybe_hops =
+          analytics::BreadthFirstSearch(*out_edges, in, source, 4);
+      REQUIRE(maybe_hops.status().ok());
+      REQUIRE(maybe_hops.value() == expected);
+    }
+    REQUIRE(analytics::BreadthFirstSearch(*out_edges, nullptr, vertex_num)
+                .status()
+                .IsIndexError());
+    REQUIRE(analytics::BreadthFirstSearch(*in_edges, nullptr, source)
+                .status()
+                .IsInvalid());
+  }
+
+  SECTION("SingleSourceShortestPaths") {
+    // the shortest paths of unit weights are the hops
+    auto distances =
+        analytics::SingleSourceShortestPaths(*out_edges, "", source, 1.0, 4)
+            .value();
+    for (IdType v = 0; v < vertex_num; ++v) {
+      if (expected[v] == -1) {
+        REQUIRE(std::isinf(distances[v]));
+      } else {
+        REQUIRE(distances[v] == static_cast<double>(expected[v]));
+      }
+    }
+    // the delta defaults to the average weight, 1 for the unit weights
+    REQUIRE(analytics::SingleSourceShortestPaths(*out_edges, "", source)
+                .value() == distances);
+    REQUIRE(analytics::SingleSourceShortestPaths(*out_edges, "", source,
+                                                 std::nan(""))
+                .status()
+                .IsInvalid());
+  }
+
+  SECTION("WeightedShortestPaths") {
+    // a graph of weighted edges, whose last edge is far beyond the buckets
+    // of unit width kept at once
+    std::string prefix = "/tmp/analytics_sssp/";
+    auto weight_group = CreatePropertyGroup(
+        {Property("weight", float64(), false, false)}, FileType::PARQUET);
+    auto edge_info = CreateEdgeInfo(
+        "node", "road", "node", 2, 4, 4, true,
+        {CreateAdjacentList(AdjListType::ordered_by_source, FileType::PARQUET)},
+        {weight_group}, "edge/node_road_node/");
+    std::vector<std::tuple<IdType, IdType, double>> roads = {
+        {0, 1, 4}, {0, 2, 1}, {1, 3, 1}, {2, 1, 2},
+        {2, 3, 5}, {3, 4, 3}, {4, 5, 1e12}};
+    auto builder = builder::EdgesBuilder::Make(
+                       edge_info, prefix, AdjListType::ordered_by_source, 7)
+                       .value();
+    for (const auto& [src, dst, weight] : roads) {
+      builder::Edge e(src, dst);
+      e.AddProperty("weight", weight);
+      REQUIRE(builder->AddEdge(e).ok());
+    }
+    REQUIRE(builder->Dump().ok());
+    auto graph = CSRGraph::Make(edge_info, AdjListType::ordered_by_source,
+                                prefix, {"weight"})
+                     .value();
+
+    std::vector<double> expected_distances = {
+        0, 3, 1, 4, 7, 1e12 + 7, std::numeric_limits<double>::infinity()};
+    for (double delta : {0.0, 0.5, 1.0, 3.0}) {
+      auto maybe_distances =
+          analytics::SingleSourceShortestPaths(*graph, "weight", 0, delta, 4);
+      REQUIRE(maybe_distances.status().ok());
+      REQUIRE(maybe_distances.value() == expected_distances);
+    }
+    REQUIRE(analytics::SingleSourceShortestPaths(*graph, "not_exist", 0)
+                .status()
+                .IsKeyError());
+  }
+
+  SECTION("PageRank") {
+    // run the same iterations both ways
+    auto pull =
+        analytics::PageRank(*out_edges, in_edges.get(), 0.85, 30, 0).value();
+    auto push = analytics::PageRank(*out_edges, nullptr, 0.85, 30, 0).value();
+    REQUIRE(pull.size() == static_cast<size_t>(vertex_num));
+    double sum = 0;
+    for (IdType v = 0; v < vertex_num; ++v) {
+      sum += pull[v];
+      REQUIRE(std::abs(pull[v] - push[v]) < 1e-9);
+    }
+    REQUIRE(std::abs(sum - 1) < 1e-6);
+  }
+
+  SECTION("WeaklyConnectedComponents") {
+    auto components =
+        analytics::WeaklyConnectedComponents(*out_edges, 4).value();
+    for (IdType u = 0; u < vertex_num; ++u) {
+      REQUIRE(components[u] <= u);
+      REQUIRE(components[components[u]] == components[u]);
+      for (IdType j = out_edges->offsets()[u];
+           j < out_edges->offsets()[u + 1]; ++j) {
+        REQUIRE(components[u] == components[out_edges->neighbors()[j]]);
+      }
+    }
+    // the reachable vertices are in the component of the source
+    for (IdType v = 0; v < vertex_num; ++v) {
+      if (expected[v] != -1) {
+        REQUIRE(components[v] == components[source]);
+      }
+    }
+    REQUIRE(analytics::WeaklyConnectedComponents(*in_edges).value() ==
+            components);
+
+    // write the components back as a property of the vertices
+    std::string prefix = "/tmp/analytics/";
+    auto vertex_info = graph_info->GetVertexInfo("person");
+    auto writer = VertexPropertyWriter::Make(vertex_info, prefix).value();
+    REQUIRE(writer->WriteVerticesNum(vertex_num).ok());
+    auto maybe_info = analytics::WriteVertexProperty(vertex_info, prefix,
+                                                     "component", components);
+    REQUIRE(maybe_info.status().ok());
+    auto new_info = maybe_info.value();
+    REQUIRE(new_info->HasProperty("component"));
+    auto property_group = new_info->GetPropertyGroup("component");
+    auto file_path = new_info->GetFilePath(property_group, 0).value();
+    REQUIRE(std::filesystem::exists(prefix + file_path));
+
+    // read the property back
+    auto reader = VertexPropertyArrowChunkReader::Make(new_info, property_group,
+                                                       prefix)
+                      .value();
+    std::vector<IdType> read_back;
+    do {
+      auto column = reader->GetChunk().value()->GetColumnByName("component");
+      for (const auto& chunk : column->chunks()) {
+        auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+        read_back.insert(read_back.end(), array->raw_values(),
+                         array->raw_values() + array->length());
+      }
+    } while (reader->next_chunk().ok());
+    REQUIRE(read_back == components);
+
+    REQUIRE(analytics::WriteVertexProperty(vertex_info, prefix, "id",
+                                           components)
+                .has_error());
+    components.pop_back();
+    REQUIRE(analytics::WriteVertexProperty(vertex_info, prefix, "component2",
+                                           components)
+                .status()
+                .IsInvalid());
+  }
+}
+}  // namespace graphar
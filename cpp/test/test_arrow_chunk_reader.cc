@@ -20,6 +20,7 @@
 #include <cstdlib>
 
 #include "arrow/api.h"
+#include "arrow/io/api.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include "./util.h"
@@ -898,4 +899,727 @@ TEST_CASE_METHOD(GlobalFixture, "JSON_TEST") {
     }
   }
 }
+
+TEST_CASE_METHOD(GlobalFixture, "ChunkTableCache") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto& cache = ChunkTableCache::Global();
+  cache.Clear();
+  cache.ResetStats();
+  cache.SetCapacity(64 * 1024 * 1024);
+
+  SECTION("VertexPropertyArrowChunkReader") {
+    auto maybe_reader = VertexPropertyArrowChunkReader::Make(
+        graph_info, "person", "firstName");
+    REQUIRE(maybe_reader.status().ok());
+    auto reader = maybe_reader.value();
+    REQUIRE(reader->seek(0).ok());
+    auto first = reader->GetChunk().value();
+    REQUIRE(reader->seek(100).ok());
+    REQUIRE(!reader->GetChunk().has_error());
+    // bouncing back to the first chunk is served from the cache
+    REQUIRE(reader->seek(0).ok());
+    auto second = reader->GetChunk().value();
+    REQUIRE(second->Equals(*first));
+    auto stats = cache.GetStats();
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.num_entries == 2);
+    REQUIRE(stats.size_bytes > 0);
+  }
+
+  SECTION("ColumnIndexKey") {
+    auto reader =
+        VertexPropertyArrowChunkReader::Make(graph_info, "person", "firstName")
+            .value();
+    REQUIRE(!reader->GetChunk(GetChunkVersion::V2).has_error());
+    // the chunk of a filtered reader is not cast to the schema, so it is not
+    // served the cast chunk of the unfiltered one
+    auto filtered_reader =
+        VertexPropertyArrowChunkReader::Make(graph_info, "person", "firstName")
+            .value();
+    filtered_reader->Filter(
+        _Equal(_Property("firstName"), _Literal("Hossein")));
+    REQUIRE(!filtered_reader->GetChunk(GetChunkVersion::V2).has_error());
+    auto stats = cache.GetStats();
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.hits == 0);
+  }
+
+  SECTION("AdjListArrowChunkReader") {
+    auto maybe_reader = AdjListArrowChunkReader::Make(
+        graph_info, "person", "knows", "person",
+        AdjListType::ordered_by_source);
+    REQUIRE(maybe_reader.status().ok());
+    auto reader = maybe_reader.value();
+    auto first = reader->GetChunk().value();
+    // a copy of the reader shares the cached chunk
+    AdjListArrowChunkReader copied(*reader);
+    auto second = copied.GetChunk().value();
+    REQUIRE(second->Equals(*first));
+    REQUIRE(cache.GetStats().hits == 1);
+  }
+
+  SECTION("FilterKey") {
+    // the filters of the same expression share a key
+    auto filter = _Equal(_Property("gender"), _Literal("female"));
+    auto same_filter = _Equal(_Property("gender"), _Literal("female"));
+    auto key = ChunkTableCache::MakeKey("chunk0", {"gender"}, filter);
+    REQUIRE(!key.empty());
+    REQUIRE(ChunkTableCache::MakeKey("chunk0", {"gender"}, same_filter) ==
+            key);
+    REQUIRE(ChunkTableCache::MakeKey("chunk0", {"gender"}) != key);
+    // a filter that can not be evaluated is not cached
+    auto invalid_filter = _Equal(_Property("gender"), nullptr);
+    auto invalid_key =
+        ChunkTableCache::MakeKey("chunk0", {"gender"}, invalid_filter);
+    REQUIRE(invalid_key.empty());
+    auto table = arrow::Table::MakeEmpty(arrow::schema({})).ValueOrDie();
+    REQUIRE(cache
+                .GetOrLoad(invalid_key, "chunk0",
+                           [&]() -> Result<std::shared_ptr<arrow::Table>> {
+                             return table;
+                           })
+                .value() == table);
+    REQUIRE(cache.GetStats().num_entries == 0);
+  }
+
+  SECTION("Eviction") {
+    auto maybe_reader = AdjListOffsetArrowChunkReader::Make(
+        graph_info, "person", "knows", "person",
+        AdjListType::ordered_by_source);
+    REQUIRE(maybe_reader.status().ok());
+    auto reader = maybe_reader.value();
+    REQUIRE(!reader->GetChunk().has_error());
+    auto size = cache.GetStats().size_bytes;
+    // only one chunk fits in the budget
+    cache.SetCapacity(size);
+    REQUIRE(reader->next_chunk().ok());
+    REQUIRE(!reader->GetChunk().has_error());
+    auto stats = cache.GetStats();
+    REQUIRE(stats.evictions >= 1);
+    REQUIRE(stats.size_bytes <= size);
+  }
+
+  cache.SetCapacity(0);
+  cache.Clear();
+  REQUIRE(cache.GetStats().num_entries == 0);
+}
+
+TEST_CASE_METHOD(GlobalFixture, "GraphCountIndex") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto edge_info = graph_info->GetEdgeInfo("person", "knows", "person");
+  REQUIRE(edge_info != nullptr);
+  auto prefix = graph_info->GetPrefix();
+  auto adj_list_type = AdjListType::ordered_by_source;
+
+  auto maybe_index = GraphCountIndex::Get(prefix, edge_info, adj_list_type);
+  REQUIRE(!maybe_index.has_error());
+  auto index = maybe_index.value();
+  REQUIRE(index->GetVertexChunkNum() ==
+          util::GetVertexChunkNum(prefix, edge_info, adj_list_type).value());
+  IdType total_edge_num = 0;
+  for (IdType i = 0; i < index->GetVertexChunkNum(); ++i) {
+    auto edge_num = util::GetEdgeNum(prefix, edge_info, adj_list_type, i);
+    REQUIRE(index->GetEdgeNum(i).value() == edge_num.value());
+    REQUIRE(index->GetEdgeChunkNum(i).value() ==
+            util::GetEdgeChunkNum(prefix, edge_info, adj_list_type, i).value());
+    total_edge_num += edge_num.value();
+  }
+  REQUIRE(index->GetTotalEdgeNum() == total_edge_num);
+  REQUIRE(index->GetEdgeNum(index->GetVertexChunkNum()).has_error());
+  // the index is loaded once and shared
+  REQUIRE(GraphCountIndex::Get(prefix, edge_info, adj_list_type).value() ==
+          index);
+
+  SECTION("DisableRegistry") {
+    GraphCountIndex::SetRegistryEnabled(false);
+    REQUIRE(!GraphCountIndex::IsRegistryEnabled());
+    REQUIRE(GraphCountIndex::Lookup(prefix, edge_info, adj_list_type) ==
+            nullptr);
+    // every call loads the counts afresh
+    auto loaded = GraphCountIndex::Get(prefix, edge_info, adj_list_type);
+    REQUIRE(!loaded.has_error());
+    REQUIRE(loaded.value() != index);
+    REQUIRE(loaded.value()->GetTotalEdgeNum() == total_edge_num);
+    REQUIRE(GraphCountIndex::Lookup(prefix, edge_info, adj_list_type) ==
+            nullptr);
+    REQUIRE(util::GetEdgeNum(prefix, edge_info, adj_list_type, 0).value() ==
+            index->GetEdgeNum(0).value());
+    GraphCountIndex::SetRegistryEnabled(true);
+  }
+}
+
+TEST_CASE_METHOD(GlobalFixture, "OffsetIndex") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto edge_info = graph_info->GetEdgeInfo("person", "knows", "person");
+  REQUIRE(edge_info != nullptr);
+  auto prefix = graph_info->GetPrefix();
+  auto adj_list_type = AdjListType::ordered_by_source;
+
+  auto maybe_index = OffsetIndex::Get(prefix, edge_info, adj_list_type);
+  REQUIRE(!maybe_index.has_error());
+  auto index = maybe_index.value();
+  auto offset_reader = AdjListOffsetArrowChunkReader::Make(
+                           edge_info, adj_list_type, prefix)
+                           .value();
+  for (IdType vid : {0, 1, 99, 100, 902}) {
+    auto range = index->GetRange(vid);
+    REQUIRE(!range.has_error());
+    REQUIRE(offset_reader->seek(vid).ok());
+    auto offsets = std::static_pointer_cast<arrow::Int64Array>(
+        offset_reader->GetChunk().value());
+    REQUIRE(range.value().first == offsets->Value(0));
+    REQUIRE(range.value().second == offsets->Value(1));
+    REQUIRE(offset_reader->GetRange().value() == range.value());
+  }
+  REQUIRE(index->IsLoaded(0));
+  REQUIRE(index->GetRange(-1).status().IsIndexError());
+  REQUIRE(index->GetRange(index->GetVertexChunkNum() *
+                          index->GetVertexChunkSize())
+              .status()
+              .IsIndexError());
+  REQUIRE(index->LoadAll().ok());
+  for (IdType i = 0; i < index->GetVertexChunkNum(); ++i) {
+    REQUIRE(index->IsLoaded(i));
+  }
+  REQUIRE(index->GetMemoryUsage() > 0);
+  // the index is shared by the readers of the same adj list
+  REQUIRE(OffsetIndex::Get(prefix, edge_info, adj_list_type).value() ==
+          index);
+  REQUIRE(OffsetIndex::Get(prefix, edge_info, AdjListType::unordered_by_source)
+              .has_error());
+}
+
+TEST_CASE_METHOD(GlobalFixture, "NeighborArrowReader") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto edge_info = graph_info->GetEdgeInfo("person", "knows", "person");
+  REQUIRE(edge_info != nullptr);
+  auto prefix = graph_info->GetPrefix();
+  auto adj_list_type = AdjListType::ordered_by_source;
+  auto pg = edge_info->GetPropertyGroup("creationDate");
+  REQUIRE(pg != nullptr);
+
+  auto maybe_reader =
+      NeighborArrowReader::Make(edge_info, adj_list_type, prefix, {pg});
+  REQUIRE(maybe_reader.status().ok());
+  auto reader = maybe_reader.value();
+  std::vector<IdType> vids = {0, 902, 1, 100, 0};
+  auto maybe_batch =
+      reader->GetNeighbors(Array<IdType>(vids.data(), vids.size()));
+  REQUIRE(maybe_batch.status().ok());
+  auto batch = maybe_batch.value();
+  REQUIRE(batch.offsets->length() == static_cast<int64_t>(vids.size()) + 1);
+  REQUIRE(batch.neighbors->length() == batch.offsets->Value(vids.size()));
+  REQUIRE(batch.properties->num_rows() == batch.neighbors->length());
+
+  // compare with seeking the adj list reader vertex by vertex
+  auto adj_reader = AdjListArrowChunkReader::Make(edge_info, adj_list_type,
+                                                  prefix)
+                        .value();
+  for (size_t i = 0; i < vids.size(); ++i) {
+    auto range = util::GetAdjListOffsetOfVertex(edge_info, prefix,
+                                                adj_list_type, vids[i])
+                     .value();
+    REQUIRE(batch.offsets->Value(i + 1) - batch.offsets->Value(i) ==
+            range.second - range.first);
+    if (range.first == range.second) {
+      continue;
+    }
+    REQUIRE(adj_reader->seek_src(vids[i]).ok());
+    auto table = adj_reader->GetChunk().value();
+    auto dst = std::static_pointer_cast<arrow::Int64Array>(
+        table->GetColumnByName(GeneralParams::kDstIndexCol)->chunk(0));
+    REQUIRE(batch.neighbors->Value(batch.offsets->Value(i)) == dst->Value(0));
+  }
+  // the neighbors of the duplicated vertex are the same
+  REQUIRE(batch.offsets->Value(1) - batch.offsets->Value(0) ==
+          batch.offsets->Value(5) - batch.offsets->Value(4));
+
+  std::vector<IdType> empty_vids;
+  auto empty_batch =
+      reader->GetNeighbors(Array<IdType>(empty_vids.data(), 0)).value();
+  REQUIRE(empty_batch.offsets->length() == 1);
+  REQUIRE(empty_batch.neighbors->length() == 0);
+  std::vector<IdType> invalid_vids = {-1};
+  REQUIRE(reader->GetNeighbors(Array<IdType>(invalid_vids.data(), 1))
+              .status()
+              .IsIndexError());
+  REQUIRE(NeighborArrowReader::Make(edge_info,
+                                    AdjListType::unordered_by_source, prefix)
+              .status()
+              .IsInvalid());
+}
+
+TEST_CASE_METHOD(GlobalFixture, "CSRGraph") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto edge_info = graph_info->GetEdgeInfo("person", "knows", "person");
+  REQUIRE(edge_info != nullptr);
+  auto prefix = graph_info->GetPrefix();
+
+  for (auto adj_list_type :
+       {AdjListType::ordered_by_source, AdjListType::ordered_by_dest}) {
+    auto maybe_graph = CSRGraph::Make(graph_info, "person", "knows", "person",
+                                      adj_list_type, {"creationDate"});
+    REQUIRE(maybe_graph.status().ok());
+    auto graph = maybe_graph.value();
+    auto count_index =
+        GraphCountIndex::Get(prefix, edge_info, adj_list_type).value();
+    REQUIRE(graph->GetVertexNum() == count_index->GetVertexNum());
+    REQUIRE(graph->GetEdgeNum() == count_index->GetTotalEdgeNum());
+    REQUIRE(graph->offsets()[0] == 0);
+    REQUIRE(graph->offsets()[graph->GetVertexNum()] == graph->GetEdgeNum());
+    REQUIRE(graph->GetProperty("creationDate").value()->length() ==
+            graph->GetEdgeNum());
+    REQUIRE(graph->GetProperty("not_exist").status().IsKeyError());
+
+    // compare with the neighbors of the edges scanned chunk by chunk
+    auto cursor = EdgeChunkCursor::Make(edge_info, adj_list_type, prefix)
+                      .value();
+    REQUIRE(cursor->seek_chunk_index(0).ok());
+    IdType edge = 0;
+    do {
+      for (int64_t i = 0; i < cursor->size(); ++i, ++edge) {
+        IdType vid = adj_list_type == AdjListType::ordered_by_source
+                         ? cursor->sources()[i]
+                         : cursor->destinations()[i];
+        IdType neighbor = adj_list_type == AdjListType::ordered_by_source
+                              ? cursor->destinations()[i]
+                              : cursor->sources()[i];
+        REQUIRE(graph->offsets()[vid] <= edge);
+        REQUIRE(edge < graph->offsets()[vid + 1]);
+        REQUIRE(graph->neighbors()[edge] == neighbor);
+      }
+    } while (cursor->next_chunk().ok());
+    REQUIRE(edge == graph->GetEdgeNum());
+  }
+
+  REQUIRE(CSRGraph::Make(edge_info, AdjListType::unordered_by_source, prefix)
+              .status()
+              .IsInvalid());
+  REQUIRE(CSRGraph::Make(edge_info, AdjListType::ordered_by_source, prefix,
+                         {"not_exist"})
+              .status()
+              .IsKeyError());
+}
+
+TEST_CASE_METHOD(GlobalFixture, "EdgeChunkCursor") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto edge_info = graph_info->GetEdgeInfo("person", "knows", "person");
+  REQUIRE(edge_info != nullptr);
+  auto prefix = graph_info->GetPrefix();
+  auto adj_list_type = AdjListType::ordered_by_source;
+  auto pg = edge_info->GetPropertyGroup("creationDate");
+  REQUIRE(pg != nullptr);
+
+  auto maybe_cursor =
+      EdgeChunkCursor::Make(edge_info, adj_list_type, prefix, {pg});
+  REQUIRE(maybe_cursor.status().ok());
+  auto cursor = maybe_cursor.value();
+  auto adj_reader =
+      AdjListArrowChunkReader::Make(edge_info, adj_list_type, prefix).value();
+  auto count_index =
+      GraphCountIndex::Get(prefix, edge_info, adj_list_type).value();
+
+  SECTION("Scan") {
+    REQUIRE(cursor->seek_chunk_index(0).ok());
+    IdType total = 0;
+    IdType chunk_count = 0;
+    do {
+      REQUIRE(cursor->size() > 0);
+      // the first chunk matches the adj list reader
+      if (chunk_count == 0) {
+        auto table = adj_reader->GetChunk().value();
+        auto src = std::static_pointer_cast<arrow::Int64Array>(
+            table->GetColumnByName(GeneralParams::kSrcIndexCol)->chunk(0));
+        auto dst = std::static_pointer_cast<arrow::Int64Array>(
+            table->GetColumnByName(GeneralParams::kDstIndexCol)->chunk(0));
+        REQUIRE(table->num_rows() == cursor->size());
+        for (int64_t i = 0; i < cursor->size(); ++i) {
+          REQUIRE(cursor->sources()[i] == src->Value(i));
+          REQUIRE(cursor->destinations()[i] == dst->Value(i));
+        }
+      }
+      auto properties = cursor->GetProperties().value();
+      REQUIRE(properties->num_rows() == cursor->size());
+      REQUIRE(properties->GetColumnByName("creationDate") != nullptr);
+      total += cursor->size();
+      ++chunk_count;
+    } while (cursor->next_chunk().ok());
+    REQUIRE(cursor->next_chunk().IsIndexError());
+    REQUIRE(chunk_count > 0);
+    REQUIRE(total == count_index->GetTotalEdgeNum());
+  }
+
+  SECTION("SeekOutOfRange") {
+    REQUIRE(cursor->seek_chunk_index(-1).IsIndexError());
+    REQUIRE(cursor->seek_chunk_index(0, 1 << 20).IsIndexError());
+  }
+}
+
+TEST_CASE_METHOD(GlobalFixture, "ChunkPrefetcher") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+
+  SECTION("PrefetchAndTake") {
+    ChunkPrefetcher prefetcher(1);
+    auto table = arrow::Table::Make(arrow::schema({}), {}, 0);
+    int sync_loads = 0;
+    prefetcher.Prefetch("a", [table]() { return table; });
+    REQUIRE(prefetcher.IsPending("a"));
+    auto taken =
+        prefetcher.Take("a", [&]() -> Result<std::shared_ptr<arrow::Table>> {
+          ++sync_loads;
+          return table;
+        });
+    REQUIRE(taken.value() == table);
+    REQUIRE(sync_loads == 0);
+    REQUIRE(!prefetcher.IsPending("a"));
+    // the loads beyond twice the depth are dropped
+    prefetcher.Prefetch("b", [table]() { return table; });
+    prefetcher.Prefetch("c", [table]() { return table; });
+    prefetcher.Prefetch("d", [table]() { return table; });
+    REQUIRE(!prefetcher.IsPending("b"));
+    REQUIRE(prefetcher.IsPending("d"));
+  }
+
+  SECTION("VertexPropertyArrowChunkReader") {
+    auto reader = VertexPropertyArrowChunkReader::Make(graph_info, "person",
+                                                       "firstName")
+                      .value();
+    auto expected = VertexPropertyArrowChunkReader::Make(graph_info, "person",
+                                                         "firstName")
+                        .value();
+    reader->SetPrefetchDepth(2);
+    int64_t num_chunks = 0;
+    while (true) {
+      auto table = reader->GetChunk().value();
+      REQUIRE(table->Equals(*expected->GetChunk().value()));
+      ++num_chunks;
+      auto status = reader->next_chunk();
+      REQUIRE(status.ok() == expected->next_chunk().ok());
+      if (!status.ok()) {
+        break;
+      }
+    }
+    REQUIRE(num_chunks == expected->GetChunkNum());
+  }
+
+  SECTION("CopiedReader") {
+    auto reader = VertexPropertyArrowChunkReader::Make(graph_info, "person",
+                                                       "firstName")
+                      .value();
+    reader->SetPrefetchDepth(1);
+    // the copy reads ahead on its own, from its own position
+    VertexPropertyArrowChunkReader copy(*reader);
+    REQUIRE(reader->next_chunk().ok());
+    REQUIRE(copy.GetChunk().value()->Equals(
+        *VertexPropertyArrowChunkReader::Make(graph_info, "person",
+                                              "firstName")
+             .value()
+             ->GetChunk()
+             .value()));
+  }
+
+  SECTION("AdjListArrowChunkReader") {
+    auto reader =
+        AdjListArrowChunkReader::Make(graph_info, "person", "knows", "person",
+                                      AdjListType::ordered_by_source)
+            .value();
+    auto expected =
+        AdjListArrowChunkReader::Make(graph_info, "person", "knows", "person",
+                                      AdjListType::ordered_by_source)
+            .value();
+    reader->SetPrefetchDepth(3);
+    int64_t num_chunks = 0;
+    while (true) {
+      auto table = reader->GetChunk().value();
+      REQUIRE(table->Equals(*expected->GetChunk().value()));
+      ++num_chunks;
+      auto status = reader->next_chunk();
+      REQUIRE(status.ok() == expected->next_chunk().ok());
+      if (!status.ok()) {
+        break;
+      }
+    }
+    REQUIRE(num_chunks > 1);
+  }
+}
+
+TEST_CASE_METHOD(GlobalFixture, "ReadWholePropertyGroupAndAdjList") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto vertex_info = graph_info->GetVertexInfo("person");
+  REQUIRE(vertex_info != nullptr);
+  auto pg = vertex_info->GetPropertyGroup("firstName");
+  REQUIRE(pg != nullptr);
+  auto edge_info = graph_info->GetEdgeInfo("person", "knows", "person");
+  REQUIRE(edge_info != nullptr);
+  auto adj_list_type = AdjListType::ordered_by_source;
+
+  SECTION("ReadVertexPropertyGroup") {
+    auto maybe_table = ReadVertexPropertyGroup(graph_info, "person", pg);
+    REQUIRE(maybe_table.status().ok());
+    auto table = maybe_table.value();
+    auto vertex_num =
+        util::GetVertexNum(graph_info->GetPrefix(), vertex_info).value();
+    REQUIRE(table->num_rows() == vertex_num);
+    // the chunks are concatenated in order
+    auto reader =
+        VertexPropertyArrowChunkReader::Make(graph_info, "person", pg).value();
+    auto first_chunk = reader->GetChunk().value();
+    REQUIRE(table->Slice(0, first_chunk->num_rows())->Equals(*first_chunk));
+
+    auto maybe_stream = ReadVertexPropertyGroupStream(graph_info, "person", pg);
+    REQUIRE(maybe_stream.status().ok());
+    auto stream = maybe_stream.value();
+    REQUIRE(stream->schema()->Equals(*table->schema()));
+    int64_t num_rows = 0;
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (stream->ReadNext(&batch).ok() && batch != nullptr) {
+      num_rows += batch->num_rows();
+    }
+    REQUIRE(num_rows == vertex_num);
+  }
+
+  SECTION("ReadAdjList") {
+    auto count_index =
+        GraphCountIndex::Get(graph_info->GetPrefix(), edge_info, adj_list_type)
+            .value();
+    auto maybe_table =
+        ReadAdjList(edge_info, adj_list_type, graph_info->GetPrefix());
+    REQUIRE(maybe_table.status().ok());
+    REQUIRE(maybe_table.value()->num_rows() == count_index->GetTotalEdgeNum());
+
+    // projection pushdown
+    std::vector<std::string> columns = {GeneralParams::kDstIndexCol};
+    util::FilterOptions options;
+    options.columns = std::ref(columns);
+    auto maybe_stream = ReadAdjListStream(edge_info, adj_list_type,
+                                          graph_info->GetPrefix(), options);
+    REQUIRE(maybe_stream.status().ok());
+    auto stream = maybe_stream.value();
+    REQUIRE(stream->schema()->num_fields() == 1);
+    int64_t num_rows = 0;
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (stream->ReadNext(&batch).ok() && batch != nullptr) {
+      num_rows += batch->num_rows();
+    }
+    REQUIRE(num_rows == count_index->GetTotalEdgeNum());
+  }
+
+  SECTION("ReadWithOneIOThread") {
+    // the chunk loads do not hold the IO thread that their file reads need
+    int capacity = arrow::io::GetIOThreadPoolCapacity();
+    REQUIRE(arrow::io::SetIOThreadPoolCapacity(1).ok());
+    auto maybe_table =
+        ReadAdjList(edge_info, adj_list_type, graph_info->GetPrefix());
+    auto maybe_group = ReadVertexPropertyGroup(graph_info, "person", pg);
+    REQUIRE(arrow::io::SetIOThreadPoolCapacity(capacity).ok());
+    REQUIRE(maybe_table.status().ok());
+    REQUIRE(maybe_group.status().ok());
+  }
+}
+
+TEST_CASE_METHOD(GlobalFixture, "ReadFileToTableByColumnIndices") {
+  std::string chunk = "/vertex/person/firstName_lastName_gender/chunk1";
+  std::vector<std::pair<std::string, FileType>> files = {
+      {"/ldbc_sample/parquet", FileType::PARQUET},
+      {"/ldbc_sample/csv", FileType::CSV}};
+#ifdef ARROW_ORC
+  files.emplace_back("/ldbc_sample/orc", FileType::ORC);
+#endif
+  for (const auto& [dir, file_type] : files) {
+    std::string path = test_data_dir + dir + chunk;
+    std::string out_path;
+    auto fs = FileSystemFromUriOrPath(path, &out_path).value();
+    auto expected = fs->ReadFileToTable(out_path, file_type).value();
+    int index = expected->schema()->GetFieldIndex("firstName");
+    REQUIRE(index >= 0);
+    auto maybe_table = fs->ReadFileToTable(out_path, file_type, {index});
+    REQUIRE(maybe_table.status().ok());
+    auto table = maybe_table.value();
+    REQUIRE(table->num_columns() == 1);
+    REQUIRE(table->field(0)->name() == "firstName");
+    REQUIRE(table->num_rows() == expected->num_rows());
+    REQUIRE(table->column(0)->GetScalar(0).ValueOrDie()->ToString() ==
+            expected->column(index)->GetScalar(0).ValueOrDie()->ToString());
+  }
+}
+
+TEST_CASE_METHOD(GlobalFixture, "FileSystemRegistry") {
+  std::string uri = "file://" + test_data_dir + "/ldbc_sample/parquet/";
+  std::string mmap_query = "?use_mmap=true";
+  // the same scheme, authority and options share one instance, whatever
+  // the path
+  auto fs = FileSystemFromUriOrPath(uri).value();
+  REQUIRE(FileSystemFromUriOrPath(uri).value() == fs);
+  REQUIRE(FileSystemFromUriOrPath(uri + "vertex/").value() == fs);
+
+  // different options create a distinct instance, shared in turn
+  auto mmap_fs = FileSystemFromUriOrPath(uri + mmap_query).value();
+  REQUIRE(mmap_fs != fs);
+  REQUIRE(FileSystemFromUriOrPath(uri + "vertex/" + mmap_query).value() ==
+          mmap_fs);
+
+  // the cleared registry creates new instances, the released ones stay valid
+  ClearFileSystemRegistry();
+  auto new_fs = FileSystemFromUriOrPath(uri).value();
+  REQUIRE(new_fs != fs);
+  REQUIRE(FileSystemFromUriOrPath(uri + mmap_query).value() != mmap_fs);
+  REQUIRE(FileSystemFromUriOrPath(uri).value() == new_fs);
+  std::string graph_path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  REQUIRE(fs->FileExists(graph_path).value());
+}
+
+TEST_CASE_METHOD(GlobalFixture, "ReadFileToTableWithFilter") {
+  std::string prefix = test_data_dir +
+                       "/ldbc_sample/parquet/vertex/person/"
+                       "firstName_lastName_gender/chunk";
+  std::string out_prefix;
+  auto fs = FileSystemFromUriOrPath(prefix, &out_prefix).value();
+  // the same filter is applied to the chunks of the property group
+  auto filter = _Equal(_Property("gender"), _Literal("female"));
+  for (int i = 0; i < 2; ++i) {
+    std::string path = out_prefix + std::to_string(i);
+    auto all = fs->ReadFileToTable(path, FileType::PARQUET).value();
+    auto maybe_table = fs->ReadFileToTable(
+        path, FileType::PARQUET, util::FilterOptions(filter, std::nullopt));
+    REQUIRE(maybe_table.status().ok());
+    auto table = maybe_table.value();
+    REQUIRE(table->num_columns() == all->num_columns());
+    REQUIRE(table->num_rows() < all->num_rows());
+    auto gender = table->GetColumnByName("gender");
+    REQUIRE(gender->type()->Equals(arrow::large_utf8()));
+    for (const auto& chunk : gender->chunks()) {
+      auto array = std::static_pointer_cast<arrow::LargeStringArray>(chunk);
+      for (int64_t j = 0; j < array->length(); ++j) {
+        REQUIRE(array->GetView(j) == "female");
+      }
+    }
+  }
+}
+
+TEST_CASE_METHOD(GlobalFixture, "ReadStringColumnsWithNativeOffsets") {
+  std::string path = test_data_dir +
+                     "/ldbc_sample/parquet/vertex/person/"
+                     "firstName_lastName_gender/chunk0";
+  std::string out_path;
+  auto fs = FileSystemFromUriOrPath(path, &out_path).value();
+  auto large = fs->ReadFileToTable(out_path, FileType::PARQUET).value();
+  util::FilterOptions options;
+  options.large_string_offsets = false;
+  auto native =
+      fs->ReadFileToTable(out_path, FileType::PARQUET, options).value();
+  auto column = native->GetColumnByName("firstName");
+  REQUIRE(column->type()->Equals(arrow::utf8()));
+  REQUIRE(large->GetColumnByName("firstName")->type()->Equals(
+      arrow::large_utf8()));
+
+  // widening the native column gives the large column
+  auto widened = util::WidenStringOffsets(column).value();
+  REQUIRE(widened->type()->Equals(arrow::large_utf8()));
+  REQUIRE(widened->Equals(*large->GetColumnByName("firstName")));
+  auto slice = util::WidenStringOffsets(column->chunk(0)->Slice(3, 5)).value();
+  REQUIRE(slice->Equals(*large->GetColumnByName("firstName")
+                             ->chunk(0)
+                             ->Slice(3, 5)));
+  REQUIRE(util::WidenStringOffsets(native->GetColumnByName("gender"))
+              .status()
+              .ok());
+  REQUIRE(util::WidenStringOffsets(arrow::MakeArrayOfNull(arrow::int64(), 1)
+                                       .ValueOrDie())
+              .status()
+              .IsTypeError());
+}
+TEST_CASE_METHOD(GlobalFixture, "ReadContext") {
+  std::string path =
+      test_data_dir + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  auto graph_info = GraphInfo::Load(path).value();
+  auto vertex_info = graph_info->GetVertexInfo("person");
+  auto pg = vertex_info->GetPropertyGroup("firstName");
+  auto edge_info = graph_info->GetEdgeInfo("person", "knows", "person");
+
+  // the allocations of the reads are made from the pool of the context
+  arrow::ProxyMemoryPool pool(arrow::default_memory_pool());
+  auto context = std::make_shared<ReadContext>(&pool);
+  REQUIRE(context->GetMemoryPool() == &pool);
+  REQUIRE(!context->IsDefaultMemoryPool());
+  REQUIRE(ExecutionContext::Default()->IsDefaultMemoryPool());
+  util::FilterOptions options;
+  options.context = context;
+  {
+    auto reader = VertexPropertyArrowChunkReader::Make(graph_info, "person",
+                                                       pg, options)
+                      .value();
+    auto table = reader->GetChunk(GetChunkVersion::V2).value();
+    REQUIRE(table->num_rows() > 0);
+    REQUIRE(pool.bytes_allocated() > 0);
+
+    auto adj_list_reader =
+        AdjListArrowChunkReader::Make(graph_info, "person", "knows", "person",
+                                      AdjListType::ordered_by_source)
+            .value();
+    adj_list_reader->SetReadContext(context);
+    auto before = pool.total_bytes_allocated();
+    REQUIRE(adj_list_reader->GetChunk().value()->num_rows() > 0);
+    REQUIRE(pool.total_bytes_allocated() > before);
+
+    auto whole = ReadVertexPropertyGroup(graph_info, "person", pg, options)
+                     .value();
+    REQUIRE(whole->num_rows() ==
+            util::GetVertexNum(graph_info->GetPrefix(), vertex_info).value());
+  }
+  // the chunks are not kept by the chunk cache, so the memory of the reads is
+  // released with the readers
+  REQUIRE(pool.bytes_allocated() == 0);
+}
+
+TEST_CASE_METHOD(GlobalFixture, "ReadFileToTableWithMmap") {
+  std::string path = test_data_dir +
+                     "/ldbc_sample/parquet/vertex/person/"
+                     "firstName_lastName_gender/chunk0";
+  std::string out_path;
+  auto fs = FileSystemFromUriOrPath(path, &out_path).value();
+  auto expected = fs->ReadFileToTable(out_path, FileType::PARQUET).value();
+
+  SECTION("MmapFileSystem") {
+    std::string mmap_path;
+    auto mmap_fs =
+        FileSystemFromUriOrPath("file://" + path + "?use_mmap=true", &mmap_path)
+            .value();
+    REQUIRE(mmap_fs != fs);
+    REQUIRE(mmap_path == out_path);
+    auto table =
+        mmap_fs->ReadFileToTable(mmap_path, FileType::PARQUET).value();
+    REQUIRE(table->Equals(*expected));
+  }
+
+  SECTION("MmapReadContext") {
+    auto context = std::make_shared<ReadContext>();
+    context->SetUseMmap(true);
+    auto table =
+        fs->ReadFileToTable(out_path, FileType::PARQUET, {}, context).value();
+    REQUIRE(table->Equals(*expected));
+    util::FilterOptions options;
+    options.context = context;
+    auto filtered =
+        fs->ReadFileToTable(out_path, FileType::PARQUET, options).value();
+    REQUIRE(filtered->Equals(*expected));
+  }
+}
 }  // namespace graphar
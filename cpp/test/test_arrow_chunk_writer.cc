@@ -39,6 +39,7 @@
 #include "parquet/arrow/writer.h"
 
 #include "./util.h"
+#include "graphar/api/arrow_reader.h"
 #include "graphar/api/arrow_writer.h"
 
 #include <catch2/catch_test_macros.hpp>
@@ -276,6 +277,41 @@ TEST_CASE_METHOD(GlobalFixture, "TestVertexPropertyWriter") {
                 1);
 #endif
   }
+
+  SECTION("TestVertexPropertyWriterWithIpc") {
+    PropertyGroupVector ipc_groups;
+    for (const auto& pg : vertex_info_parquet->GetPropertyGroups()) {
+      ipc_groups.push_back(CreatePropertyGroup(pg->GetProperties(),
+                                               FileType::IPC, pg->GetPrefix()));
+    }
+    auto vertex_info_ipc =
+        CreateVertexInfo("person", vertex_info_parquet->GetChunkSize(),
+                         ipc_groups, {}, "vertex/person/");
+    REQUIRE(vertex_info_ipc->IsValidated());
+    auto pg = vertex_info_ipc->GetPropertyGroup("firstName");
+    auto chunk_size = vertex_info_ipc->GetChunkSize();
+    auto expected = table->Slice(0, chunk_size);
+
+    auto ipc_builder = WriterOptions::IPCOptionBuilder();
+    ipc_builder.compression(arrow::Compression::type::ZSTD);
+    auto wopt = ipc_builder.build();
+    auto writer =
+        VertexPropertyWriter::Make(vertex_info_ipc, "/tmp/ipc/", wopt).value();
+    REQUIRE(writer->WriteTable(table, pg, 0).ok());
+    auto reader =
+        VertexPropertyArrowChunkReader::Make(vertex_info_ipc, pg, "/tmp/ipc/")
+            .value();
+    auto chunk = reader->GetChunk().value();
+    REQUIRE(chunk->num_rows() == chunk_size);
+    for (const auto& p : pg->GetProperties()) {
+      REQUIRE(chunk->GetColumnByName(p.name)->ToString() ==
+              expected->GetColumnByName(p.name)->ToString());
+    }
+
+    // the IPC format only supports the LZ4_FRAME and ZSTD buffer compression
+    ipc_builder.compression(arrow::Compression::type::SNAPPY);
+    REQUIRE(writer->WriteTable(table, pg, 0).IsInvalid());
+  }
 }
 TEST_CASE_METHOD(GlobalFixture, "TestEdgeChunkWriter") {
   arrow::Status st;
@@ -346,6 +382,58 @@ TEST_CASE_METHOD(GlobalFixture, "TestEdgeChunkWriter") {
         reinterpret_cast<const IdType*>(vertex_num->data());
     REQUIRE((*vertex_num_ptr) == 903);
 
+    // Write the count manifest under its own prefix and load the counts from
+    // it
+    std::string manifest_prefix = "/tmp/count_manifest/";
+    auto manifest_writer =
+        EdgeChunkWriter::Make(edge_info_csv, manifest_prefix, adj_list_type)
+            .value();
+    IdType vertex_chunk_num = (903 + edge_info_csv->GetSrcChunkSize() - 1) /
+                              edge_info_csv->GetSrcChunkSize();
+    std::vector<IdType> edge_nums(vertex_chunk_num, 0);
+    std::vector<EdgeChunkIdRange> id_ranges(vertex_chunk_num);
+    edge_nums[0] = table->num_rows();
+    id_ranges[0] = {0, 99, 0, 902};
+    REQUIRE(manifest_writer->WriteVerticesNum(903).ok());
+    REQUIRE(manifest_writer->WriteCountManifest(edge_nums, id_ranges).ok());
+    auto count_index =
+        GraphCountIndex::Get(manifest_prefix, edge_info_csv, adj_list_type)
+            .value();
+    REQUIRE(count_index->GetVertexNum() == 903);
+    REQUIRE(count_index->GetEdgeNum(0).value() == table->num_rows());
+    REQUIRE(count_index->GetTotalEdgeNum() == table->num_rows());
+    REQUIRE(count_index->HasIdRanges());
+    REQUIRE(count_index->GetIdRange(0).value().max_dst == 902);
+    REQUIRE(count_index->GetIdRange(1).value().empty());
+    REQUIRE(manifest_writer
+                ->WriteCountManifest(edge_nums, {EdgeChunkIdRange()})
+                .IsInvalid());
+
+    // Writing an edge count deletes the manifest, the counts are read from
+    // the count files afterwards
+    for (IdType i = 0; i < vertex_chunk_num; ++i) {
+      REQUIRE(manifest_writer->WriteEdgesNum(i, i == 0 ? 1 : 0).ok());
+    }
+    count_index =
+        GraphCountIndex::Get(manifest_prefix, edge_info_csv, adj_list_type)
+            .value();
+    REQUIRE(!count_index->HasIdRanges());
+    REQUIRE(count_index->GetEdgeNum(0).value() == 1);
+    auto manifest_path =
+        edge_info_csv->GetEdgesNumManifestFilePath(adj_list_type).value();
+    auto manifest_info =
+        fs->GetFileInfo(manifest_prefix + manifest_path).ValueOrDie();
+    REQUIRE(manifest_info.type() == arrow::fs::FileType::NotFound);
+    // a manifest written again is deleted by the next write again
+    REQUIRE(manifest_writer->WriteCountManifest(edge_nums, id_ranges).ok());
+    manifest_info =
+        fs->GetFileInfo(manifest_prefix + manifest_path).ValueOrDie();
+    REQUIRE(manifest_info.type() == arrow::fs::FileType::File);
+    REQUIRE(manifest_writer->WriteEdgesNum(0, 1).ok());
+    manifest_info =
+        fs->GetFileInfo(manifest_prefix + manifest_path).ValueOrDie();
+    REQUIRE(manifest_info.type() == arrow::fs::FileType::NotFound);
+
     // Invalid cases
     // Invalid count or index
     REQUIRE(writer->WriteEdgesNum(-1, 0).IsIndexError());
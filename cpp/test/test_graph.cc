@@ -17,10 +17,15 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
+#include <vector>
 
 #include "./util.h"
 #include "graphar/api/high_level_reader.h"
+#include "graphar/api/high_level_writer.h"
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -192,6 +197,139 @@ TEST_CASE_METHOD(GlobalFixture, "Graph") {
     REQUIRE(expect4.status().IsInvalid());
   }
 
+  SECTION("RowView") {
+    auto vertices = VerticesCollection::Make(graph_info, "person").value();
+    size_t count = 0;
+    for (auto it = vertices->begin(); it != vertices->end(); ++it) {
+      auto view = it.view();
+      auto vertex = *it;
+      REQUIRE(view.id() == vertex.id());
+      REQUIRE(view.property<int64_t>("id").value() ==
+              vertex.property<int64_t>("id").value());
+      REQUIRE(view.property<std::string_view>("firstName").value() ==
+              vertex.property<std::string>("firstName").value());
+      REQUIRE(view.property<std::string>("firstName").value() ==
+              it.property<std::string>("firstName").value());
+      REQUIRE(view.property<int32_t>("id").status().IsTypeError());
+      REQUIRE(view.property<int64_t>("not_exist").status().IsKeyError());
+      REQUIRE(view.IsValid("id"));
+      REQUIRE_THROWS_AS(view.IsValid("not_exist"), std::invalid_argument);
+      count++;
+    }
+    REQUIRE(count == vertices->size());
+
+    auto edges =
+        EdgesCollection::Make(graph_info, "person", "knows", "person",
+                              AdjListType::ordered_by_source, 0, 1)
+            .value();
+    for (auto it = edges->begin(); it != edges->end(); ++it) {
+      auto view = it.view();
+      REQUIRE(view.source() == it.source());
+      REQUIRE(view.destination() == it.destination());
+      REQUIRE(view.property<std::string_view>("creationDate").value() ==
+              (*it).property<std::string>("creationDate").value());
+      REQUIRE(view.property<int64_t>("creationDate").has_error());
+    }
+  }
+
+  SECTION("PropertyHandle") {
+    auto vertices = VerticesCollection::Make(graph_info, "person").value();
+    auto id = vertices->propertyHandle<int64_t>("id").value();
+    auto first_name =
+        vertices->propertyHandle<std::string_view>("firstName").value();
+    REQUIRE(vertices->propertyHandle<int64_t>("not_exist")
+                .status()
+                .IsKeyError());
+    REQUIRE(vertices->propertyHandle<int32_t>("id").status().IsTypeError());
+    REQUIRE(vertices->propertyHandle<Int64Array>("id")
+                .status()
+                .IsTypeError());
+    for (auto it = vertices->begin(); it != vertices->end(); ++it) {
+      REQUIRE(!it.isNull(id));
+      REQUIRE(it.get(id) == it.property<int64_t>("id").value());
+      REQUIRE(it.get(first_name) ==
+              it.property<std::string>("firstName").value());
+    }
+    // a random access loads the chunk of the vertex
+    auto it_last = vertices->begin() + (vertices->size() - 1);
+    REQUIRE(it_last.get(id) == it_last.property<int64_t>("id").value());
+
+    auto edges =
+        EdgesCollection::Make(graph_info, "person", "knows", "person",
+                              AdjListType::ordered_by_source)
+            .value();
+    auto creation_date =
+        edges->propertyHandle<std::string_view>("creationDate").value();
+    REQUIRE(edges->propertyHandle<double>("creationDate").has_error());
+    size_t count = 0;
+    for (auto it = edges->begin(); it != edges->end(); ++it) {
+      REQUIRE(it.get(creation_date) ==
+              it.property<std::string>("creationDate").value());
+      count++;
+    }
+    REQUIRE(count == edges->size());
+  }
+
+  SECTION("ParallelForEachChunk") {
+    auto vertices = VerticesCollection::Make(graph_info, "person").value();
+    auto vertex_ranges = vertices->partition(3).value();
+    REQUIRE(!vertex_ranges.empty());
+    REQUIRE(vertex_ranges.size() <= 3);
+    IdType vertex_num = 0;
+    for (const auto& range : vertex_ranges) {
+      REQUIRE(range.offset == vertex_num);
+      vertex_num += range.size;
+    }
+    REQUIRE(static_cast<size_t>(vertex_num) == vertices->size());
+    std::atomic<IdType> vertex_count(0), id_sum(0);
+    REQUIRE(ParallelForEachChunk(
+                *vertices,
+                [&](VertexIter& it, IdType count, int) {
+                  for (IdType i = 0; i < count; ++i, ++it) {
+                    id_sum += it.id();
+                  }
+                  vertex_count += count;
+                  return Status::OK();
+                },
+                4)
+                .ok());
+    REQUIRE(vertex_count.load() == vertex_num);
+    REQUIRE(id_sum.load() == vertex_num * (vertex_num - 1) / 2);
+
+    auto edges =
+        EdgesCollection::Make(graph_info, "person", "knows", "person",
+                              AdjListType::ordered_by_source)
+            .value();
+    IdType expected_sum = 0;
+    for (auto it = edges->begin(); it != edges->end(); ++it) {
+      expected_sum += it.source() + it.destination();
+    }
+    std::atomic<IdType> edge_count(0), edge_sum(0);
+    std::atomic<bool> past_range(false);
+    REQUIRE(ParallelForEachChunk(
+                *edges,
+                [&](EdgeIter& it, IdType count, int) {
+                  for (IdType i = 0; i < count; ++i, ++it) {
+                    edge_sum += it.source() + it.destination();
+                  }
+                  // the iterator ends after the last edge of the range
+                  past_range = past_range || !it.is_end();
+                  edge_count += count;
+                  return Status::OK();
+                },
+                4)
+                .ok());
+    REQUIRE(static_cast<size_t>(edge_count.load()) == edges->size());
+    REQUIRE(edge_sum.load() == expected_sum);
+    REQUIRE(!past_range.load());
+
+    // an error of a range stops the iteration
+    auto st = ParallelForEachChunk(
+        *edges, [](EdgeIter&, IdType, int) { return Status::Invalid("stop"); },
+        2);
+    REQUIRE(st.IsInvalid());
+  }
+
   SECTION("ValidateProperty") {
     // read file and construct graph info
     std::string path = test_data_dir + "/neo4j/MovieGraph.graph.yml";
@@ -208,6 +346,7 @@ TEST_CASE_METHOD(GlobalFixture, "Graph") {
     for (auto it = vertices->begin(); it != vertices->end(); ++it) {
       // get a vertex and access its data
       auto vertex = *it;
+      REQUIRE(it.view().IsValid(property) == vertex.IsValid(property));
       // property not exists
       REQUIRE_THROWS_AS(vertex.IsValid("bornn"), std::invalid_argument);
       if (vertex.IsValid(property)) {
@@ -222,4 +361,117 @@ TEST_CASE_METHOD(GlobalFixture, "Graph") {
     REQUIRE(last_invalid_vertex.property<int64_t>(property).has_error());
   }
 }
+
+TEST_CASE_METHOD(GlobalFixture, "EdgeIterChunkBoundaries") {
+  // 3 vertex chunks of 4 vertices and edge chunks of 2 edges, the first and
+  // the last vertex chunk end with an exactly full edge chunk and the middle
+  // one has no edges
+  std::string prefix = "/tmp/edge_iter/";
+  auto vertex_info = CreateVertexInfo("node", 4, {}, {}, "vertex/node/");
+  auto edge_info = CreateEdgeInfo(
+      "node", "link", "node", 2, 4, 4, true,
+      {CreateAdjacentList(AdjListType::ordered_by_source, FileType::PARQUET)},
+      {}, "edge/node_link_node/");
+  auto graph_info =
+      CreateGraphInfo("edge_iter", {vertex_info}, {edge_info}, {}, prefix);
+  std::vector<std::pair<IdType, IdType>> expected = {
+      {0, 1}, {0, 2}, {1, 3}, {2, 0}, {8, 9}, {9, 10}, {10, 11}, {11, 8}};
+  auto builder = builder::EdgesBuilder::Make(
+                     edge_info, prefix, AdjListType::ordered_by_source, 12)
+                     .value();
+  for (const auto& edge : expected) {
+    builder::Edge e(edge.first, edge.second);
+    REQUIRE(builder->AddEdge(e).ok());
+  }
+  REQUIRE(builder->Dump().ok());
+
+  auto edges = EdgesCollection::Make(graph_info, "node", "link", "node",
+                                     AdjListType::ordered_by_source)
+                   .value();
+  REQUIRE(edges->size() == expected.size());
+  std::vector<std::pair<IdType, IdType>> scanned;
+  auto end = edges->end();
+  for (auto it = edges->begin(); it != end; ++it) {
+    scanned.emplace_back(it.source(), it.destination());
+    // an iterator never runs past the last edge
+    REQUIRE(scanned.size() <= expected.size());
+  }
+  REQUIRE(scanned == expected);
+
+  // the iterator continues from the last edge of the first vertex chunk to
+  // the first edge of the last one across the empty vertex chunk
+  auto it = edges->begin();
+  for (int i = 0; i < 3; ++i) {
+    ++it;
+  }
+  REQUIRE(it.source() == 2);
+  ++it;
+  REQUIRE(it.source() == 8);
+  REQUIRE(it.destination() == 9);
+
+  // a collection of the empty vertex chunk only has no edges
+  auto empty = EdgesCollection::Make(graph_info, "node", "link", "node",
+                                     AdjListType::ordered_by_source, 1, 2)
+                   .value();
+  REQUIRE(empty->size() == 0);
+  REQUIRE(empty->begin() == empty->end());
+}
+
+TEST_CASE_METHOD(GlobalFixture, "VertexSet") {
+  // a sparse block kept as an array and a dense block kept as a bitmap
+  std::vector<IdType> ids;
+  for (IdType i = 0; i < 1000; ++i) {
+    ids.push_back(i * 7);
+  }
+  for (IdType i = 1 << 16; i < (1 << 16) + 10000; ++i) {
+    ids.push_back(i);
+  }
+  std::vector<IdType> shuffled(ids.rbegin(), ids.rend());
+  auto set = VertexSet::FromIds(shuffled);
+  REQUIRE(set.Size() == static_cast<IdType>(ids.size()));
+  REQUIRE(set.ToVector() == ids);
+  REQUIRE(set.Contains(7 * 999));
+  REQUIRE(!set.Contains(1));
+  REQUIRE(set.Select(1000) == (1 << 16));
+  REQUIRE(set.Select(static_cast<IdType>(ids.size())) == -1);
+  REQUIRE(set.Next(7 * 999) == (1 << 16));
+  REQUIRE(set.Next((1 << 16) + 10000) == -1);
+  REQUIRE(set.GetMemoryUsage() < static_cast<int64_t>(ids.size()) * 2 + 8192);
+
+  std::vector<uint64_t> bitmap(((1 << 16) + 10000 + 63) / 64, 0);
+  for (IdType id : ids) {
+    bitmap[id / 64] |= uint64_t(1) << (id % 64);
+  }
+  REQUIRE(VertexSet::FromBitmap(bitmap.data(), (1 << 16) + 10000) == set);
+
+  auto range = VertexSet::FromRange(60000, 70000);
+  std::vector<IdType> intersection, union_ids, difference;
+  auto range_ids = range.ToVector();
+  std::set_intersection(ids.begin(), ids.end(), range_ids.begin(),
+                        range_ids.end(), std::back_inserter(intersection));
+  std::set_union(ids.begin(), ids.end(), range_ids.begin(), range_ids.end(),
+                 std::back_inserter(union_ids));
+  std::set_difference(ids.begin(), ids.end(), range_ids.begin(),
+                      range_ids.end(), std::back_inserter(difference));
+  REQUIRE(VertexSet::Intersect(set, range).ToVector() == intersection);
+  REQUIRE(VertexSet::Union(set, range).ToVector() == union_ids);
+  REQUIRE(VertexSet::Difference(set, range).ToVector() == difference);
+
+  // adding the ids one by one in descending order keeps the ranks
+  VertexSet added;
+  for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+    added.Add(*it);
+  }
+  REQUIRE(added == set);
+  for (size_t i = 0; i < ids.size(); i += 97) {
+    REQUIRE(added.Select(static_cast<IdType>(i)) == ids[i]);
+    REQUIRE(added.Rank(ids[i]) == static_cast<IdType>(i));
+  }
+
+  set.Add(1);
+  set.Add(1);
+  REQUIRE(set.Contains(1));
+  REQUIRE(set.Select(1) == 1);
+  REQUIRE(set.Size() == static_cast<IdType>(ids.size()) + 1);
+}
 }  // namespace graphar
@@ -17,6 +17,7 @@
  * under the License.
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <unordered_map>
@@ -24,7 +25,11 @@
 #include "arrow/csv/api.h"
 #include "arrow/filesystem/api.h"
 #include "arrow/io/api.h"
+#include "graphar/filesystem.h"
 #include "graphar/fwd.h"
+#include "graphar/general_params.h"
+#include "graphar/label.h"
+#include "graphar/label_summary.h"
 #include "parquet/arrow/writer.h"
 
 #include "./util.h"
@@ -94,4 +99,252 @@ TEST_CASE_METHOD(GlobalFixture, "test_multi_label_builder") {
   assert(reader->GetLabelChunk().status().ok());
   assert(reader->next_chunk().ok());
 }
+
+TEST_CASE_METHOD(GlobalFixture, "test_label_filter_kernel") {
+  // 3 chunks of 100 rows and a last chunk of 30 rows, the chunks are not
+  // aligned to the 64-bit words of the bitmap
+  const IdType chunk_size = 100;
+  const IdType vertex_num = 330;
+  auto is_a = [](IdType i) { return i % 3 == 0; };
+  auto is_b = [](IdType i) { return i % 5 == 0; };
+  // label d is true in the first row group of 64 rows of each chunk and false
+  // in the others, which is known from the statistics without reading them
+  auto is_d = [&](IdType i) { return i % chunk_size < 64; };
+  std::string prefix = "/tmp/label_filter_kernel/chunk";
+  auto fs = arrow::fs::FileSystemFromUriOrPath(prefix).ValueOrDie();
+  REQUIRE(fs->CreateDir("/tmp/label_filter_kernel").ok());
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  for (IdType chunk = 0; chunk * chunk_size < vertex_num; ++chunk) {
+    arrow::BooleanBuilder a, b, d;
+    for (IdType i = chunk * chunk_size;
+         i < std::min(vertex_num, (chunk + 1) * chunk_size); ++i) {
+      REQUIRE(a.Append(is_a(i)).ok());
+      // a null label is not set
+      REQUIRE((is_b(i) ? b.Append(true) : b.AppendNull()).ok());
+      REQUIRE(d.Append(is_d(i)).ok());
+    }
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("a", arrow::boolean()),
+                       arrow::field("b", arrow::boolean()),
+                       arrow::field("d", arrow::boolean())}),
+        {a.Finish().ValueOrDie(), b.Finish().ValueOrDie(),
+         d.Finish().ValueOrDie()});
+    auto output =
+        fs->OpenOutputStream(prefix + std::to_string(chunk)).ValueOrDie();
+    REQUIRE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(),
+                                       output, 64)
+                .ok());
+    REQUIRE(output->Close().ok());
+    tables.push_back(table);
+  }
+  std::vector<IdType> chunks = {0, 1, 2, 3};
+  std::string label_prefix;
+  auto label_fs = FileSystemFromUriOrPath(prefix, &label_prefix).value();
+
+  auto check = [&](LabelCombine combine, auto&& expected) {
+    auto indices = FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET,
+                                     vertex_num, chunk_size, chunks, {0, 1},
+                                     combine, QUERY_TYPE::INDEX)
+                       .value();
+    auto bitmap = FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET,
+                                    vertex_num, chunk_size, chunks, {0, 1},
+                                    combine, QUERY_TYPE::BITMAP)
+                      .value();
+    REQUIRE(indices.type == QUERY_TYPE::INDEX);
+    REQUIRE(bitmap.type == QUERY_TYPE::BITMAP);
+    std::vector<IdType> expected_indices;
+    for (IdType i = 0; i < vertex_num; ++i) {
+      bool valid = expected(i);
+      if (valid) {
+        expected_indices.push_back(i);
+      }
+      REQUIRE(((bitmap.bitmap[i / 64] >> (i % 64)) & 1) == valid);
+    }
+    REQUIRE(indices.indices == expected_indices);
+    REQUIRE(indices.count == static_cast<int64_t>(expected_indices.size()));
+    REQUIRE(bitmap.count == indices.count);
+    REQUIRE(indices.valid_chunks == chunks);
+  };
+  check(LabelCombine::AND, [&](IdType i) { return is_a(i) && is_b(i); });
+  check(LabelCombine::OR, [&](IdType i) { return is_a(i) || is_b(i); });
+  check(LabelCombine::NOT, [&](IdType i) { return !is_a(i) && !is_b(i); });
+
+  // the unfiltered chunks have no valid vertex, the sparse result of the
+  // adaptive query is returned as indices and the dense one as bitmap
+  auto sparse =
+      FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET, vertex_num,
+                        chunk_size, {3}, {0, 1}, LabelCombine::AND)
+          .value();
+  REQUIRE(sparse.type == QUERY_TYPE::INDEX);
+  REQUIRE(sparse.indices == std::vector<IdType>{300, 315});
+  auto dense =
+      FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET, vertex_num,
+                        chunk_size, chunks, {0}, LabelCombine::OR)
+          .value();
+  REQUIRE(dense.type == QUERY_TYPE::BITMAP);
+  REQUIRE(dense.count == 110);
+
+  SECTION("LabelPredicate") {
+    // (a AND NOT b) OR c, the vertex type has no label c
+    auto predicate = LabelPredicate::Or(
+        LabelPredicate::And(LabelPredicate::Label("a"),
+                            LabelPredicate::Not(LabelPredicate::Label("b"))),
+        LabelPredicate::Label("c"));
+    REQUIRE(predicate->ToString() == "((a AND NOT b) OR c)");
+    auto compiled =
+        CompiledLabelPredicate::Compile(predicate, {"a", "b"}).value();
+    REQUIRE(compiled.GetLabelColumns() == std::vector<int>{0, 1});
+    auto result =
+        FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET,
+                          vertex_num, chunk_size, chunks, compiled,
+                          QUERY_TYPE::INDEX)
+            .value();
+    std::vector<IdType> expected;
+    for (IdType i = 0; i < vertex_num; ++i) {
+      if (is_a(i) && !is_b(i)) {
+        expected.push_back(i);
+      }
+    }
+    REQUIRE(result.indices == expected);
+
+    // a predicate on the absent labels only reads no label column
+    auto absent = CompiledLabelPredicate::Compile(
+                      LabelPredicate::Not(LabelPredicate::Label("c")),
+                      {"a", "b"})
+                      .value();
+    REQUIRE(absent.GetLabelColumns().empty());
+    REQUIRE(FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET,
+                              vertex_num, chunk_size, chunks, absent,
+                              QUERY_TYPE::COUNT)
+                .value()
+                .count == vertex_num);
+
+    // the operand of a NOT is validated before the AND NOT is fused
+    REQUIRE(CompiledLabelPredicate::Compile(
+                LabelPredicate::And(LabelPredicate::Label("a"),
+                                    LabelPredicate::Not(nullptr)),
+                {"a", "b"})
+                .has_error());
+  }
+
+  SECTION("RowGroupStatistics") {
+    // the row groups of d are skipped or set by the statistics, the row
+    // groups of a are read
+    auto result =
+        FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET,
+                          vertex_num, chunk_size, chunks, {0, 2},
+                          LabelCombine::OR, QUERY_TYPE::BITMAP)
+            .value();
+    IdType count = 0;
+    for (IdType i = 0; i < vertex_num; ++i) {
+      bool valid = is_a(i) || is_d(i);
+      count += valid;
+      REQUIRE(((result.bitmap[i / 64] >> (i % 64)) & 1) == valid);
+    }
+    REQUIRE(result.count == count);
+  }
+
+  SECTION("IpcLabelChunks") {
+    std::string ipc_prefix = "/tmp/label_filter_kernel/ipc/chunk";
+    for (size_t chunk = 0; chunk < tables.size(); ++chunk) {
+      REQUIRE(label_fs
+                  ->WriteTableToFile(tables[chunk], FileType::IPC,
+                                     ipc_prefix + std::to_string(chunk),
+                                     WriterOptions::DefaultWriterOption())
+                  .ok());
+    }
+    auto parquet_result =
+        FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET,
+                          vertex_num, chunk_size, chunks, {0, 1, 2},
+                          LabelCombine::AND, QUERY_TYPE::INDEX)
+            .value();
+    auto ipc_result =
+        FilterLabelChunks(label_fs, ipc_prefix, FileType::IPC, vertex_num,
+                          chunk_size, chunks, {0, 1, 2}, LabelCombine::AND,
+                          QUERY_TYPE::INDEX)
+            .value();
+    REQUIRE(ipc_result.indices == parquet_result.indices);
+  }
+
+  SECTION("LabelSummary") {
+    // 300..329 has 10 of a, 6 of b and 30 of d
+    REQUIRE(LabelSummary::CountLabels(tables[3]).value() ==
+            std::vector<IdType>{10, 6, 30});
+
+    // chunk 1 is taken to have no a and chunk 2 to be all a, neither is read,
+    // the chunks 0 and 3 have no summary and are read
+    auto summary = std::make_shared<const LabelSummary>(
+        std::vector<std::string>{"a", "b", "d"},
+        std::vector<IdType>{-1, 100, 100, -1},
+        std::vector<std::vector<IdType>>{{}, {0, 20, 64}, {100, 20, 64}, {}});
+    REQUIRE(!summary->HasChunk(0));
+    REQUIRE(summary->GetLabelCount(2, "a").value() == 100);
+    auto compiled = CompiledLabelPredicate::Compile(LabelPredicate::Label("a"),
+                                                    {"a", "b", "d"})
+                        .value();
+    REQUIRE(summary->Match(1, 100, compiled) == LabelMatch::NONE);
+    REQUIRE(summary->Match(2, 100, compiled) == LabelMatch::ALL);
+    REQUIRE(summary->Match(3, 30, compiled) == LabelMatch::SOME);
+    auto result =
+        FilterLabelChunks(label_fs, label_prefix, FileType::PARQUET,
+                          vertex_num, chunk_size, chunks, compiled,
+                          QUERY_TYPE::INDEX, summary)
+            .value();
+    std::vector<IdType> expected;
+    for (IdType i = 0; i < vertex_num; ++i) {
+      if ((i >= 200 && i < 300) || (is_a(i) && (i < 100 || i >= 300))) {
+        expected.push_back(i);
+      }
+    }
+    REQUIRE(result.indices == expected);
+    REQUIRE(result.valid_chunks == std::vector<IdType>{0, 2, 3});
+  }
+
+  SECTION("WrittenLabelSummary") {
+    std::string summary_prefix = "/tmp/label_summary/";
+    auto vertex_info = CreateVertexInfo("node", chunk_size, {},
+                                        {"a", "b", "d"}, "vertex/node/");
+    auto writer =
+        VertexPropertyWriter::Make(vertex_info, summary_prefix).value();
+    auto label_table = arrow::ConcatenateTables(tables).ValueOrDie();
+    REQUIRE(writer->WriteLabelTable(label_table, 0, FileType::PARQUET).ok());
+    // one summary of all the chunks
+    std::string base_dir;
+    auto summary_fs =
+        FileSystemFromUriOrPath(summary_prefix, &base_dir).value();
+    auto summary =
+        LabelSummary::Get(summary_fs, base_dir, vertex_info, vertex_num)
+            .value();
+    for (IdType chunk : chunks) {
+      REQUIRE(summary->HasChunk(chunk));
+    }
+    REQUIRE(summary->GetLabelCount(3, "a").value() == 10);
+    // the registered summary is reused while its generation is unchanged
+    auto generation = summary->GetGeneration();
+    REQUIRE(generation > 0);
+    REQUIRE(LabelSummary::Get(summary_fs, base_dir, vertex_info, vertex_num)
+                .value() == summary);
+
+    // the row of a label chunk rewritten alone is removed from its summary
+    REQUIRE(writer->WriteLabelChunk(tables[2], 1, FileType::PARQUET).ok());
+    summary = LabelSummary::Get(summary_fs, base_dir, vertex_info, vertex_num)
+                  .value();
+    REQUIRE(summary->GetGeneration() > generation);
+    REQUIRE(!summary->HasChunk(1));
+    REQUIRE(summary->HasChunk(0));
+    // the summary on the file system lacks the row too
+    LabelSummary::Clear();
+    REQUIRE(!LabelSummary::Load(summary_fs, base_dir, vertex_info, vertex_num)
+                 .value()
+                 ->HasChunk(1));
+
+    // the summary of the rewritten chunk is written again, the other rows of
+    // the summary are kept
+    REQUIRE(writer->WriteLabelTable(tables[2], 1, FileType::PARQUET).ok());
+    summary = LabelSummary::Get(summary_fs, base_dir, vertex_info, vertex_num)
+                  .value();
+    REQUIRE(summary->GetLabelCount(1, "a").value() == 33);
+    REQUIRE(summary->GetLabelCount(3, "a").value() == 10);
+  }
+}
 }  // namespace graphar